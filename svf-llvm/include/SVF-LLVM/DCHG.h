@@ -262,6 +262,8 @@ public:
 
     virtual const VTableSet &getCSVtblsBasedonCHA(const CallICFGNode* cs) override;
     virtual void getVFnsFromVtbls(const CallICFGNode* cs, const VTableSet &vtbls, VFunSet &virtualFunctions) override;
+    /// Virtual functions at index idx of the vtable vtbl (memoised).
+    const VFnTargets &getVFnTargets(const GlobalObjVar *vtbl, u32_t idx);
 
     /// Returns true if a is a transitive base of b. firstField determines
     /// whether to consider first-field edges.
@@ -358,6 +360,8 @@ protected:
     Map<const DIType*, VTableSet> vtblCHAMap;
     /// Maps callsites to a set of potential virtual functions based on CHA.
     Map<const CallICFGNode*, VFunSet> csCHAMap;
+    /// Maps (vtable, index) pairs to the virtual functions with their demangled names.
+    VTableIdxToVFnsMap vtblIdxToVFnsMap;
     /// Maps types to their canonical type (many-to-one).
     Map<const DIType*, const DIType*> canonicalTypeMap;
     /// Set of all possible canonical types (i.e. values of canonicalTypeMap).
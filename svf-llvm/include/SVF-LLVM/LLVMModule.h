@@ -4,6 +4,7 @@
 
 #include "SVF-LLVM/BasicTypes.h"
 #include "Util/Options.h"
+#include "Util/ExtAPI.h"
 #include "Graphs/BasicBlockG.h"
 
 namespace SVF
@@ -50,6 +51,7 @@ public:
 private:
     static LLVMModuleSet* llvmModuleSet;
     static bool preProcessed;
+    static bool llvmIRRequired;
     SVFIR* svfir;
     std::unique_ptr<LLVMContext> owned_ctx;
     std::vector<std::unique_ptr<Module>> owned_modules;
@@ -62,6 +64,8 @@ private:
 
     // Map SVFFunction to its annotations
     Map<const Function*, std::vector<std::string>> func2Annotations;
+    // Map a function to its compiled annotations
+    Map<const Function*, ExtAPI::ExtFuncInfo> func2ExtInfo;
 
     /// Global definition to a rep definition map
     GlobalDefToRepMapTy GlobalDefToRepMap;
@@ -90,6 +94,10 @@ private:
     FunToExitBBMap funToExitBB;
     FunToRealDefFunMap funToRealDefFun;
 
+    std::vector<u64_t> moduleHashes; ///< hash of the LLVM IR of each loaded module
+    std::string svfirCachePath; ///< file to cache the SVFIR built from the modules in
+    bool llvmIRReleased; ///< the LLVM IR was released or (on an SVFIR cache hit) never mapped
+
     /// Constructor
     LLVMModuleSet();
 
@@ -111,6 +119,15 @@ public:
         llvmModuleSet = nullptr;
     }
 
+    /// A client which maps the SVFIR back to the LLVM IR after the build (e.g.
+    /// with SVFIRBuilder::updateCallGraph) calls this before buildSVFModule, so
+    /// that the SVFIR is always built from the IR instead of read from the
+    /// SVFIR cache (-svfir-cache-dir), which has no such mapping
+    static inline void requireLLVMIR()
+    {
+        llvmIRRequired = true;
+    }
+
     // Build an SVF module from a given LLVM Module instance (for use e.g. in a LLVM pass)
     static void buildSVFModule(Module& mod);
 
@@ -119,6 +136,18 @@ public:
 
     static void preProcessBCs(std::vector<std::string>& moduleNameVec);
 
+    /// Write the SVFIR built from the modules to the cache (-svfir-cache-dir), if
+    /// it was not read from there
+    void writeSVFIRToCache(const SVFIR* pag) const;
+
+    /// Release the LLVM IR (modules, context, dominator trees and type inference)
+    /// and every map keyed by LLVM values (-release-llvm-ir). The SVFIR does not
+    /// refer to the LLVM IR, so the analyses can run on it afterwards, but nothing
+    /// may map between the two any more (e.g. SVFIRBuilder::updateCallGraph), and
+    /// such lookups abort with an error. Clients which called requireLLVMIR keep
+    /// the IR.
+    void releaseLLVMIR();
+
     u32_t getModuleNum() const
     {
         return modules.size();
@@ -136,6 +165,7 @@ public:
 
     Module &getModuleRef(u32_t idx) const
     {
+        checkLLVMIRMapped();
         assert(idx < getModuleNum() && "Out of range.");
         return modules[idx];
     }
@@ -224,6 +254,7 @@ public:
 
     const Value* getLLVMValue(const SVFValue* value) const
     {
+        checkLLVMIRMapped();
         SVFBaseNode2LLVMValueMap ::const_iterator it = SVFBaseNode2LLVMValue.find(value);
         assert(it != SVFBaseNode2LLVMValue.end() && "can't find corresponding llvm value!");
         return it->second;
@@ -231,6 +262,7 @@ public:
 
     inline const FunObjVar* getFunObjVar(const Function* fun) const
     {
+        checkLLVMIRMapped();
         LLVMFun2FunObjVarMap::const_iterator it = LLVMFun2FunObjVar.find(fun);
         assert(it!=LLVMFun2FunObjVar.end() && "SVF Function not found!");
         return it->second;
@@ -248,6 +280,7 @@ public:
 
     NodeID getReturnNode(const Function *func) const
     {
+        checkLLVMIRMapped();
         FunToIDMapTy::const_iterator iter =  returnSymMap.find(func);
         assert(iter!=returnSymMap.end() && "ret sym not found");
         return iter->second;
@@ -255,6 +288,7 @@ public:
 
     NodeID getVarargNode(const Function *func) const
     {
+        checkLLVMIRMapped();
         FunToIDMapTy::const_iterator iter =  varargSymMap.find(func);
         assert(iter!=varargSymMap.end() && "vararg sym not found");
         return iter->second;
@@ -262,6 +296,7 @@ public:
 
     SVFBasicBlock* getSVFBasicBlock(const BasicBlock* bb)
     {
+        checkLLVMIRMapped();
         LLVMBB2SVFBBMap::const_iterator it = LLVMBB2SVFBB.find(bb);
         assert(it!=LLVMBB2SVFBB.end() && "SVF BasicBlock not found!");
         return it->second;
@@ -301,6 +336,7 @@ public:
     /// Add a function entry node
     inline FunEntryICFGNode* getFunEntryICFGNode(const Function*  fun)
     {
+        checkLLVMIRMapped();
         FunEntryICFGNode* b = getFunEntryBlock(fun);
         assert(b && "Function entry not created?");
         return b;
@@ -308,6 +344,7 @@ public:
     /// Add a function exit node
     inline FunExitICFGNode* getFunExitICFGNode(const Function*  fun)
     {
+        checkLLVMIRMapped();
         FunExitICFGNode* b = getFunExitBlock(fun);
         assert(b && "Function exit not created?");
         return b;
@@ -362,6 +399,8 @@ public:
     ObjTypeInference* getTypeInference();
 
     DominatorTree& getDomTree(const Function* fun);
+    /// Compute the dominator trees of funs up front, on numThreads threads
+    void buildDomTrees(const std::vector<const Function*>& funs, u32_t numThreads);
 
     std::string getExtFuncAnnotation(const Function* fun, const std::string& funcAnnotation);
 
@@ -401,6 +440,9 @@ public:
     // Set the annotation of (F)
     void setExtFuncAnnotations(const Function* fun, const std::vector<std::string>& funcAnnotations);
 
+    // Get the compiled annotations of (F) (no flags if it has no annotations)
+    const ExtAPI::ExtFuncInfo& getExtFuncInfo(const Function* fun) const;
+
 private:
     inline void addFunctionSet(const Function* svfFunc)
     {
@@ -430,6 +472,24 @@ private:
     std::vector<const Function*> getLLVMGlobalFunctions(const GlobalVariable* global);
 
     void loadModules(const std::vector<std::string>& moduleNameVec);
+    /// Read the files of the modules (and hash them for the SVFIR cache)
+    void readModuleFiles(const std::vector<std::string>& moduleNameVec,
+                         std::vector<std::unique_ptr<llvm::MemoryBuffer>>& buffers);
+    /// Parse the modules read by readModuleFiles into one context, in order
+    void parseModules(const std::vector<std::string>& moduleNameVec,
+                      std::vector<std::unique_ptr<llvm::MemoryBuffer>>& buffers);
+    /// Abort with an error if the LLVM IR is no longer mapped to the SVFIR
+    inline void checkLLVMIRMapped() const
+    {
+        if (llvmIRReleased)
+            reportLLVMIRReleased();
+    }
+    [[noreturn]] static void reportLLVMIRReleased();
+
+    /// Whether the SVFIR is looked up in and written to the SVFIR cache
+    static bool useSVFIRCache();
+    /// Read the SVFIR of the read modules from the cache; return false on a miss
+    bool readSVFIRFromCache();
     // Loads ExtAPI bitcode file; uses LLVMContext made while loading module bitcode files or from Module
     void loadExtAPIModules();
     void addSVFMain();
@@ -17,7 +17,6 @@ public:
     typedef ValueToValueSet ValueToInferSites;
     typedef ValueToValueSet ValueToSources;
     typedef Map<const Value *, const Type *> ValueToType;
-    typedef std::pair<const Value *, bool> ValueBoolPair;
     typedef Map<const Value *, Set<std::string>> ValueToClassNames;
     typedef Map<const Value *, Set<const CallBase *>> ObjToClsNameSources;
 
@@ -41,6 +40,10 @@ public:
     /// get or infer the type of the object pointed by the value
     const Type *inferObjType(const Value *var);
 
+    /// walk the def-use chains for the objects pointed by vars with numThreads
+    /// threads, so that inferObjType answers queries for them from the caches
+    void inferObjTypes(const std::vector<const Value *> &vars, u32_t numThreads);
+
     const Type *inferPointsToType(const Value *var);
 
     /// validate type inference
@@ -73,6 +76,24 @@ private:
     /// backward collect all possible allocation sites (stack, static, heap) of var
     Set<const Value *>& bwfindAllocOfVar(const Value *var);
 
+    /// infer sites of the object pointed by var, cached in valueToInferSites
+    ValueSet &fwFindInferSites(ValueToInferSites &valueToInferSites, const Value *var);
+
+    /// allocation sites of var, cached in valueToAllocs
+    ValueSet &bwFindAllocs(ValueToSources &valueToAllocs, const Value *var);
+
+    /// one step of the walks: what is found at curValue, and the values to continue with
+    //@{
+    void fwInferSites(const Value *curValue, ValueSet &infersites, std::vector<const Value *> &next);
+    void bwAllocs(const Value *curValue, ValueSet &sources, std::vector<const Value *> &next);
+    void bwAllocsOrClsNameSources(const Value *curValue, ValueSet &sources, std::vector<const Value *> &next);
+    //@}
+
+    /// the union of what collect finds at all values reachable from start
+    /// (following collect), cached in cache for every value reached
+    template<class Collect>
+    ValueSet &collectOverSCCs(ValueToValueSet &cache, const Value *start, Collect collect);
+
     /// is allocation (stack, static, heap)
     bool isAlloc(const SVF::Value *val);
 
@@ -53,6 +53,7 @@ public:
     void initSVFBasicBlock(const Function* func);
 
     void initDomTree(FunObjVar* func, const Function* f);
+    void initDomTrees(const std::vector<std::pair<FunObjVar*, const Function*>>& funs);
 
     void addEdge(NodeID src, NodeID dst, SVFStmt::PEDGEK kind,
                  APOffset offset = 0, Instruction* cs = nullptr);
@@ -35,6 +35,32 @@ public:
 
 protected:
 
+    /// A step of collectSym, or a type check, recorded by discoverFunSyms
+    struct FunSym
+    {
+        enum Kind
+        {
+            Val,        ///< collectVal(val)
+            Obj,        ///< collectObj(val)
+            SVFType,    ///< getOrAddSVFTypeInfo(type)
+            TypeCheck   ///< validateTypeCheck(val), a call site
+        };
+        Kind kind;
+        const Value* val;
+        const Type* type;
+    };
+
+    /// The steps which create the symbols of a function, in the order they
+    /// used to be taken, and the start values of its heap objects
+    struct FunSyms
+    {
+        std::vector<FunSym> syms;
+        std::vector<const Value*> heapStarts;
+    };
+
+    /// Find the symbols of a function without changing the symbol table
+    void discoverFunSyms(const Function& fun, FunSyms& funSyms);
+
     /// collect the syms
     //@{
     void collectSVFTypeInfo(const Value* val);
@@ -72,6 +98,9 @@ protected:
     const Type *inferTypeOfHeapObjOrStaticObj(const Instruction* inst);
     //@}
 
+    /// Infer the types of the heap objects starting at startValues up front, in parallel
+    void inferTypesOfHeapObjs(const std::vector<const Value*>& startValues, u32_t numThreads);
+
 
     /// Create an objectInfo based on LLVM value
     ObjTypeInfo* createObjTypeInfo(const Value* val);
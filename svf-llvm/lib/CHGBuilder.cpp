@@ -628,6 +628,9 @@ void CHGBuilder::buildVirtualFunctionToIDMap()
 
 void CHGBuilder::buildCSToCHAVtblsAndVfnsMap()
 {
+    std::vector<std::pair<const CallICFGNode*, const VTableSet*>> csVtbls;
+    Set<CHGraph::VTableIdxPair> vtblIdxSet;
+    std::vector<CHGraph::VTableIdxPair> vtblIdxPairs;
 
     for (Module &M : llvmModuleSet()->getLLVMModules())
     {
@@ -653,18 +656,34 @@ void CHGBuilder::buildCSToCHAVtblsAndVfnsMap()
                     }
                     if (vtbls.size() > 0)
                     {
-                        ICFGNode* icfgNode =
-                            llvmModuleSet()->getICFGNode(callInst);
-                        chg->callNodeToCHAVtblsMap[icfgNode] = vtbls;
-                        VFunSet virtualFunctions;
-                        chg->getVFnsFromVtbls(SVFUtil::cast<CallICFGNode>(icfgNode), vtbls, virtualFunctions);
-                        if (virtualFunctions.size() > 0)
-                            chg->callNodeToCHAVFnsMap[icfgNode] = virtualFunctions;
+                        const CallICFGNode* cs = SVFUtil::cast<CallICFGNode>(
+                                                     llvmModuleSet()->getICFGNode(callInst));
+                        VTableSet& csVtblSet = chg->callNodeToCHAVtblsMap[cs];
+                        csVtblSet = vtbls;
+                        csVtbls.emplace_back(cs, &csVtblSet);
+                        for (const GlobalObjVar* vtbl : vtbls)
+                        {
+                            CHGraph::VTableIdxPair key(vtbl, cs->getFunIdxInVtable());
+                            if (vtblIdxSet.insert(key).second)
+                                vtblIdxPairs.push_back(key);
+                        }
                     }
                 }
             }
         }
     }
+
+    // Virtual functions of the vtables are computed once for all call sites
+    // (and later call graph updates), in parallel
+    chg->buildVFnTargets(vtblIdxPairs, Options::CHGThreads());
+
+    for (const auto& it : csVtbls)
+    {
+        VFunSet virtualFunctions;
+        chg->getVFnsFromVtbls(it.first, *it.second, virtualFunctions);
+        if (virtualFunctions.size() > 0)
+            chg->callNodeToCHAVFnsMap[it.first] = virtualFunctions;
+    }
 }
 
 
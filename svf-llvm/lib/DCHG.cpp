@@ -591,55 +591,77 @@ const VTableSet &DCHGraph::getCSVtblsBasedonCHA(const CallICFGNode* cs)
     return vtblCHAMap[type];
 }
 
+const CommonCHGraph::VFnTargets &DCHGraph::getVFnTargets(const GlobalObjVar *vtbl, u32_t idx)
+{
+    VTableIdxPair key(vtbl, idx);
+    VTableIdxToVFnsMap::const_iterator it = vtblIdxToVFnsMap.find(key);
+    if (it != vtblIdxToVFnsMap.end())
+    {
+        return it->second;
+    }
+
+    VFnTargets &targets = vtblIdxToVFnsMap[key];
+    assert(vtblToTypeMap.find(vtbl) != vtblToTypeMap.end() && "floating vtbl");
+    const DIType *type = vtblToTypeMap[vtbl];
+    assert(hasNode(type) && "trying to get vtbl for type not in graph");
+    const DCHNode *node = getNode(type);
+    for (const std::vector<const Function*> &vfnV : node->getVfnVectors())
+    {
+        // We only care about any virtual function corresponding to idx.
+        if (idx >= vfnV.size())
+        {
+            continue;
+        }
+
+        const Function* callee = vfnV[idx];
+        cppUtil::DemangledName dname = cppUtil::demangle(callee->getName().str());
+        std::string calleeName = dname.funcName;
+
+        /*
+         * The compiler will add some special suffix (e.g.,
+         * "[abi:cxx11]") to the end of some virtual function:
+         * In dealII
+         * function: FE_Q<3>::get_name
+         * will be mangled as: _ZNK4FE_QILi3EE8get_nameB5cxx11Ev
+         * after demangling: FE_Q<3>::get_name[abi:cxx11]
+         * The special suffix ("[abi:cxx11]") needs to be removed
+         */
+        const std::string suffix("[abi:cxx11]");
+        size_t suffixPos = calleeName.rfind(suffix);
+        if (suffixPos != std::string::npos)
+        {
+            calleeName.erase(suffixPos, suffix.size());
+        }
+
+        if (const FunObjVar *fn = LLVMUtil::getFunObjVar(callee->getName().str()))
+        {
+            targets.push_back({fn, calleeName});
+        }
+    }
+
+    return targets;
+}
+
 void DCHGraph::getVFnsFromVtbls(const CallICFGNode* callsite, const VTableSet &vtbls, VFunSet &virtualFunctions)
 {
     size_t idx = callsite->getFunIdxInVtable();
-    std::string funName = callsite->getFunNameOfVirtualCall();
+    const std::string &funName = callsite->getFunNameOfVirtualCall();
     for (const GlobalObjVar *vtbl : vtbls)
     {
-        assert(vtblToTypeMap.find(vtbl) != vtblToTypeMap.end() && "floating vtbl");
-        const DIType *type = vtblToTypeMap[vtbl];
-        assert(hasNode(type) && "trying to get vtbl for type not in graph");
-        const DCHNode *node = getNode(type);
-        std::vector<std::vector<const Function* >> allVfns = node->getVfnVectors();
-        for (std::vector<const Function* > vfnV : allVfns)
-        {
-            // We only care about any virtual function corresponding to idx.
-            if (idx >= vfnV.size())
-            {
-                continue;
-            }
-
-            const Function* callee = vfnV[idx];
+        for (const VFnTarget &target : getVFnTargets(vtbl, idx))
+        {
+            const FunObjVar *callee = target.callee;
+            const std::string &calleeName = target.name;
             // Practically a copy of that in lib/MemoryModel/CHA.cpp
             if (callsite->arg_size() == callee->arg_size() || (callsite->isVarArg() && callee->isVarArg()))
             {
-                cppUtil::DemangledName dname = cppUtil::demangle(callee->getName().str());
-                std::string calleeName = dname.funcName;
-
-                /*
-                 * The compiler will add some special suffix (e.g.,
-                 * "[abi:cxx11]") to the end of some virtual function:
-                 * In dealII
-                 * function: FE_Q<3>::get_name
-                 * will be mangled as: _ZNK4FE_QILi3EE8get_nameB5cxx11Ev
-                 * after demangling: FE_Q<3>::get_name[abi:cxx11]
-                 * The special suffix ("[abi:cxx11]") needs to be removed
-                 */
-                const std::string suffix("[abi:cxx11]");
-                size_t suffixPos = calleeName.rfind(suffix);
-                if (suffixPos != std::string::npos)
-                {
-                    calleeName.erase(suffixPos, suffix.size());
-                }
-
                 /*
                  * if we can't get the function name of a virtual callsite, all virtual
                  * functions corresponding to idx will be valid
                  */
                 if (funName.size() == 0)
                 {
-                    virtualFunctions.insert(LLVMUtil::getFunObjVar(callee->getName().str()));
+                    virtualFunctions.insert(callee);
                 }
                 else if (funName[0] == '~')
                 {
@@ -655,7 +677,7 @@ void DCHGraph::getVFnsFromVtbls(const CallICFGNode* callsite, const VTableSet &v
                      */
                     if (calleeName[0] == '~')
                     {
-                        virtualFunctions.insert(LLVMUtil::getFunObjVar(callee->getName().str()));
+                        virtualFunctions.insert(callee);
                     }
                 }
                 else
@@ -666,7 +688,7 @@ void DCHGraph::getVFnsFromVtbls(const CallICFGNode* callsite, const VTableSet &v
                      */
                     if (funName.compare(calleeName) == 0)
                     {
-                        virtualFunctions.insert(LLVMUtil::getFunObjVar(callee->getName().str()));
+                        virtualFunctions.insert(callee);
                     }
                 }
             }
@@ -14,6 +14,12 @@
 #include "SVF-LLVM/ICFGBuilder.h"
 #include "Graphs/CallGraph.h"
 #include "Util/CallGraphBuilder.h"
+#include "Util/WorkStealing.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/xxhash.h"
+#include "llvm/ADT/StringExtras.h"
+#include "SVFIR/SVFFileSystem.h"
 
 using namespace std;
 using namespace SVF;
@@ -47,9 +53,10 @@ using namespace SVF;
 
 LLVMModuleSet* LLVMModuleSet::llvmModuleSet = nullptr;
 bool LLVMModuleSet::preProcessed = false;
+bool LLVMModuleSet::llvmIRRequired = false;
 
 LLVMModuleSet::LLVMModuleSet()
-    : svfir(PAG::getPAG()), typeInference(new ObjTypeInference())
+    : svfir(PAG::getPAG()), typeInference(new ObjTypeInference()), llvmIRReleased(false)
 {
 }
 
@@ -68,6 +75,7 @@ ObjTypeInference* LLVMModuleSet::getTypeInference()
 
 DominatorTree& LLVMModuleSet::getDomTree(const SVF::Function* fun)
 {
+    checkLLVMIRMapped();
     auto it = FunToDominatorTree.find(fun);
     if(it != FunToDominatorTree.end()) return it->second;
     DominatorTree& dt = FunToDominatorTree[fun];
@@ -75,6 +83,29 @@ DominatorTree& LLVMModuleSet::getDomTree(const SVF::Function* fun)
     return dt;
 }
 
+void LLVMModuleSet::buildDomTrees(const std::vector<const Function*>& funs, u32_t numThreads)
+{
+    // Create all entries first so that the map is not modified while the
+    // trees are computed, each by the thread owning its function.
+    std::vector<std::pair<const Function*, DominatorTree*>> todo;
+    for (const Function* fun : funs)
+    {
+        if (FunToDominatorTree.find(fun) != FunToDominatorTree.end())
+            continue;
+        todo.emplace_back(fun, &FunToDominatorTree[fun]);
+    }
+    if (todo.empty())
+        return;
+
+    WorkStealingPool<size_t> pool(std::max(1u, std::min<unsigned>(numThreads, todo.size())));
+    for (size_t i = 0; i < todo.size(); ++i)
+        pool.push(i);
+    pool.run([&todo](const size_t i, const unsigned)
+    {
+        todo[i].second->recalculate(const_cast<Function&>(*todo[i].first));
+    });
+}
+
 void LLVMModuleSet::buildSVFModule(Module &mod)
 {
     LLVMModuleSet* mset = getLLVMModuleSet();
@@ -96,7 +127,21 @@ void LLVMModuleSet::buildSVFModule(const std::vector<std::string> &moduleNameVec
 
     LLVMModuleSet* mset = getLLVMModuleSet();
 
-    mset->loadModules(moduleNameVec);   // Populates `modules`; can get context via `this->getContext()`
+    // Unchanged modules come with their SVFIR (and symbol table) in the cache,
+    // which is looked up by the contents of the files before any IR is parsed
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> buffers;
+    mset->readModuleFiles(moduleNameVec, buffers);
+    if (mset->readSVFIRFromCache())
+    {
+        mset->llvmIRReleased = true;
+        PAG::getPAG()->setModuleIdentifier(moduleNameVec.front());
+        double endSVFModuleTime = SVFStat::getClk(true);
+        SVFStat::timeOfBuildingLLVMModule =
+            (endSVFModuleTime - startSVFModuleTime) / TIMEINTERVAL;
+        return;
+    }
+    mset->parseModules(moduleNameVec, buffers);  // Populates `modules`; can get context via `this->getContext()`
+
     mset->loadExtAPIModules();          // Uses context from first module through `this->getContext()`
 
     if (!moduleNameVec.empty())
@@ -263,6 +308,14 @@ void LLVMModuleSet::preProcessBCs(std::vector<std::string> &moduleNameVec)
 }
 
 void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec)
+{
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> buffers;
+    readModuleFiles(moduleNameVec, buffers);
+    parseModules(moduleNameVec, buffers);
+}
+
+void LLVMModuleSet::readModuleFiles(const std::vector<std::string> &moduleNameVec,
+                                    std::vector<std::unique_ptr<llvm::MemoryBuffer>>& buffers)
 {
 
     // We read SVFIR from LLVM IR
@@ -280,7 +333,58 @@ void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec)
     {
         SVFIR::setPagFromTXT(Options::Graphtxt());
     }
-    //
+
+    for (const std::string& moduleName : moduleNameVec)
+    {
+        if (!LLVMUtil::isIRFile(moduleName))
+        {
+            SVFUtil::errs() << "not an IR file: " << moduleName << std::endl;
+            abort();
+        }
+    }
+
+    double startLoadTime = SVFStat::getClk(true);
+
+    buffers.resize(moduleNameVec.size());
+    std::vector<std::string> readErrors(moduleNameVec.size());
+    moduleHashes.assign(moduleNameVec.size(), 0);
+    const bool hashModules = useSVFIRCache();
+    auto readWorker = [this, &moduleNameVec, &buffers, &readErrors, hashModules](const size_t i, const unsigned)
+    {
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFileOrSTDIN(moduleNameVec[i]);
+        if (buffer)
+        {
+            buffers[i] = std::move(buffer.get());
+            if (hashModules)
+                moduleHashes[i] = llvm::xxHash64(buffers[i]->getBuffer());
+        }
+        else
+            readErrors[i] = buffer.getError().message();
+    };
+
+    const unsigned numThreads = std::max(1u, std::min<unsigned>(Options::ModuleLoadThreads(), moduleNameVec.size()));
+    WorkStealingPool<size_t> readPool(numThreads);
+    for (size_t i = 0; i < moduleNameVec.size(); ++i)
+        readPool.push(i);
+    readPool.run(readWorker);
+
+    for (size_t i = 0; i < moduleNameVec.size(); ++i)
+    {
+        if (buffers[i] == nullptr)
+        {
+            SVFUtil::errs() << "load module: " << moduleNameVec[i] << "failed!!\n\n";
+            SVFUtil::errs() << moduleNameVec[i] << ": " << readErrors[i] << "\n";
+            abort();
+        }
+    }
+
+    double endLoadTime = SVFStat::getClk(true);
+    SVFStat::timeOfLoadingModules = (endLoadTime - startLoadTime) / TIMEINTERVAL;
+}
+
+void LLVMModuleSet::parseModules(const std::vector<std::string> &moduleNameVec,
+                                 std::vector<std::unique_ptr<llvm::MemoryBuffer>>& buffers)
+{
     // LLVMContext objects separate global LLVM settings (from which e.g. types are
     // derived); multiple LLVMContext objects can coexist and each context can "own"
     // multiple modules (modules can only have one context). Mixing contexts can lead
@@ -306,26 +410,162 @@ void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec)
     // This garbage collection should be avoided when building an SVF module from an LLVM
     // module instance; see the comment(s) in `buildSVFModule` and `loadExtAPIModules()`
 
+    //
+    // As a module cannot be moved from one context to another, parsing happens
+    // in this one context, one module after the other and in the given order.
+    // Reading the files does not touch the context, so it is done up front by
+    // module-load-threads threads.
+
+    double startLoadTime = SVFStat::getClk(true);
+
     owned_ctx = std::make_unique<LLVMContext>();
-    for (const std::string& moduleName : moduleNameVec)
+    for (size_t i = 0; i < moduleNameVec.size(); ++i)
     {
-        if (!LLVMUtil::isIRFile(moduleName))
-        {
-            SVFUtil::errs() << "not an IR file: " << moduleName << std::endl;
-            abort();
-        }
-
+        const std::string& moduleName = moduleNameVec[i];
         SMDiagnostic Err;
-        std::unique_ptr<Module> mod = parseIRFile(moduleName, Err, *owned_ctx);
+        std::unique_ptr<Module> mod = parseIR(buffers[i]->getMemBufferRef(), Err, *owned_ctx);
         if (mod == nullptr)
         {
             SVFUtil::errs() << "load module: " << moduleName << "failed!!\n\n";
             Err.print("SVFModuleLoader", llvm::errs());
             abort();
         }
+        // As in parseIRFile, the parsed module no longer needs its buffer.
+        buffers[i].reset();
         modules.emplace_back(*mod);
         owned_modules.emplace_back(std::move(mod));
     }
+
+    double endLoadTime = SVFStat::getClk(true);
+    SVFStat::timeOfLoadingModules += (endLoadTime - startLoadTime) / TIMEINTERVAL;
+}
+
+/*!
+ * The SVFIR cache holds one file per set of input modules, named after a hash
+ * of the IR of all modules (in order), of the ExtAPI module and of the
+ * options which change the SVFIR built from them.
+ *
+ * A cached SVFIR is not mapped to the LLVM IR (no LLVM value has an SVF
+ * variable or ICFG node), so the cache is not used by clients which need
+ * that mapping after the build (see requireLLVMIR).
+ */
+bool LLVMModuleSet::useSVFIRCache()
+{
+    if (Options::SVFIRCacheDir().empty())
+        return false;
+    if (llvmIRRequired)
+    {
+        static bool warned = false;
+        if (!warned)
+            SVFUtil::writeWrnMsg("-svfir-cache-dir is ignored: this tool maps the SVFIR back to the LLVM IR");
+        warned = true;
+        return false;
+    }
+    return true;
+}
+
+bool LLVMModuleSet::readSVFIRFromCache()
+{
+    if (!useSVFIRCache() || moduleHashes.empty())
+        return false;
+
+    std::string key;
+    for (u64_t hash : moduleHashes)
+        key += std::to_string(hash) + ",";
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> extBuffer =
+        llvm::MemoryBuffer::getFile(ExtAPI::getExtAPI()->getExtBcPath());
+    key += std::to_string(extBuffer ? llvm::xxHash64(extBuffer.get()->getBuffer()) : 0) + ",";
+    key += std::to_string(Options::SVFMain()) + std::to_string(Options::ModelConsts()) +
+           std::to_string(Options::ModelArrays()) + std::to_string(Options::VtableInSVFIR()) +
+           std::to_string(Options::LoopAnalysis()) + "," + std::to_string(Options::LoopBound()) +
+           "," + std::to_string(Options::MaxFieldLimit());
+    std::string cachePath = Options::SVFIRCacheDir() + "/" + llvm::utohexstr(llvm::xxHash64(key)) + ".svfir";
+
+    if (llvm::sys::fs::exists(cachePath))
+    {
+        if (SVFIRReader::read(cachePath) != nullptr)
+        {
+            ++SVFStat::numOfSVFIRCacheHits;
+            return true;
+        }
+        // The reader released the SVFIR; an outdated file is replaced after the rebuild
+        svfir = PAG::getPAG();
+    }
+    ++SVFStat::numOfSVFIRCacheMisses;
+    svfirCachePath = cachePath;
+    return false;
+}
+
+void LLVMModuleSet::writeSVFIRToCache(const SVFIR* pag) const
+{
+    if (svfirCachePath.empty())
+        return;
+
+    // Write to a file of this process first, so that runs sharing the cache
+    // never read a partly written SVFIR.
+    std::string tmpPath = svfirCachePath + "." + std::to_string(llvm::sys::Process::getProcessId()) + ".tmp";
+    if (llvm::sys::fs::create_directories(Options::SVFIRCacheDir()) ||
+            !SVFIRWriter::writeToFile(pag, tmpPath) ||
+            llvm::sys::fs::rename(tmpPath, svfirCachePath))
+    {
+        llvm::sys::fs::remove(tmpPath);
+        SVFUtil::writeWrnMsg("failed to write the SVFIR to the cache: " + svfirCachePath);
+    }
+}
+
+/*!
+ * The SVFIR is built from all modules together (global and function definitions
+ * are resolved across modules, and the call graph and class hierarchy span all
+ * of them), so a module can only be released once the whole SVFIR is complete.
+ * Modules are destroyed before the context owning their types and constants,
+ * and a module given by the caller (buildSVFModule(Module&)) is only forgotten.
+ */
+void LLVMModuleSet::releaseLLVMIR()
+{
+    if (llvmIRRequired)
+    {
+        SVFUtil::writeWrnMsg("-release-llvm-ir is ignored: this tool maps the SVFIR back to the LLVM IR");
+        return;
+    }
+    llvmIRReleased = true;
+
+    delete typeInference;
+    typeInference = nullptr;
+    FunToDominatorTree = Map<const Function*, DominatorTree>();
+
+    ExtFuncsVec = FunctionSetType();
+    ExtFun2Annotations = Fun2AnnoMap();
+    func2Annotations = Map<const Function*, std::vector<std::string>>();
+    func2ExtInfo = Map<const Function*, ExtAPI::ExtFuncInfo>();
+    GlobalDefToRepMap = GlobalDefToRepMapTy();
+    LLVMFun2FunObjVar = LLVMFun2FunObjVarMap();
+    LLVMBB2SVFBB = LLVMBB2SVFBBMap();
+    LLVMType2SVFType = LLVMType2SVFTypeMap();
+    Type2TypeInfo = Type2TypeInfoMap();
+    SVFBaseNode2LLVMValue = SVFBaseNode2LLVMValueMap();
+    CSToCallNodeMap = CSToCallNodeMapTy();
+    CSToRetNodeMap = CSToRetNodeMapTy();
+    InstToBlockNodeMap = InstToBlockNodeMapTy();
+    FunToFunEntryNodeMap = FunToFunEntryNodeMapTy();
+    FunToFunExitNodeMap = FunToFunExitNodeMapTy();
+    valSymMap = ValueToIDMapTy();
+    objSymMap = ValueToIDMapTy();
+    returnSymMap = FunToIDMapTy();
+    varargSymMap = FunToIDMapTy();
+    funSet = FunctionSet();
+    funToExitBB = FunToExitBBMap();
+    funToRealDefFun = FunToRealDefFunMap();
+
+    modules.clear();
+    owned_modules.clear();
+    owned_ctx.reset();
+}
+
+void LLVMModuleSet::reportLLVMIRReleased()
+{
+    SVFUtil::errs() << SVFUtil::errMsg("the LLVM IR is not mapped to the SVFIR: it was released by "
+                                       "-release-llvm-ir, or the SVFIR was read from -svfir-cache-dir") << "\n";
+    abort();
 }
 
 void LLVMModuleSet::loadExtAPIModules()
@@ -931,6 +1171,7 @@ void LLVMModuleSet::buildGlobalDefToRepMap()
 // Dump modules to files
 void LLVMModuleSet::dumpModulesToFile(const std::string& suffix)
 {
+    checkLLVMIRMapped();
     for (Module& mod : modules)
     {
         std::string moduleName = mod.getName().str();
@@ -956,6 +1197,7 @@ void LLVMModuleSet::dumpModulesToFile(const std::string& suffix)
 
 NodeID LLVMModuleSet::getValueNode(const Value *llvm_value)
 {
+    checkLLVMIRMapped();
     if (SVFUtil::isa<ConstantPointerNull>(llvm_value))
         return svfir->nullPtrSymID();
     else if (SVFUtil::isa<UndefValue>(llvm_value))
@@ -969,6 +1211,7 @@ NodeID LLVMModuleSet::getValueNode(const Value *llvm_value)
 }
 bool LLVMModuleSet::hasValueNode(const Value *val)
 {
+    checkLLVMIRMapped();
     if (SVFUtil::isa<ConstantPointerNull, UndefValue>(val))
         return true;
     else
@@ -977,6 +1220,7 @@ bool LLVMModuleSet::hasValueNode(const Value *val)
 
 NodeID LLVMModuleSet::getObjectNode(const Value *llvm_value)
 {
+    checkLLVMIRMapped();
     if (const GlobalVariable* glob = SVFUtil::dyn_cast<GlobalVariable>(llvm_value))
         llvm_value = LLVMUtil::getGlobalRep(glob);
     ValueToIDMapTy::const_iterator iter = objSymMap.find(llvm_value);
@@ -1088,6 +1332,7 @@ SVFType* LLVMModuleSet::getSVFType(const Type* T)
 /// Get a basic block ICFGNode
 ICFGNode* LLVMModuleSet::getICFGNode(const Instruction* inst)
 {
+    checkLLVMIRMapped();
     ICFGNode* node;
     if(LLVMUtil::isNonInstricCallSite(inst))
         node = getCallICFGNode(inst);
@@ -1102,6 +1347,7 @@ ICFGNode* LLVMModuleSet::getICFGNode(const Instruction* inst)
 
 bool LLVMModuleSet::hasICFGNode(const Instruction* inst)
 {
+    checkLLVMIRMapped();
     ICFGNode* node;
     if(LLVMUtil::isNonInstricCallSite(inst))
         node = getCallBlock(inst);
@@ -1115,6 +1361,7 @@ bool LLVMModuleSet::hasICFGNode(const Instruction* inst)
 
 CallICFGNode* LLVMModuleSet::getCallICFGNode(const Instruction* inst)
 {
+    checkLLVMIRMapped();
     assert(LLVMUtil::isCallSite(inst) && "not a call instruction?");
     assert(LLVMUtil::isNonInstricCallSite(inst) && "associating an intrinsic debug instruction with an ICFGNode!");
     CallICFGNode* node = getCallBlock(inst);
@@ -1124,6 +1371,7 @@ CallICFGNode* LLVMModuleSet::getCallICFGNode(const Instruction* inst)
 
 RetICFGNode* LLVMModuleSet::getRetICFGNode(const Instruction* inst)
 {
+    checkLLVMIRMapped();
     assert(LLVMUtil::isCallSite(inst) && "not a call instruction?");
     assert(LLVMUtil::isNonInstricCallSite(inst) && "associating an intrinsic debug instruction with an ICFGNode!");
     RetICFGNode* node = getRetBlock(inst);
@@ -1133,6 +1381,7 @@ RetICFGNode* LLVMModuleSet::getRetICFGNode(const Instruction* inst)
 
 IntraICFGNode* LLVMModuleSet::getIntraICFGNode(const Instruction* inst)
 {
+    checkLLVMIRMapped();
     IntraICFGNode* node = getIntraBlock(inst);
     assert (node!=nullptr && "no IntraICFGNode for this instruction?");
     return node;
@@ -1377,6 +1626,16 @@ void LLVMModuleSet::setExtFuncAnnotations(const Function* fun, const std::vector
 {
     assert(fun && "Null SVFFunction* pointer");
     func2Annotations[fun] = funcAnnotations;
+    func2ExtInfo[fun] = ExtAPI::compileAnnotations(funcAnnotations);
+}
+
+const ExtAPI::ExtFuncInfo& LLVMModuleSet::getExtFuncInfo(const Function* fun) const
+{
+    static const ExtAPI::ExtFuncInfo noAnnotation;
+    auto it = func2ExtInfo.find(fun);
+    if (it != func2ExtInfo.end())
+        return it->second;
+    return noAnnotation;
 }
 
 bool LLVMModuleSet::hasExtFuncAnnotation(const Function* fun, const std::string& funcAnnotation)
@@ -1416,52 +1675,43 @@ const std::vector<std::string>& LLVMModuleSet::getExtFuncAnnotations(const Funct
 
 bool LLVMModuleSet::is_memcpy(const Function *F)
 {
-    return F &&
-           (hasExtFuncAnnotation(F, "MEMCPY") ||  hasExtFuncAnnotation(F, "STRCPY")
-            || hasExtFuncAnnotation(F, "STRCAT"));
+    return F && getExtFuncInfo(F).has(ExtAPI::EXT_MEMCPY);
 }
 
 bool LLVMModuleSet::is_memset(const Function *F)
 {
-    return F && hasExtFuncAnnotation(F, "MEMSET");
+    return F && getExtFuncInfo(F).has(ExtAPI::EXT_MEMSET);
 }
 
 bool LLVMModuleSet::is_alloc(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_RET");
+    return F && getExtFuncInfo(F).has(ExtAPI::EXT_ALLOC_HEAP_RET);
 }
 
 // Does (F) allocate a new object and assign it to one of its arguments?
 bool LLVMModuleSet::is_arg_alloc(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
+    return F && getExtFuncInfo(F).has(ExtAPI::EXT_ALLOC_HEAP_ARG);
 }
 
 bool LLVMModuleSet::is_alloc_stack_ret(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_STACK_RET");
+    return F && getExtFuncInfo(F).has(ExtAPI::EXT_ALLOC_STACK_RET);
 }
 
 // Get the position of argument which holds the new object
 s32_t LLVMModuleSet::get_alloc_arg_pos(const Function* F)
 {
-    std::string allocArg = getExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
-    assert(!allocArg.empty() && "Not an alloc call via argument or incorrect extern function annotation!");
-
-    std::string number;
-    for (char c : allocArg)
-    {
-        if (isdigit(c))
-            number.push_back(c);
-    }
-    assert(!number.empty() && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
-    return std::stoi(number);
+    const ExtAPI::ExtFuncInfo& info = getExtFuncInfo(F);
+    assert(info.has(ExtAPI::EXT_ALLOC_HEAP_ARG) && "Not an alloc call via argument or incorrect extern function annotation!");
+    assert(info.allocArgPos >= 0 && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
+    return info.allocArgPos;
 }
 
 // Does (F) reallocate a new object?
 bool LLVMModuleSet::is_realloc(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "REALLOC_HEAP_RET");
+    return F && getExtFuncInfo(F).has(ExtAPI::EXT_REALLOC_HEAP_RET);
 }
 
 
@@ -1472,8 +1722,6 @@ bool LLVMModuleSet::is_ext(const Function* F)
     assert(F && "Null SVFFunction* pointer");
     if (F->isDeclaration() || F->isIntrinsic())
         return true;
-    else if (hasExtFuncAnnotation(F, "OVERWRITE") && getExtFuncAnnotations(F).size() == 1)
-        return false;
-    else
-        return !getExtFuncAnnotations(F).empty();
+    const ExtAPI::ExtFuncInfo& info = getExtFuncInfo(F);
+    return info.has(ExtAPI::EXT_ANNOTATED) && !info.has(ExtAPI::EXT_OVERWRITE_ONLY);
 }
\ No newline at end of file
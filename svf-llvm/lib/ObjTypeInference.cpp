@@ -5,6 +5,7 @@
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/CppUtil.h"
 #include "Util/Casting.h"
+#include "Util/WorkStealing.h"
 
 #define TYPE_DEBUG 0 /* Turn this on if you're debugging type inference */
 #define ERR_MSG(msg)                                                           \
@@ -99,6 +100,161 @@ LLVMContext &ObjTypeInference::getLLVMCtx()
     return LLVMModuleSet::getLLVMModuleSet()->getContext();
 }
 
+/*!
+ * Values on a cycle of the def-use walk (e.g., through a phi or a recursive
+ * call) reach each other, so they all get the same result. The walk finds
+ * these cycles as strongly connected components (Tarjan's algorithm) and
+ * only caches a result once all values it depends on are complete, which
+ * makes every cached result independent of the order of the queries.
+ */
+template<class Collect>
+ObjTypeInference::ValueSet &ObjTypeInference::collectOverSCCs(ValueToValueSet &cache, const Value *start, Collect collect)
+{
+    auto cIt = cache.find(start);
+    if (cIt != cache.end())
+        return cIt->second;
+
+    // what is found at a value, and the values to continue with
+    typedef std::pair<ValueSet, std::vector<const Value *>> Step;
+    Map<const Value *, Step> steps;
+    Map<const Value *, u32_t> index;
+    Map<const Value *, u32_t> lowLink;
+    std::vector<std::pair<const Value *, size_t>> callStack;
+    std::vector<const Value *> sccStack;
+    ValueSet onStack;
+
+    auto visit = [&](const Value *val)
+    {
+        u32_t idx = index.size();
+        index[val] = lowLink[val] = idx;
+        Step &step = steps[val];
+        collect(val, step.first, step.second);
+        sccStack.push_back(val);
+        onStack.insert(val);
+        callStack.emplace_back(val, 0);
+    };
+
+    visit(start);
+    while (!callStack.empty())
+    {
+        const Value *val = callStack.back().first;
+        const std::vector<const Value *> &next = steps[val].second;
+        if (callStack.back().second < next.size())
+        {
+            const Value *succ = next[callStack.back().second++];
+            if (cache.count(succ))
+                continue;
+            if (!index.count(succ))
+                visit(succ);
+            else if (onStack.count(succ))
+                lowLink[val] = std::min(lowLink[val], index[succ]);
+            continue;
+        }
+
+        callStack.pop_back();
+        if (!callStack.empty())
+        {
+            const Value *parent = callStack.back().first;
+            lowLink[parent] = std::min(lowLink[parent], lowLink[val]);
+        }
+        if (lowLink[val] != index[val])
+            continue;
+
+        // val is the root of an SCC, all values it reaches outside are cached
+        std::vector<const Value *> scc;
+        const Value *member = nullptr;
+        do
+        {
+            member = sccStack.back();
+            sccStack.pop_back();
+            onStack.erase(member);
+            scc.push_back(member);
+        }
+        while (member != val);
+
+        ValueSet result;
+        for (const Value *m : scc)
+        {
+            const Step &step = steps[m];
+            result.insert(step.first.begin(), step.first.end());
+            for (const Value *succ : step.second)
+            {
+                auto sIt = cache.find(succ);
+                if (sIt != cache.end())
+                    result.insert(sIt->second.begin(), sIt->second.end());
+            }
+        }
+        for (const Value *m : scc)
+        {
+            if (m != val)
+                cache[m] = result;
+        }
+        cache[val] = SVFUtil::move(result);
+    }
+    return cache[start];
+}
+
+ObjTypeInference::ValueSet &ObjTypeInference::fwFindInferSites(ValueToInferSites &valueToInferSites, const Value *var)
+{
+    return collectOverSCCs(valueToInferSites, var,
+                           [this](const Value *curValue, ValueSet &infersites, std::vector<const Value *> &next)
+    {
+        fwInferSites(curValue, infersites, next);
+    });
+}
+
+ObjTypeInference::ValueSet &ObjTypeInference::bwFindAllocs(ValueToSources &valueToAllocs, const Value *var)
+{
+    return collectOverSCCs(valueToAllocs, var,
+                           [this](const Value *curValue, ValueSet &sources, std::vector<const Value *> &next)
+    {
+        bwAllocs(curValue, sources, next);
+    });
+}
+
+/*!
+ * Each thread walks with caches of its own, which are merged in thread order
+ * afterwards. A cached result only depends on the IR, so it does not matter
+ * which thread computed it. Types are still selected when queried, since that
+ * may create SVF types.
+ */
+void ObjTypeInference::inferObjTypes(const std::vector<const Value *> &vars, u32_t numThreads)
+{
+    numThreads = std::max(1u, std::min<u32_t>(numThreads, vars.size()));
+    std::vector<ValueToInferSites> inferSites(numThreads);
+    std::vector<ValueToSources> allocs(numThreads);
+    WorkStealingPool<size_t> pool(numThreads);
+    for (size_t i = 0; i < vars.size(); ++i)
+        pool.push(i);
+    pool.run([this, &vars, &inferSites, &allocs](const size_t i, const unsigned thread)
+    {
+        const Value *var = vars[i];
+        if (isAlloc(var))
+        {
+            if (!_valueToInferSites.count(var))
+                fwFindInferSites(inferSites[thread], var);
+            return;
+        }
+        auto aIt = _valueToAllocs.find(var);
+        const ValueSet &sources = aIt != _valueToAllocs.end() ? aIt->second : bwFindAllocs(allocs[thread], var);
+        if (sources.empty() && !_valueToInferSites.count(var))
+            fwFindInferSites(inferSites[thread], var);
+        for (const Value *source : sources)
+        {
+            if (!SVFUtil::isa<AllocaInst, GlobalValue>(source) && !_valueToInferSites.count(source))
+                fwFindInferSites(inferSites[thread], source);
+        }
+    });
+
+    for (u32_t t = 0; t < numThreads; ++t)
+    {
+        for (auto &it : inferSites[t])
+            _valueToInferSites.emplace(it.first, SVFUtil::move(it.second));
+        for (auto &it : allocs[t])
+            _valueToAllocs.emplace(it.first, SVFUtil::move(it.second));
+    }
+}
+
 /*!
  * get or infer the type of the object pointed by var
  * if the start value is a source (alloc/global, heap, static), call fwInferObjType
@@ -193,303 +349,266 @@ const Type *ObjTypeInference::fwInferObjType(const Value *var)
             return tIt->second ? tIt->second : defaultType(var);
         }
 
-        // simulate the call stack, the second element indicates whether we should update valueTypes for current value
-        FILOWorkList<ValueBoolPair> workList;
-        Set<ValueBoolPair> visited;
-        workList.push({var, false});
-
-        while (!workList.empty())
+        Set<const Type*> types;
+        const ValueSet& infersites = fwFindInferSites(_valueToInferSites, var);
+        std::transform(infersites.begin(), infersites.end(),
+                       std::inserter(types, types.begin()),
+                       infersiteToType);
+        const Type* type = _valueToType[var] = selectLargestSizedType(types);
+        if (type == nullptr)
         {
-            auto curPair = workList.pop();
-            if (visited.count(curPair))
-                continue;
-            visited.insert(curPair);
-            const Value* curValue = curPair.first;
-            bool canUpdate = curPair.second;
-            Set<const Value*> infersites;
+            type = defaultType(var);
+            WARN_MSG("Using default type, trace ID is " +
+                     std::to_string(traceId) + ":" + dumpValueAndDbgInfo(var));
+        }
+        ABORT_IFNOT(type, "type cannot be a null ptr");
+        return type;
+    }
+}
 
-            auto insertInferSite = [&infersites,
-                                    &canUpdate](const Value* infersite)
-            {
-                if (canUpdate)
-                    infersites.insert(infersite);
-            };
-            auto insertInferSitesOrPushWorklist =
-                [this, &infersites, &workList, &canUpdate](const auto& pUser)
-            {
-                auto vIt = _valueToInferSites.find(pUser);
-                if (canUpdate)
-                {
-                    if (vIt != _valueToInferSites.end())
-                    {
-                        infersites.insert(vIt->second.begin(),
-                                          vIt->second.end());
-                    }
-                }
-                else
-                {
-                    if (vIt == _valueToInferSites.end())
-                        workList.push({pUser, false});
-                }
-            };
-            if (!canUpdate && !_valueToInferSites.count(curValue))
+/*!
+ * collect the infer sites of the object pointed by var
+ * (e.g., loads, stores and geps using it) and the values var flows to
+ * @param curValue
+ * @param infersites
+ * @param next
+ */
+void ObjTypeInference::fwInferSites(const Value *curValue, ValueSet &infersites, std::vector<const Value *> &next)
+{
+    if (const auto* gepInst =
+                SVFUtil::dyn_cast<GetElementPtrInst>(curValue))
+        infersites.insert(gepInst);
+    for (const auto it : curValue->users())
+    {
+        if (const auto* loadInst = SVFUtil::dyn_cast<LoadInst>(it))
+        {
+            /*
+             * infer based on load, e.g.,
+             %call = call i8* malloc()
+             %1 = bitcast i8* %call to %struct.MyStruct*
+             %q = load %struct.MyStruct, %struct.MyStruct* %1
+             */
+            infersites.insert(loadInst);
+        }
+        else if (const auto* storeInst =
+                     SVFUtil::dyn_cast<StoreInst>(it))
+        {
+            if (storeInst->getPointerOperand() == curValue)
             {
-                workList.push({curValue, true});
+                /*
+                 * infer based on store (pointer operand), e.g.,
+                 %call = call i8* malloc()
+                 %1 = bitcast i8* %call to %struct.MyStruct*
+                 store %struct.MyStruct .., %struct.MyStruct* %1
+                 */
+                infersites.insert(storeInst);
             }
-            if (const auto* gepInst =
-                        SVFUtil::dyn_cast<GetElementPtrInst>(curValue))
-                insertInferSite(gepInst);
-            for (const auto it : curValue->users())
+            else
             {
-                if (const auto* loadInst = SVFUtil::dyn_cast<LoadInst>(it))
+                for (const auto nit :
+                        storeInst->getPointerOperand()->users())
                 {
                     /*
-                     * infer based on load, e.g.,
+                     * propagate across store (value operand) and load
                      %call = call i8* malloc()
-                     %1 = bitcast i8* %call to %struct.MyStruct*
-                     %q = load %struct.MyStruct, %struct.MyStruct* %1
-                     */
-                    insertInferSite(loadInst);
+                     store i8* %call, i8** %p
+                     %q = load i8*, i8** %p
+                     ..infer based on %q..
+                    */
+                    if (SVFUtil::isa<LoadInst>(nit))
+                        next.push_back(nit);
                 }
-                else if (const auto* storeInst =
-                             SVFUtil::dyn_cast<StoreInst>(it))
+                /*
+                * infer based on store (value operand) <- gep (result element)
+                 */
+                if (const auto* gepInst =
+                            SVFUtil::dyn_cast<GetElementPtrInst>(
+                                storeInst->getPointerOperand()))
                 {
-                    if (storeInst->getPointerOperand() == curValue)
-                    {
-                        /*
-                         * infer based on store (pointer operand), e.g.,
-                         %call = call i8* malloc()
-                         %1 = bitcast i8* %call to %struct.MyStruct*
-                         store %struct.MyStruct .., %struct.MyStruct* %1
-                         */
-                        insertInferSite(storeInst);
-                    }
-                    else
+                    /*
+                      %call1 = call i8* @TYPE_MALLOC(i32 noundef 16, i32
+                      noundef 2), !dbg !39 %2 = bitcast i8* %call1 to
+                      %struct.MyStruct*, !dbg !41 %3 = load
+                      %struct.MyStruct*, %struct.MyStruct** %p, align 8,
+                      !dbg !42 %next = getelementptr inbounds
+                      %struct.MyStruct, %struct.MyStruct* %3, i32 0, i32
+                      1, !dbg !43 store %struct.MyStruct* %2,
+                      %struct.MyStruct** %next, align 8, !dbg !44 %5 =
+                      load %struct.MyStruct*, %struct.MyStruct** %p,
+                      align 8, !dbg !48 %next3 = getelementptr inbounds
+                      %struct.MyStruct, %struct.MyStruct* %5, i32 0, i32
+                      1, !dbg !49 %6 = load %struct.MyStruct*,
+                      %struct.MyStruct** %next3, align 8, !dbg !49 infer
+                      site -> %f1 = getelementptr inbounds
+                      %struct.MyStruct, %struct.MyStruct* %6, i32 0, i32
+                      0, !dbg !50
+                     */
+                    const Value* gepBase = gepInst->getPointerOperand();
+                    if (const auto* load =
+                                SVFUtil::dyn_cast<LoadInst>(gepBase))
                     {
-                        for (const auto nit :
-                                storeInst->getPointerOperand()->users())
-                        {
-                            /*
-                             * propagate across store (value operand) and load
-                             %call = call i8* malloc()
-                             store i8* %call, i8** %p
-                             %q = load i8*, i8** %p
-                             ..infer based on %q..
-                            */
-                            if (SVFUtil::isa<LoadInst>(nit))
-                                insertInferSitesOrPushWorklist(nit);
-                        }
-                        /*
-                        * infer based on store (value operand) <- gep (result element)
-                         */
-                        if (const auto* gepInst =
-                                    SVFUtil::dyn_cast<GetElementPtrInst>(
-                                        storeInst->getPointerOperand()))
+                        for (const auto loadUse :
+                                load->getPointerOperand()->users())
                         {
-                            /*
-                              %call1 = call i8* @TYPE_MALLOC(i32 noundef 16, i32
-                              noundef 2), !dbg !39 %2 = bitcast i8* %call1 to
-                              %struct.MyStruct*, !dbg !41 %3 = load
-                              %struct.MyStruct*, %struct.MyStruct** %p, align 8,
-                              !dbg !42 %next = getelementptr inbounds
-                              %struct.MyStruct, %struct.MyStruct* %3, i32 0, i32
-                              1, !dbg !43 store %struct.MyStruct* %2,
-                              %struct.MyStruct** %next, align 8, !dbg !44 %5 =
-                              load %struct.MyStruct*, %struct.MyStruct** %p,
-                              align 8, !dbg !48 %next3 = getelementptr inbounds
-                              %struct.MyStruct, %struct.MyStruct* %5, i32 0, i32
-                              1, !dbg !49 %6 = load %struct.MyStruct*,
-                              %struct.MyStruct** %next3, align 8, !dbg !49 infer
-                              site -> %f1 = getelementptr inbounds
-                              %struct.MyStruct, %struct.MyStruct* %6, i32 0, i32
-                              0, !dbg !50
-                             */
-                            const Value* gepBase = gepInst->getPointerOperand();
-                            if (const auto* load =
-                                        SVFUtil::dyn_cast<LoadInst>(gepBase))
-                            {
-                                for (const auto loadUse :
-                                        load->getPointerOperand()->users())
-                                {
-                                    if (loadUse == load ||
-                                            !SVFUtil::isa<LoadInst>(loadUse))
-                                        continue;
-                                    for (const auto gepUse : loadUse->users())
-                                    {
-                                        if (!SVFUtil::isa<GetElementPtrInst>(
-                                                    gepUse))
-                                            continue;
-                                        for (const auto loadUse2 :
-                                                gepUse->users())
-                                        {
-                                            if (SVFUtil::isa<LoadInst>(
-                                                        loadUse2))
-                                            {
-                                                insertInferSitesOrPushWorklist(
-                                                    loadUse2);
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            else if (const auto* alloc =
-                                         SVFUtil::dyn_cast<AllocaInst>(gepBase))
+                            if (loadUse == load ||
+                                    !SVFUtil::isa<LoadInst>(loadUse))
+                                continue;
+                            for (const auto gepUse : loadUse->users())
                             {
-                                /*
-                                  %2 = alloca %struct.ll, align 8
-                                  store i32 0, ptr %1, align 4
-                                  %3 = call noalias noundef nonnull ptr
-                                  @_Znwm(i64 noundef 16) #2 %4 = getelementptr
-                                  inbounds %struct.ll, ptr %2, i32 0, i32 1
-                                  store ptr %3, ptr %4, align 8
-                                  %5 = getelementptr inbounds %struct.ll, ptr
-                                  %2, i32 0, i32 1 %6 = load ptr, ptr %5, align
-                                  8 %7 = getelementptr inbounds %struct.ll, ptr
-                                  %6, i32 0, i32 0
-                                 */
-                                for (const auto gepUse : alloc->users())
+                                if (!SVFUtil::isa<GetElementPtrInst>(
+                                            gepUse))
+                                    continue;
+                                for (const auto loadUse2 :
+                                        gepUse->users())
                                 {
-                                    if (!SVFUtil::isa<GetElementPtrInst>(
-                                                gepUse))
-                                        continue;
-                                    for (const auto loadUse2 : gepUse->users())
+                                    if (SVFUtil::isa<LoadInst>(
+                                                loadUse2))
                                     {
-                                        if (SVFUtil::isa<LoadInst>(loadUse2))
-                                        {
-                                            insertInferSitesOrPushWorklist(
-                                                loadUse2);
-                                        }
+                                        next.push_back(
+                                            loadUse2);
                                     }
                                 }
                             }
                         }
                     }
-                }
-                else if (const auto* gepInst =
-                             SVFUtil::dyn_cast<GetElementPtrInst>(it))
-                {
-                    /*
-                     * infer based on gep (pointer operand)
-                     %call = call i8* malloc()
-                     %1 = bitcast i8* %call to %struct.MyStruct*
-                     %next = getelementptr inbounds %struct.MyStruct,
-                     %struct.MyStruct* %1, i32 0..
-                     */
-                    if (gepInst->getPointerOperand() == curValue)
-                        insertInferSite(gepInst);
-                }
-                else if (const auto* bitcast =
-                             SVFUtil::dyn_cast<BitCastInst>(it))
-                {
-                    // continue on bitcast
-                    insertInferSitesOrPushWorklist(bitcast);
-                }
-                else if (const auto* phiNode = SVFUtil::dyn_cast<PHINode>(it))
-                {
-                    // continue on bitcast
-                    insertInferSitesOrPushWorklist(phiNode);
-                }
-                else if (const auto* retInst =
-                             SVFUtil::dyn_cast<ReturnInst>(it))
-                {
-                    /*
-                     * propagate from return to caller
-                      Function Attrs: noinline nounwind optnone uwtable
-                      define dso_local i8* @malloc_wrapper() #0 !dbg !22 {
-                          entry:
-                          %call = call i8* @malloc(i32 noundef 16), !dbg !25
-                          ret i8* %call, !dbg !26
-                     }
-                     %call = call i8* @malloc_wrapper()
-                     ..infer based on %call..
-                    */
-                    for (const auto callsite : retInst->getFunction()->users())
+                    else if (const auto* alloc =
+                                 SVFUtil::dyn_cast<AllocaInst>(gepBase))
                     {
-                        if (const auto* callBase =
-                                    SVFUtil::dyn_cast<CallBase>(callsite))
+                        /*
+                          %2 = alloca %struct.ll, align 8
+                          store i32 0, ptr %1, align 4
+                          %3 = call noalias noundef nonnull ptr
+                          @_Znwm(i64 noundef 16) #2 %4 = getelementptr
+                          inbounds %struct.ll, ptr %2, i32 0, i32 1
+                          store ptr %3, ptr %4, align 8
+                          %5 = getelementptr inbounds %struct.ll, ptr
+                          %2, i32 0, i32 1 %6 = load ptr, ptr %5, align
+                          8 %7 = getelementptr inbounds %struct.ll, ptr
+                          %6, i32 0, i32 0
+                         */
+                        for (const auto gepUse : alloc->users())
                         {
-                            // skip function as parameter
-                            // e.g., call void @foo(%struct.ssl_ctx_st* %9, i32 (i8*, i32, i32, i8*)* @passwd_callback)
-                            if (callBase->getCalledFunction() !=
-                                    retInst->getFunction())
+                            if (!SVFUtil::isa<GetElementPtrInst>(
+                                        gepUse))
                                 continue;
-                            insertInferSitesOrPushWorklist(callBase);
+                            for (const auto loadUse2 : gepUse->users())
+                            {
+                                if (SVFUtil::isa<LoadInst>(loadUse2))
+                                {
+                                    next.push_back(
+                                        loadUse2);
+                                }
+                            }
                         }
                     }
                 }
-                else if (const auto* callBase = SVFUtil::dyn_cast<CallBase>(it))
+            }
+        }
+        else if (const auto* gepInst =
+                     SVFUtil::dyn_cast<GetElementPtrInst>(it))
+        {
+            /*
+             * infer based on gep (pointer operand)
+             %call = call i8* malloc()
+             %1 = bitcast i8* %call to %struct.MyStruct*
+             %next = getelementptr inbounds %struct.MyStruct,
+             %struct.MyStruct* %1, i32 0..
+             */
+            if (gepInst->getPointerOperand() == curValue)
+                infersites.insert(gepInst);
+        }
+        else if (const auto* bitcast =
+                     SVFUtil::dyn_cast<BitCastInst>(it))
+        {
+            // continue on bitcast
+            next.push_back(bitcast);
+        }
+        else if (const auto* phiNode = SVFUtil::dyn_cast<PHINode>(it))
+        {
+            // continue on bitcast
+            next.push_back(phiNode);
+        }
+        else if (const auto* retInst =
+                     SVFUtil::dyn_cast<ReturnInst>(it))
+        {
+            /*
+             * propagate from return to caller
+              Function Attrs: noinline nounwind optnone uwtable
+              define dso_local i8* @malloc_wrapper() #0 !dbg !22 {
+                  entry:
+                  %call = call i8* @malloc(i32 noundef 16), !dbg !25
+                  ret i8* %call, !dbg !26
+             }
+             %call = call i8* @malloc_wrapper()
+             ..infer based on %call..
+            */
+            for (const auto callsite : retInst->getFunction()->users())
+            {
+                if (const auto* callBase =
+                            SVFUtil::dyn_cast<CallBase>(callsite))
                 {
-                    /*
-                     * propagate from callsite to callee
-                      %call = call i8* @malloc(i32 noundef 16)
-                      %0 = bitcast i8* %call to %struct.Node*, !dbg !43
-                      call void @foo(%struct.Node* noundef %0), !dbg !45
-
-                      define dso_local void @foo(%struct.Node* noundef %param)
-                     #0 !dbg !22 {...}
-                      ..infer based on the formal param %param..
-                     */
-                    // skip global function value -> callsite
-                    // e.g., def @foo() -> call @foo()
-                    // we don't skip function as parameter, e.g., def @foo() -> call @bar(..., @foo)
-                    if (SVFUtil::isa<Function>(curValue) &&
-                            curValue == callBase->getCalledFunction())
-                        continue;
-                    // skip indirect call
-                    // e.g., %0 = ... -> call %0(...)
-                    if (!callBase->hasArgument(curValue))
+                    // skip function as parameter
+                    // e.g., call void @foo(%struct.ssl_ctx_st* %9, i32 (i8*, i32, i32, i8*)* @passwd_callback)
+                    if (callBase->getCalledFunction() !=
+                            retInst->getFunction())
                         continue;
-                    if (Function* calleeFunc = callBase->getCalledFunction())
+                    next.push_back(callBase);
+                }
+            }
+        }
+        else if (const auto* callBase = SVFUtil::dyn_cast<CallBase>(it))
+        {
+            /*
+             * propagate from callsite to callee
+              %call = call i8* @malloc(i32 noundef 16)
+              %0 = bitcast i8* %call to %struct.Node*, !dbg !43
+              call void @foo(%struct.Node* noundef %0), !dbg !45
+
+              define dso_local void @foo(%struct.Node* noundef %param)
+             #0 !dbg !22 {...}
+              ..infer based on the formal param %param..
+             */
+            // skip global function value -> callsite
+            // e.g., def @foo() -> call @foo()
+            // we don't skip function as parameter, e.g., def @foo() -> call @bar(..., @foo)
+            if (SVFUtil::isa<Function>(curValue) &&
+                    curValue == callBase->getCalledFunction())
+                continue;
+            // skip indirect call
+            // e.g., %0 = ... -> call %0(...)
+            if (!callBase->hasArgument(curValue))
+                continue;
+            if (Function* calleeFunc = callBase->getCalledFunction())
+            {
+                u32_t pos = getArgPosInCall(callBase, curValue);
+                // for varargs function, we cannot directly get the value-flow between actual and formal args e.g., consider the following vararg function @callee 1: call void @callee(%arg) 2: define dso_local i32 @callee(...) #0 !dbg !17 { 3:  ....... 4:  %5 = load i32, ptr %vaarg.addr, align 4, !dbg !55 5:  .......
+                // 6: }
+                // it is challenging to precisely identify the forward value-flow of %arg (Line 2) because the function definition of callee (Line 2) does not have any formal args related to the actual arg %arg therefore we track all possible instructions like ``load i32, ptr %vaarg.addr''
+                if (calleeFunc->isVarArg())
+                {
+                    // conservatively track all var args
+                    for (auto& I : instructions(calleeFunc))
                     {
-                        u32_t pos = getArgPosInCall(callBase, curValue);
-                        // for varargs function, we cannot directly get the value-flow between actual and formal args e.g., consider the following vararg function @callee 1: call void @callee(%arg) 2: define dso_local i32 @callee(...) #0 !dbg !17 { 3:  ....... 4:  %5 = load i32, ptr %vaarg.addr, align 4, !dbg !55 5:  .......
-                        // 6: }
-                        // it is challenging to precisely identify the forward value-flow of %arg (Line 2) because the function definition of callee (Line 2) does not have any formal args related to the actual arg %arg therefore we track all possible instructions like ``load i32, ptr %vaarg.addr''
-                        if (calleeFunc->isVarArg())
+                        if (auto* load =
+                                    llvm::dyn_cast<llvm::LoadInst>(&I))
                         {
-                            // conservatively track all var args
-                            for (auto& I : instructions(calleeFunc))
+                            llvm::Value* loadPointer =
+                                load->getPointerOperand();
+                            if (loadPointer->getName().compare(
+                                        "vaarg.addr") == 0)
                             {
-                                if (auto* load =
-                                            llvm::dyn_cast<llvm::LoadInst>(&I))
-                                {
-                                    llvm::Value* loadPointer =
-                                        load->getPointerOperand();
-                                    if (loadPointer->getName().compare(
-                                                "vaarg.addr") == 0)
-                                    {
-                                        insertInferSitesOrPushWorklist(load);
-                                    }
-                                }
+                                next.push_back(load);
                             }
                         }
-                        else if (!calleeFunc->isDeclaration())
-                        {
-                            insertInferSitesOrPushWorklist(
-                                calleeFunc->getArg(pos));
-                        }
                     }
                 }
-            }
-            if (canUpdate)
-            {
-                Set<const Type*> types;
-                std::transform(infersites.begin(), infersites.end(),
-                               std::inserter(types, types.begin()),
-                               infersiteToType);
-                _valueToInferSites[curValue] = SVFUtil::move(infersites);
-                _valueToType[curValue] = selectLargestSizedType(types);
+                else if (!calleeFunc->isDeclaration())
+                {
+                    next.push_back(
+                        calleeFunc->getArg(pos));
+                }
             }
         }
-        const Type* type = _valueToType[var];
-        if (type == nullptr)
-        {
-            type = defaultType(var);
-            WARN_MSG("Using default type, trace ID is " +
-                     std::to_string(traceId) + ":" + dumpValueAndDbgInfo(var));
-        }
-        ABORT_IFNOT(type, "type cannot be a null ptr");
-        return type;
     }
 }
 
@@ -500,124 +619,84 @@ const Type *ObjTypeInference::fwInferObjType(const Value *var)
  */
 Set<const Value *> &ObjTypeInference::bwfindAllocOfVar(const Value *var)
 {
-
-    // consult cache
-    auto tIt = _valueToAllocs.find(var);
-    if (tIt != _valueToAllocs.end())
+    Set<const Value *> &srcs = bwFindAllocs(_valueToAllocs, var);
+    if (srcs.empty())
     {
-        return tIt->second;
+        WARN_MSG("Cannot find allocation: " + dumpValueAndDbgInfo(var));
     }
+    return srcs;
+}
 
-    // simulate the call stack, the second element indicates whether we should update sources for current value
-    FILOWorkList<ValueBoolPair> workList;
-    Set<ValueBoolPair> visited;
-    workList.push({var, false});
-    while (!workList.empty())
+/*!
+ * collect curValue if it is an allocation (stack, static, heap), or else
+ * the values it may come from
+ * @param curValue
+ * @param sources
+ * @param next
+ */
+void ObjTypeInference::bwAllocs(const Value *curValue, ValueSet &sources, std::vector<const Value *> &next)
+{
+    if (isAlloc(curValue))
     {
-        auto curPair = workList.pop();
-        if (visited.count(curPair)) continue;
-        visited.insert(curPair);
-        const Value *curValue = curPair.first;
-        bool canUpdate = curPair.second;
-
-        Set<const Value *> sources;
-        auto insertAllocs = [&sources, &canUpdate](const Value *source)
-        {
-            if (canUpdate) sources.insert(source);
-        };
-        auto insertAllocsOrPushWorklist = [this, &sources, &workList, &canUpdate](const auto &pUser)
-        {
-            auto vIt = _valueToAllocs.find(pUser);
-            if (canUpdate)
-            {
-                if (vIt != _valueToAllocs.end())
-                {
-                    sources.insert(vIt->second.begin(), vIt->second.end());
-                }
-            }
-            else
-            {
-                if (vIt == _valueToAllocs.end()) workList.push({pUser, false});
-            }
-        };
-
-        if (!canUpdate && !_valueToAllocs.count(curValue))
-        {
-            workList.push({curValue, true});
-        }
-
-        if (isAlloc(curValue))
-        {
-            insertAllocs(curValue);
-        }
-        else if (const auto *bitCastInst = SVFUtil::dyn_cast<BitCastInst>(curValue))
-        {
-            Value *prevVal = bitCastInst->getOperand(0);
-            insertAllocsOrPushWorklist(prevVal);
-        }
-        else if (const auto *phiNode = SVFUtil::dyn_cast<PHINode>(curValue))
+        sources.insert(curValue);
+    }
+    else if (const auto *bitCastInst = SVFUtil::dyn_cast<BitCastInst>(curValue))
+    {
+        Value *prevVal = bitCastInst->getOperand(0);
+        next.push_back(prevVal);
+    }
+    else if (const auto *phiNode = SVFUtil::dyn_cast<PHINode>(curValue))
+    {
+        for (u32_t i = 0; i < phiNode->getNumOperands(); ++i)
         {
-            for (u32_t i = 0; i < phiNode->getNumOperands(); ++i)
-            {
-                insertAllocsOrPushWorklist(phiNode->getOperand(i));
-            }
+            next.push_back(phiNode->getOperand(i));
         }
-        else if (const auto *loadInst = SVFUtil::dyn_cast<LoadInst>(curValue))
+    }
+    else if (const auto *loadInst = SVFUtil::dyn_cast<LoadInst>(curValue))
+    {
+        for (const auto use: loadInst->getPointerOperand()->users())
         {
-            for (const auto use: loadInst->getPointerOperand()->users())
+            if (const StoreInst *storeInst = SVFUtil::dyn_cast<StoreInst>(use))
             {
-                if (const StoreInst *storeInst = SVFUtil::dyn_cast<StoreInst>(use))
+                if (storeInst->getPointerOperand() == loadInst->getPointerOperand())
                 {
-                    if (storeInst->getPointerOperand() == loadInst->getPointerOperand())
-                    {
-                        insertAllocsOrPushWorklist(storeInst->getValueOperand());
-                    }
+                    next.push_back(storeInst->getValueOperand());
                 }
             }
         }
-        else if (const auto *argument = SVFUtil::dyn_cast<Argument>(curValue))
+    }
+    else if (const auto *argument = SVFUtil::dyn_cast<Argument>(curValue))
+    {
+        for (const auto use: argument->getParent()->users())
         {
-            for (const auto use: argument->getParent()->users())
+            if (const CallBase *callBase = SVFUtil::dyn_cast<CallBase>(use))
             {
-                if (const CallBase *callBase = SVFUtil::dyn_cast<CallBase>(use))
-                {
-                    // skip function as parameter
-                    // e.g., call void @foo(%struct.ssl_ctx_st* %9, i32 (i8*, i32, i32, i8*)* @passwd_callback)
-                    if (callBase->getCalledFunction() != argument->getParent()) continue;
-                    u32_t pos = argument->getParent()->isVarArg() ? 0 : argument->getArgNo();
-                    insertAllocsOrPushWorklist(callBase->getArgOperand(pos));
-                }
+                // skip function as parameter
+                // e.g., call void @foo(%struct.ssl_ctx_st* %9, i32 (i8*, i32, i32, i8*)* @passwd_callback)
+                if (callBase->getCalledFunction() != argument->getParent()) continue;
+                u32_t pos = argument->getParent()->isVarArg() ? 0 : argument->getArgNo();
+                next.push_back(callBase->getArgOperand(pos));
             }
         }
-        else if (const auto *callBase = SVFUtil::dyn_cast<CallBase>(curValue))
+    }
+    else if (const auto *callBase = SVFUtil::dyn_cast<CallBase>(curValue))
+    {
+        ABORT_IFNOT(!callBase->doesNotReturn(), "callbase does not return:" + dumpValueAndDbgInfo(callBase));
+        if (Function *callee = callBase->getCalledFunction())
         {
-            ABORT_IFNOT(!callBase->doesNotReturn(), "callbase does not return:" + dumpValueAndDbgInfo(callBase));
-            if (Function *callee = callBase->getCalledFunction())
+            if (!callee->isDeclaration())
             {
-                if (!callee->isDeclaration())
-                {
 
-                    LLVMModuleSet* llvmmodule = LLVMModuleSet::getLLVMModuleSet();
-                    const BasicBlock* exitBB = llvmmodule->getFunExitBB(callee);
-                    assert (exitBB && "exit bb is not a basic block?");
-                    const Value *pValue = &exitBB->back();
-                    const auto *retInst = SVFUtil::dyn_cast<ReturnInst>(pValue);
-                    ABORT_IFNOT(retInst && retInst->getReturnValue(), "not return inst?");
-                    insertAllocsOrPushWorklist(retInst->getReturnValue());
-                }
+                LLVMModuleSet* llvmmodule = LLVMModuleSet::getLLVMModuleSet();
+                const BasicBlock* exitBB = llvmmodule->getFunExitBB(callee);
+                assert (exitBB && "exit bb is not a basic block?");
+                const Value *pValue = &exitBB->back();
+                const auto *retInst = SVFUtil::dyn_cast<ReturnInst>(pValue);
+                ABORT_IFNOT(retInst && retInst->getReturnValue(), "not return inst?");
+                next.push_back(retInst->getReturnValue());
             }
         }
-        if (canUpdate)
-        {
-            _valueToAllocs[curValue] = SVFUtil::move(sources);
-        }
-    }
-    Set<const Value *> &srcs = _valueToAllocs[var];
-    if (srcs.empty())
-    {
-        WARN_MSG("Cannot find allocation: " + dumpValueAndDbgInfo(var));
     }
-    return srcs;
 }
 
 bool ObjTypeInference::isAlloc(const SVF::Value *val)
@@ -793,139 +872,101 @@ Set<std::string> &ObjTypeInference::inferThisPtrClsName(const Value *thisPtr)
  */
 Set<const Value *> &ObjTypeInference::bwFindAllocOrClsNameSources(const Value *startValue)
 {
-
-    // consult cache
-    auto tIt = _valueToAllocOrClsNameSources.find(startValue);
-    if (tIt != _valueToAllocOrClsNameSources.end())
+    return collectOverSCCs(_valueToAllocOrClsNameSources, startValue,
+                           [this](const Value *curValue, ValueSet &sources, std::vector<const Value *> &next)
     {
-        return tIt->second;
-    }
+        bwAllocsOrClsNameSources(curValue, sources, next);
+    });
+}
 
-    // simulate the call stack, the second element indicates whether we should update sources for current value
-    FILOWorkList<ValueBoolPair> workList;
-    Set<ValueBoolPair> visited;
-    workList.push({startValue, false});
-    while (!workList.empty())
+/*!
+ * collect curValue if it is an allocation or a class name source, and the
+ * values it may come from
+ * @param curValue
+ * @param sources
+ * @param next
+ */
+void ObjTypeInference::bwAllocsOrClsNameSources(const Value *curValue, ValueSet &sources, std::vector<const Value *> &next)
+{
+    // If current value is an instruction inside a constructor/destructor/template, use it as a source
+    if (const auto *inst = SVFUtil::dyn_cast<Instruction>(curValue))
     {
-        auto curPair = workList.pop();
-        if (visited.count(curPair)) continue;
-        visited.insert(curPair);
-        const Value *curValue = curPair.first;
-        bool canUpdate = curPair.second;
-
-        Set<const Value *> sources;
-        auto insertSource = [&sources, &canUpdate](const Value *source)
+        if (const auto *parent = inst->getFunction())
         {
-            if (canUpdate) sources.insert(source);
-        };
-        auto insertSourcesOrPushWorklist = [this, &sources, &workList, &canUpdate](const auto &pUser)
-        {
-            auto vIt = _valueToAllocOrClsNameSources.find(pUser);
-            if (canUpdate)
-            {
-                if (vIt != _valueToAllocOrClsNameSources.end() && !vIt->second.empty())
-                {
-                    sources.insert(vIt->second.begin(), vIt->second.end());
-                }
-            }
-            else
-            {
-                if (vIt == _valueToAllocOrClsNameSources.end()) workList.push({pUser, false});
-            }
-        };
-
-        if (!canUpdate && !_valueToAllocOrClsNameSources.count(curValue))
-        {
-            workList.push({curValue, true});
-        }
-
-        // If current value is an instruction inside a constructor/destructor/template, use it as a source
-        if (const auto *inst = SVFUtil::dyn_cast<Instruction>(curValue))
-        {
-            if (const auto *parent = inst->getFunction())
-            {
-                if (isClsNameSource(parent)) insertSource(parent);
-            }
+            if (isClsNameSource(parent)) sources.insert(parent);
         }
+    }
 
-        // If the current value is an object (global, heap, stack, etc) or name source (constructor/destructor,
-        // a C++ dynamic cast, or a template function), use it as a source
-        if (isAlloc(curValue) || isClsNameSource(curValue))
-        {
-            insertSource(curValue);
-        }
+    // If the current value is an object (global, heap, stack, etc) or name source (constructor/destructor,
+    // a C++ dynamic cast, or a template function), use it as a source
+    if (isAlloc(curValue) || isClsNameSource(curValue))
+    {
+        sources.insert(curValue);
+    }
 
-        // Explore the current value further depending on the type of the value; use cached values if possible
-        if (const auto *getElementPtrInst = SVFUtil::dyn_cast<GetElementPtrInst>(curValue))
-        {
-            insertSourcesOrPushWorklist(getElementPtrInst->getPointerOperand());
-        }
-        else if (const auto *bitCastInst = SVFUtil::dyn_cast<BitCastInst>(curValue))
-        {
-            insertSourcesOrPushWorklist(bitCastInst->getOperand(0));
-        }
-        else if (const auto *phiNode = SVFUtil::dyn_cast<PHINode>(curValue))
+    // Explore the current value further depending on the type of the value; use cached values if possible
+    if (const auto *getElementPtrInst = SVFUtil::dyn_cast<GetElementPtrInst>(curValue))
+    {
+        next.push_back(getElementPtrInst->getPointerOperand());
+    }
+    else if (const auto *bitCastInst = SVFUtil::dyn_cast<BitCastInst>(curValue))
+    {
+        next.push_back(bitCastInst->getOperand(0));
+    }
+    else if (const auto *phiNode = SVFUtil::dyn_cast<PHINode>(curValue))
+    {
+        for (const auto *op : phiNode->operand_values())
         {
-            for (const auto *op : phiNode->operand_values())
-            {
-                insertSourcesOrPushWorklist(op);
-            }
+            next.push_back(op);
         }
-        else if (const auto *loadInst = SVFUtil::dyn_cast<LoadInst>(curValue))
+    }
+    else if (const auto *loadInst = SVFUtil::dyn_cast<LoadInst>(curValue))
+    {
+        for (const auto *user : loadInst->getPointerOperand()->users())
         {
-            for (const auto *user : loadInst->getPointerOperand()->users())
+            if (const auto *storeInst = SVFUtil::dyn_cast<StoreInst>(user))
             {
-                if (const auto *storeInst = SVFUtil::dyn_cast<StoreInst>(user))
+                if (storeInst->getPointerOperand() == loadInst->getPointerOperand())
                 {
-                    if (storeInst->getPointerOperand() == loadInst->getPointerOperand())
-                    {
-                        insertSourcesOrPushWorklist(storeInst->getValueOperand());
-                    }
+                    next.push_back(storeInst->getValueOperand());
                 }
             }
         }
-        else if (const auto *argument = SVFUtil::dyn_cast<Argument>(curValue))
+    }
+    else if (const auto *argument = SVFUtil::dyn_cast<Argument>(curValue))
+    {
+        for (const auto *user: argument->getParent()->users())
         {
-            for (const auto *user: argument->getParent()->users())
+            if (const auto *callBase = SVFUtil::dyn_cast<CallBase>(user))
             {
-                if (const auto *callBase = SVFUtil::dyn_cast<CallBase>(user))
-                {
-                    // skip function as parameter
-                    // e.g., call void @foo(%struct.ssl_ctx_st* %9, i32 (i8*, i32, i32, i8*)* @passwd_callback)
-                    if (callBase->getCalledFunction() != argument->getParent()) continue;
-                    u32_t pos = argument->getParent()->isVarArg() ? 0 : argument->getArgNo();
-                    insertSourcesOrPushWorklist(callBase->getArgOperand(pos));
-                }
+                // skip function as parameter
+                // e.g., call void @foo(%struct.ssl_ctx_st* %9, i32 (i8*, i32, i32, i8*)* @passwd_callback)
+                if (callBase->getCalledFunction() != argument->getParent()) continue;
+                u32_t pos = argument->getParent()->isVarArg() ? 0 : argument->getArgNo();
+                next.push_back(callBase->getArgOperand(pos));
             }
         }
-        else if (const auto *callBase = SVFUtil::dyn_cast<CallBase>(curValue))
+    }
+    else if (const auto *callBase = SVFUtil::dyn_cast<CallBase>(curValue))
+    {
+        ABORT_IFNOT(!callBase->doesNotReturn(), "callbase does not return:" + dumpValueAndDbgInfo(callBase));
+        if (const auto *callee = callBase->getCalledFunction())
         {
-            ABORT_IFNOT(!callBase->doesNotReturn(), "callbase does not return:" + dumpValueAndDbgInfo(callBase));
-            if (const auto *callee = callBase->getCalledFunction())
+            if (!callee->isDeclaration())
             {
-                if (!callee->isDeclaration())
-                {
-                    LLVMModuleSet* llvmmodule = LLVMModuleSet::getLLVMModuleSet();
-                    const BasicBlock* exitBB = llvmmodule->getFunExitBB(callee);
-                    assert (exitBB && "exit bb is not a basic block?");
-                    const Value *pValue = &exitBB->back();
-                    const auto *retInst = SVFUtil::dyn_cast<ReturnInst>(pValue);
-                    ABORT_IFNOT(retInst && retInst->getReturnValue(), "not return inst?");
-                    insertSourcesOrPushWorklist(retInst->getReturnValue());
-                }
+                LLVMModuleSet* llvmmodule = LLVMModuleSet::getLLVMModuleSet();
+                const BasicBlock* exitBB = llvmmodule->getFunExitBB(callee);
+                assert (exitBB && "exit bb is not a basic block?");
+                const Value *pValue = &exitBB->back();
+                const auto *retInst = SVFUtil::dyn_cast<ReturnInst>(pValue);
+                ABORT_IFNOT(retInst && retInst->getReturnValue(), "not return inst?");
+                next.push_back(retInst->getReturnValue());
             }
         }
-
-        // If updating is allowed; store the gathered sources as sources for the current value in the cache
-        if (canUpdate)
-        {
-            _valueToAllocOrClsNameSources[curValue] = sources;
-        }
     }
-
-    return _valueToAllocOrClsNameSources[startValue];
 }
 
+
 Set<const CallBase *> &ObjTypeInference::fwFindClsNameSources(const Value *startValue)
 {
     assert(startValue && "startValue was null?");
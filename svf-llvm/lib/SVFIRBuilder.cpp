@@ -7,10 +7,12 @@
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/SymbolTableBuilder.h"
 #include "SVFIR/PAGBuilderFromFile.h"
+#include "SVFIR/SVFFileSystem.h"
 #include "Util/CallGraphBuilder.h"
 #include "Graphs/CallGraph.h"
 #include "Util/Options.h"
 #include "Util/SVFUtil.h"
+#include "Util/WorkStealing.h"
 
 using namespace std;
 using namespace SVF;
@@ -34,9 +36,14 @@ SVFIR* SVFIRBuilder::build()
         return fileBuilder.build();
     }
 
-    // If the SVFIR has been built before, then we return the unique SVFIR of the program
+    // If the SVFIR has been built before (or read from the cache), then we return
+    // the unique SVFIR of the program
     if(pag->getNodeNumAfterPAGBuild() > 1)
+    {
+        if (Options::ReleaseLLVMIR())
+            llvmModuleSet()->releaseLLVMIR();
         return pag;
+    }
 
 
     createFunObjVars();
@@ -129,6 +136,8 @@ SVFIR* SVFIRBuilder::build()
 
     pag->setNodeNumAfterPAGBuild(pag->getTotalNodeNum());
 
+    pag->compactStorage();
+
     // dump SVFIR
     if (Options::PAGDotGraph())
         pag->dump("svfir_initial");
@@ -147,11 +156,14 @@ SVFIR* SVFIRBuilder::build()
         loopAnalysis.build(pag->getICFG());
     }
 
-    // dump SVFIR as JSON
-    if (!Options::DumpJson().empty())
-    {
-        assert(false && "please implement SVFIRWriter::writeJsonToPath");
-    }
+    // write SVFIR to a binary file
+    if (!Options::WriteSVFIR().empty())
+        SVFIRWriter::writeToFile(pag, Options::WriteSVFIR());
+    llvmModuleSet()->writeSVFIRToCache(pag);
+
+    // release the LLVM IR before the analyses, which run on the SVFIR only
+    if (Options::ReleaseLLVMIR())
+        llvmModuleSet()->releaseLLVMIR();
 
     double endTime = SVFStat::getClk(true);
     SVFStat::timeOfBuildingSVFIR = (endTime - startTime) / TIMEINTERVAL;
@@ -161,6 +173,7 @@ SVFIR* SVFIRBuilder::build()
 
 void SVFIRBuilder::initFunObjVar()
 {
+    std::vector<std::pair<FunObjVar*, const Function*>> defFuns;
     for (Module& mod : llvmModuleSet()->getLLVMModules())
     {
         /// Function
@@ -169,15 +182,16 @@ void SVFIRBuilder::initFunObjVar()
             FunObjVar* svffun = const_cast<FunObjVar*>(llvmModuleSet()->getFunObjVar(&f));
             initSVFBasicBlock(&f);
 
-            if (!LLVMUtil::isExtCall(&f))
+            if (!LLVMUtil::isExtCall(&f) && !f.isDeclaration())
             {
-                initDomTree(svffun, &f);
+                defFuns.emplace_back(svffun, &f);
             }
             /// set realDefFun for all functions
             const Function *realfun = llvmModuleSet()->getRealDefFun(&f);
             svffun->setRelDefFun(realfun == nullptr ? nullptr : llvmModuleSet()->getFunObjVar(realfun));
         }
     }
+    initDomTrees(defFuns);
 
     // Store annotations of functions in extapi.bc
     for (const auto& pair : llvmModuleSet()->ExtFun2Annotations)
@@ -230,6 +244,35 @@ void SVFIRBuilder::initSVFBasicBlock(const Function* func)
 }
 
 
+/*!
+ * Compute the dominator, post-dominator and loop info of all defined functions.
+ * Each function only fills its own SVFLoopAndDomInfo and only reads the
+ * (already built) basic block map, so functions are independent and are
+ * processed by -dom-info-threads threads.
+ */
+void SVFIRBuilder::initDomTrees(const std::vector<std::pair<FunObjVar*, const Function*>>& funs)
+{
+    double startTime = SVFStat::getClk(true);
+
+    std::vector<const Function*> llvmFuns;
+    llvmFuns.reserve(funs.size());
+    for (const std::pair<FunObjVar*, const Function*>& fun : funs)
+        llvmFuns.push_back(fun.second);
+
+    const unsigned numThreads = std::max(1u, std::min<unsigned>(Options::DomInfoThreads(), funs.size()));
+    llvmModuleSet()->buildDomTrees(llvmFuns, numThreads);
+
+    WorkStealingPool<size_t> pool(numThreads);
+    for (size_t i = 0; i < funs.size(); ++i)
+        pool.push(i);
+    pool.run([this, &funs](const size_t i, const unsigned)
+    {
+        initDomTree(funs[i].first, funs[i].second);
+    });
+
+    SVFStat::timeOfBuildingDomInfo = (SVFStat::getClk(true) - startTime) / TIMEINTERVAL;
+}
+
 void SVFIRBuilder::initDomTree(FunObjVar* svffun, const Function* fun)
 {
     if (fun->isDeclaration())
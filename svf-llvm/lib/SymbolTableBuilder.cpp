@@ -9,6 +9,7 @@
 #include "Util/NodeIDAllocator.h"
 #include "Util/Options.h"
 #include "Util/SVFUtil.h"
+#include "Util/WorkStealing.h"
 #include "SVF-LLVM/ObjTypeInference.h"
 
 using namespace SVF;
@@ -81,124 +82,60 @@ void SymbolTableBuilder::buildMemModel()
         }
 
         // Add symbols for all of the functions and the instructions in them.
+        // The steps of collectSym (expanding constant expressions, finding
+        // types and objects) are recorded function by function in parallel,
+        // and the types of the heap objects found are inferred in parallel
+        // too. The steps are then replayed in the order they were recorded,
+        // so IDs do not depend on the number of threads.
+        std::vector<const Function*> funs;
         for (const Function& fun : M.functions())
+            funs.push_back(&fun);
+        std::vector<FunSyms> funSyms(funs.size());
+        if (!funs.empty())
         {
-            collectSym(&fun);
-            collectRet(&fun);
-            if (fun.getFunctionType()->isVarArg())
-                collectVararg(&fun);
-
-            // Add symbols for all formal parameters.
-            for (const Argument& arg : fun.args())
+            WorkStealingPool<size_t> pool(std::max(1u, std::min<unsigned>(Options::SymbolTableThreads(), funs.size())));
+            for (size_t i = 0; i < funs.size(); ++i)
+                pool.push(i);
+            pool.run([this, &funs, &funSyms](const size_t i, const unsigned)
             {
-                collectSym(&arg);
-            }
+                discoverFunSyms(*funs[i], funSyms[i]);
+            });
+        }
 
-            // collect and create symbols inside the function body
-            for (const Instruction& inst : instructions(fun))
-            {
-                collectSym(&inst);
+        u32_t inferThreads = std::max(Options::TypeInferenceThreads(), Options::SymbolTableThreads());
+        if (inferThreads > 1)
+        {
+            std::vector<const Value*> heapStarts;
+            for (const FunSyms& syms : funSyms)
+                heapStarts.insert(heapStarts.end(), syms.heapStarts.begin(), syms.heapStarts.end());
+            inferTypesOfHeapObjs(heapStarts, inferThreads);
+        }
 
-                // initialization for some special instructions
-                //{@
-                if (const StoreInst* st = SVFUtil::dyn_cast<StoreInst>(&inst))
-                {
-                    collectSym(st->getPointerOperand());
-                    collectSym(st->getValueOperand());
-                }
-                else if (const LoadInst* ld =
-                             SVFUtil::dyn_cast<LoadInst>(&inst))
-                {
-                    collectSym(ld->getPointerOperand());
-                }
-                else if (const AllocaInst* alloc =
-                             SVFUtil::dyn_cast<AllocaInst>(&inst))
-                {
-                    collectSym(alloc->getArraySize());
-                }
-                else if (const PHINode* phi = SVFUtil::dyn_cast<PHINode>(&inst))
-                {
-                    for (u32_t i = 0; i < phi->getNumIncomingValues(); ++i)
-                    {
-                        collectSym(phi->getIncomingValue(i));
-                    }
-                }
-                else if (const GetElementPtrInst* gep =
-                             SVFUtil::dyn_cast<GetElementPtrInst>(&inst))
-                {
-                    collectSym(gep->getPointerOperand());
-                    for (u32_t i = 0; i < gep->getNumOperands(); ++i)
-                    {
-                        collectSym(gep->getOperand(i));
-                    }
-                }
-                else if (const SelectInst* sel =
-                             SVFUtil::dyn_cast<SelectInst>(&inst))
-                {
-                    collectSym(sel->getTrueValue());
-                    collectSym(sel->getFalseValue());
-                    collectSym(sel->getCondition());
-                }
-                else if (const BinaryOperator* binary =
-                             SVFUtil::dyn_cast<BinaryOperator>(&inst))
-                {
-                    for (u32_t i = 0; i < binary->getNumOperands(); i++)
-                        collectSym(binary->getOperand(i));
-                }
-                else if (const UnaryOperator* unary =
-                             SVFUtil::dyn_cast<UnaryOperator>(&inst))
-                {
-                    for (u32_t i = 0; i < unary->getNumOperands(); i++)
-                        collectSym(unary->getOperand(i));
-                }
-                else if (const CmpInst* cmp = SVFUtil::dyn_cast<CmpInst>(&inst))
-                {
-                    for (u32_t i = 0; i < cmp->getNumOperands(); i++)
-                        collectSym(cmp->getOperand(i));
-                }
-                else if (const CastInst* cast =
-                             SVFUtil::dyn_cast<CastInst>(&inst))
-                {
-                    collectSym(cast->getOperand(0));
-                }
-                else if (const ReturnInst* ret =
-                             SVFUtil::dyn_cast<ReturnInst>(&inst))
-                {
-                    if (ret->getReturnValue())
-                        collectSym(ret->getReturnValue());
-                }
-                else if (const BranchInst* br =
-                             SVFUtil::dyn_cast<BranchInst>(&inst))
-                {
-                    Value* opnd = br->isConditional() ? br->getCondition() : br->getOperand(0);
-                    collectSym(opnd);
-                }
-                else if (const SwitchInst* sw =
-                             SVFUtil::dyn_cast<SwitchInst>(&inst))
-                {
-                    collectSym(sw->getCondition());
-                }
-                else if (isNonInstricCallSite(&inst))
-                {
+        for (size_t i = 0; i < funs.size(); ++i)
+        {
+            const Function* fun = funs[i];
+            collectSym(fun);
+            collectRet(fun);
+            if (fun->getFunctionType()->isVarArg())
+                collectVararg(fun);
 
-                    const CallBase* cs = LLVMUtil::getLLVMCallSite(&inst);
-                    for (u32_t i = 0; i < cs->arg_size(); i++)
-                    {
-                        collectSym(cs->getArgOperand(i));
-                    }
-                    // Calls to inline asm need to be added as well because the
-                    // callee isn't referenced anywhere else.
-                    const Value* Callee = cs->getCalledOperand();
-                    collectSym(Callee);
-
-                    // TODO handle inlineAsm
-                    /// if (SVFUtil::isa<InlineAsm>(Callee))
-                    if (Options::EnableTypeCheck())
-                    {
-                        getTypeInference()->validateTypeCheck(cs);
-                    }
+            for (const FunSym& sym : funSyms[i].syms)
+            {
+                switch (sym.kind)
+                {
+                case FunSym::Val:
+                    collectVal(sym.val);
+                    break;
+                case FunSym::Obj:
+                    collectObj(sym.val);
+                    break;
+                case FunSym::SVFType:
+                    (void)getOrAddSVFTypeInfo(sym.type);
+                    break;
+                case FunSym::TypeCheck:
+                    getTypeInference()->validateTypeCheck(SVFUtil::cast<CallBase>(sym.val));
+                    break;
                 }
-                //@}
             }
         }
     }
@@ -210,6 +147,258 @@ void SymbolTableBuilder::buildMemModel()
     }
 }
 
+/*!
+ * Call collect on each value handleCE collects for val, in the same order.
+ * Only the LLVM IR is read, so discoverFunSyms can expand constant
+ * expressions in parallel.
+ */
+template <typename Collect>
+static void forEachCEVal(const Value* val, const Collect& collect)
+{
+    if (const Constant* ref = SVFUtil::dyn_cast<Constant>(val))
+    {
+        if (const ConstantExpr* ce = isGepConstantExpr(ref))
+        {
+            collect(ce);
+
+            // handle the recursive constant express case
+            // like (gep (bitcast (gep X 1)) 1); the inner gep is ce->getOperand(0)
+            for (u32_t i = 0; i < ce->getNumOperands(); ++i)
+            {
+                collect(ce->getOperand(i));
+                forEachCEVal(ce->getOperand(i), collect);
+            }
+        }
+        else if (const ConstantExpr* ce = isCastConstantExpr(ref))
+        {
+            collect(ce);
+            collect(ce->getOperand(0));
+            // handle the recursive constant express case
+            // like (gep (bitcast (gep X 1)) 1); the inner gep is ce->getOperand(0)
+            forEachCEVal(ce->getOperand(0), collect);
+        }
+        else if (const ConstantExpr* ce = isSelectConstantExpr(ref))
+        {
+            collect(ce);
+            collect(ce->getOperand(0));
+            collect(ce->getOperand(1));
+            collect(ce->getOperand(2));
+            // handle the recursive constant express case
+            // like (gep (bitcast (gep X 1)) 1); the inner gep is ce->getOperand(0)
+            forEachCEVal(ce->getOperand(0), collect);
+            forEachCEVal(ce->getOperand(1), collect);
+            forEachCEVal(ce->getOperand(2), collect);
+        }
+        // if we meet a int2ptr, then it points-to black hole
+        else if (const ConstantExpr* int2Ptrce = isInt2PtrConstantExpr(ref))
+        {
+            collect(int2Ptrce);
+            const Constant* opnd = int2Ptrce->getOperand(0);
+            forEachCEVal(opnd, collect);
+        }
+        else if (const ConstantExpr* ptr2Intce = isPtr2IntConstantExpr(ref))
+        {
+            collect(ptr2Intce);
+            const Constant* opnd = ptr2Intce->getOperand(0);
+            forEachCEVal(opnd, collect);
+        }
+        else if (isTruncConstantExpr(ref) || isCmpConstantExpr(ref))
+        {
+            collect(ref);
+        }
+        else if (isBinaryConstantExpr(ref))
+        {
+            collect(ref);
+        }
+        else if (isUnaryConstantExpr(ref))
+        {
+            // we don't handle unary constant expression like fneg(x) now
+            collect(ref);
+        }
+        else if (SVFUtil::isa<ConstantAggregate>(ref))
+        {
+            // we don't handle constant aggregate like constant vectors
+            collect(ref);
+        }
+        else
+        {
+            assert(!SVFUtil::isa<ConstantExpr>(val) &&
+                   "we don't handle all other constant expression for now!");
+            collect(ref);
+        }
+    }
+}
+
+/*!
+ * Record the steps collectSym takes for the formal parameters and the body
+ * of fun, in the order buildMemModel used to take them: the values of
+ * constant expressions, the value itself, its types and its object. Each
+ * type check follows the operands of its call site, as it used to. Repeated
+ * steps are dropped since taking them again has no effect. The start values
+ * of heap objects are recorded for type inference. Only the LLVM IR is read
+ * here, so functions can be processed in parallel.
+ */
+void SymbolTableBuilder::discoverFunSyms(const Function& fun, FunSyms& funSyms)
+{
+    Set<const Value*> seen, vals, objs;
+    Set<const Type*> types;
+    std::vector<FunSym>& syms = funSyms.syms;
+    auto addVal = [&syms, &vals](const Value* val)
+    {
+        if (vals.insert(val).second)
+            syms.push_back({FunSym::Val, val, nullptr});
+    };
+    auto addType = [&syms, &types](const Type* type)
+    {
+        if (types.insert(type).second)
+            syms.push_back({FunSym::SVFType, nullptr, type});
+    };
+    // the types collectSVFTypeInfo adds
+    auto addTypes = [&addType](const Value* val)
+    {
+        addType(val->getType());
+        if(isGepConstantExpr(val) || SVFUtil::isa<GetElementPtrInst>(val))
+        {
+            for (bridge_gep_iterator
+                    gi = bridge_gep_begin(SVFUtil::cast<User>(val)),
+                    ge = bridge_gep_end(SVFUtil::cast<User>(val));
+                    gi != ge; ++gi)
+                addType(*gi);
+        }
+    };
+    // the steps of collectSym
+    auto addSym = [&](const Value* val)
+    {
+        if (!seen.insert(val).second)
+            return;
+        forEachCEVal(val, addVal);
+        addVal(val);
+        addTypes(val);
+        addTypes(LLVMUtil::getGlobalRep(val));
+        if (isObject(val) && objs.insert(val).second)
+            syms.push_back({FunSym::Obj, val, nullptr});
+    };
+
+    // Add symbols for all formal parameters.
+    for (const Argument& arg : fun.args())
+    {
+        addSym(&arg);
+    }
+
+    // collect and create symbols inside the function body
+    for (const Instruction& inst : instructions(fun))
+    {
+        addSym(&inst);
+
+        // initialization for some special instructions
+        //{@
+        if (const StoreInst* st = SVFUtil::dyn_cast<StoreInst>(&inst))
+        {
+            addSym(st->getPointerOperand());
+            addSym(st->getValueOperand());
+        }
+        else if (const LoadInst* ld =
+                     SVFUtil::dyn_cast<LoadInst>(&inst))
+        {
+            addSym(ld->getPointerOperand());
+        }
+        else if (const AllocaInst* alloc =
+                     SVFUtil::dyn_cast<AllocaInst>(&inst))
+        {
+            addSym(alloc->getArraySize());
+        }
+        else if (const PHINode* phi = SVFUtil::dyn_cast<PHINode>(&inst))
+        {
+            for (u32_t i = 0; i < phi->getNumIncomingValues(); ++i)
+            {
+                addSym(phi->getIncomingValue(i));
+            }
+        }
+        else if (const GetElementPtrInst* gep =
+                     SVFUtil::dyn_cast<GetElementPtrInst>(&inst))
+        {
+            addSym(gep->getPointerOperand());
+            for (u32_t i = 0; i < gep->getNumOperands(); ++i)
+            {
+                addSym(gep->getOperand(i));
+            }
+        }
+        else if (const SelectInst* sel =
+                     SVFUtil::dyn_cast<SelectInst>(&inst))
+        {
+            addSym(sel->getTrueValue());
+            addSym(sel->getFalseValue());
+            addSym(sel->getCondition());
+        }
+        else if (const BinaryOperator* binary =
+                     SVFUtil::dyn_cast<BinaryOperator>(&inst))
+        {
+            for (u32_t i = 0; i < binary->getNumOperands(); i++)
+                addSym(binary->getOperand(i));
+        }
+        else if (const UnaryOperator* unary =
+                     SVFUtil::dyn_cast<UnaryOperator>(&inst))
+        {
+            for (u32_t i = 0; i < unary->getNumOperands(); i++)
+                addSym(unary->getOperand(i));
+        }
+        else if (const CmpInst* cmp = SVFUtil::dyn_cast<CmpInst>(&inst))
+        {
+            for (u32_t i = 0; i < cmp->getNumOperands(); i++)
+                addSym(cmp->getOperand(i));
+        }
+        else if (const CastInst* cast =
+                     SVFUtil::dyn_cast<CastInst>(&inst))
+        {
+            addSym(cast->getOperand(0));
+        }
+        else if (const ReturnInst* ret =
+                     SVFUtil::dyn_cast<ReturnInst>(&inst))
+        {
+            if (ret->getReturnValue())
+                addSym(ret->getReturnValue());
+        }
+        else if (const BranchInst* br =
+                     SVFUtil::dyn_cast<BranchInst>(&inst))
+        {
+            Value* opnd = br->isConditional() ? br->getCondition() : br->getOperand(0);
+            addSym(opnd);
+        }
+        else if (const SwitchInst* sw =
+                     SVFUtil::dyn_cast<SwitchInst>(&inst))
+        {
+            addSym(sw->getCondition());
+        }
+        else if (isNonInstricCallSite(&inst))
+        {
+
+            const CallBase* cs = LLVMUtil::getLLVMCallSite(&inst);
+            for (u32_t i = 0; i < cs->arg_size(); i++)
+            {
+                addSym(cs->getArgOperand(i));
+            }
+            // Calls to inline asm need to be added as well because the
+            // callee isn't referenced anywhere else.
+            const Value* Callee = cs->getCalledOperand();
+            addSym(Callee);
+
+            // TODO handle inlineAsm
+            /// if (SVFUtil::isa<InlineAsm>(Callee))
+            if (Options::EnableTypeCheck())
+                syms.push_back({FunSym::TypeCheck, cs, nullptr});
+
+            if (LLVMUtil::isHeapAllocExtCallViaRet(&inst))
+                funSyms.heapStarts.push_back(&inst);
+            else if (LLVMUtil::isHeapAllocExtCallViaArg(&inst))
+            {
+                u32_t arg_pos = LLVMUtil::getHeapAllocHoldingArgPosition(cs->getCalledFunction());
+                funSyms.heapStarts.push_back(cs->getArgOperand(arg_pos));
+            }
+        }
+        //@}
+    }
+}
+
 void SymbolTableBuilder::collectSVFTypeInfo(const Value* val)
 {
     Type *valType = val->getType();
@@ -351,93 +540,16 @@ void SymbolTableBuilder::collectVararg(const Function* val)
  */
 void SymbolTableBuilder::handleCE(const Value* val)
 {
-    if (const Constant* ref = SVFUtil::dyn_cast<Constant>(val))
+    if (SVFUtil::isa<ConstantExpr>(val))
+        DBOUT(DMemModelCE, outs() << "handle constant expression "
+              << llvmModuleSet()
+              ->getSVFValue(val)
+              ->toString()
+              << "\n");
+    forEachCEVal(val, [this](const Value* v)
     {
-        if (const ConstantExpr* ce = isGepConstantExpr(ref))
-        {
-            DBOUT(DMemModelCE, outs() << "handle constant expression "
-                  << llvmModuleSet()
-                  ->getSVFValue(ref)
-                  ->toString()
-                  << "\n");
-            collectVal(ce);
-
-            // handle the recursive constant express case
-            // like (gep (bitcast (gep X 1)) 1); the inner gep is ce->getOperand(0)
-            for (u32_t i = 0; i < ce->getNumOperands(); ++i)
-            {
-                collectVal(ce->getOperand(i));
-                handleCE(ce->getOperand(i));
-            }
-        }
-        else if (const ConstantExpr* ce = isCastConstantExpr(ref))
-        {
-            DBOUT(DMemModelCE, outs() << "handle constant expression "
-                  << llvmModuleSet()
-                  ->getSVFValue(ref)
-                  ->toString()
-                  << "\n");
-            collectVal(ce);
-            collectVal(ce->getOperand(0));
-            // handle the recursive constant express case
-            // like (gep (bitcast (gep X 1)) 1); the inner gep is ce->getOperand(0)
-            handleCE(ce->getOperand(0));
-        }
-        else if (const ConstantExpr* ce = isSelectConstantExpr(ref))
-        {
-            DBOUT(DMemModelCE, outs() << "handle constant expression "
-                  << llvmModuleSet()
-                  ->getSVFValue(ref)
-                  ->toString()
-                  << "\n");
-            collectVal(ce);
-            collectVal(ce->getOperand(0));
-            collectVal(ce->getOperand(1));
-            collectVal(ce->getOperand(2));
-            // handle the recursive constant express case
-            // like (gep (bitcast (gep X 1)) 1); the inner gep is ce->getOperand(0)
-            handleCE(ce->getOperand(0));
-            handleCE(ce->getOperand(1));
-            handleCE(ce->getOperand(2));
-        }
-        // if we meet a int2ptr, then it points-to black hole
-        else if (const ConstantExpr* int2Ptrce = isInt2PtrConstantExpr(ref))
-        {
-            collectVal(int2Ptrce);
-            const Constant* opnd = int2Ptrce->getOperand(0);
-            handleCE(opnd);
-        }
-        else if (const ConstantExpr* ptr2Intce = isPtr2IntConstantExpr(ref))
-        {
-            collectVal(ptr2Intce);
-            const Constant* opnd = ptr2Intce->getOperand(0);
-            handleCE(opnd);
-        }
-        else if (isTruncConstantExpr(ref) || isCmpConstantExpr(ref))
-        {
-            collectVal(ref);
-        }
-        else if (isBinaryConstantExpr(ref))
-        {
-            collectVal(ref);
-        }
-        else if (isUnaryConstantExpr(ref))
-        {
-            // we don't handle unary constant expression like fneg(x) now
-            collectVal(ref);
-        }
-        else if (SVFUtil::isa<ConstantAggregate>(ref))
-        {
-            // we don't handle constant aggregate like constant vectors
-            collectVal(ref);
-        }
-        else
-        {
-            assert(!SVFUtil::isa<ConstantExpr>(val) &&
-                   "we don't handle all other constant expression for now!");
-            collectVal(ref);
-        }
-    }
+        collectVal(v);
+    });
 }
 
 /*!
@@ -586,6 +698,15 @@ const Type* SymbolTableBuilder::inferTypeOfHeapObjOrStaticObj(const Instruction
     return inferedType;
 }
 
+/*!
+ * Walk the def-use chains of independent heap allocations in parallel; the
+ * types are then picked from the results in the order objects are created.
+ */
+void SymbolTableBuilder::inferTypesOfHeapObjs(const std::vector<const Value*>& startValues, u32_t numThreads)
+{
+    getTypeInference()->inferObjTypes(startValues, numThreads);
+}
+
 /*
  * Initial the memory object here
  */
@@ -849,6 +849,8 @@ int main(int argc, char** argv)
         return 0;
     }
 
+    // The call graph of the pointer analysis is mapped back to the LLVM IR
+    LLVMModuleSet::requireLLVMIR();
     LLVMModuleSet::getLLVMModuleSet()->buildSVFModule(moduleNameVec);
     SVFIRBuilder builder;
     SVFIR* pag = builder.build();
@@ -125,6 +125,8 @@ int main(int argc, char ** argv)
         LLVMModuleSet::preProcessBCs(moduleNameVec);
     }
 
+    // The modules are written back to files after the analysis
+    LLVMModuleSet::requireLLVMIR();
     LLVMModuleSet::buildSVFModule(moduleNameVec);
 
     /// Build Program Assignment Graph (SVFIR)
@@ -1,5 +1,6 @@
 
 #include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVFIR/SVFFileSystem.h"
 #include "Util/CommandLine.h"
 #include "Util/Options.h"
 
@@ -19,7 +20,7 @@ std::string replaceExtension(const std::string& path)
         SVFUtil::errs() << "Error: expect file with extension .bc or .ll\n";
         exit(EXIT_FAILURE);
     }
-    return path.substr(0, pos) + ".svf.json";
+    return path.substr(0, pos) + ".svfir";
 }
 
 int main(int argc, char** argv)
@@ -32,11 +33,18 @@ int main(int argc, char** argv)
         LLVMModuleSet::preProcessBCs(moduleNameVec);
     }
 
-    const std::string jsonPath = replaceExtension(moduleNameVec.front());
+    const std::string svfirPath = replaceExtension(moduleNameVec.front());
+    LLVMModuleSet::buildSVFModule(moduleNameVec);
     // PAG is borrowed from a unique_ptr, so we don't need to delete it.
+    SVFIRBuilder builder;
+    const SVFIR* pag = builder.build();
 
-    assert(false && "Please implement SVFIRWriter::writeJsonToPath");
-    SVFUtil::outs() << "SVF IR is written to '" << jsonPath << "'\n";
+    if (!SVFIRWriter::writeToFile(pag, svfirPath))
+    {
+        LLVMModuleSet::releaseLLVMModuleSet();
+        return EXIT_FAILURE;
+    }
+    SVFUtil::outs() << "SVF IR is written to '" << svfirPath << "'\n";
     LLVMModuleSet::releaseLLVMModuleSet();
     return 0;
 }
@@ -1,6 +1,7 @@
 
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVFIR/SVFFileSystem.h"
 #include "WPA/WPAPass.h"
 #include "Util/CommandLine.h"
 #include "Util/Options.h"
@@ -19,9 +20,11 @@ int main(int argc, char** argv)
     // Refers to content of a singleton unique_ptr<SVFIR> in SVFIR.
     SVFIR* pag;
 
-    if (Options::ReadJson())
+    if (Options::ReadSVFIR())
     {
-        assert(false && "please implement SVFIRReader::read");
+        pag = moduleNameVec.empty() ? nullptr : SVFIRReader::read(moduleNameVec.front());
+        if (pag == nullptr)
+            return 1;
     }
     else
     {
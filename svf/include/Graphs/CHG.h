@@ -26,6 +26,17 @@ public:
         DI
     };
 
+    /// A virtual function in a vtable, with the name that virtual call sites
+    /// are matched against
+    struct VFnTarget
+    {
+        const FunObjVar* callee;
+        std::string name;
+    };
+    typedef std::vector<VFnTarget> VFnTargets;
+    typedef std::pair<const GlobalObjVar*, u32_t> VTableIdxPair;
+    typedef Map<VTableIdxPair, VFnTargets> VTableIdxToVFnsMap;
+
     virtual bool csHasVFnsBasedonCHA(const CallICFGNode* cs) = 0;
     virtual const VFunSet &getCSVFsBasedonCHA(const CallICFGNode* cs) = 0;
     virtual bool csHasVtblsBasedonCHA(const CallICFGNode* cs) = 0;
@@ -231,6 +242,11 @@ public:
                  CHEdge::CHEDGETYPE edgeType);
     CHNode *getNode(const std::string name) const;
     void getVFnsFromVtbls(const CallICFGNode* cs, const VTableSet &vtbls, VFunSet &virtualFunctions) override;
+    /// Virtual functions at index idx of the vtable vtbl (memoised)
+    const VFnTargets& getVFnTargets(const GlobalObjVar* vtbl, u32_t idx);
+    /// Compute the virtual functions of (vtable, index) pairs up front, on
+    /// numThreads threads
+    void buildVFnTargets(const std::vector<VTableIdxPair>& vtblIdxPairs, u32_t numThreads);
     void dump(const std::string& filename);
     void view();
     void printCH();
@@ -300,6 +316,10 @@ private:
 
     CallNodeToVTableSetMap callNodeToCHAVtblsMap;
     CallNodeToVFunSetMap callNodeToCHAVFnsMap;
+
+    VTableIdxToVFnsMap vtblIdxToVFnsMap;
+
+    void collectVFnTargets(const GlobalObjVar* vtbl, u32_t idx, VFnTargets& targets) const;
 };
 
 } // End namespace SVF
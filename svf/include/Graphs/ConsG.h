@@ -5,6 +5,7 @@
 #include "Graphs/ConsGEdge.h"
 #include "Graphs/ConsGNode.h"
 #include "MSSA/SVFGBuilder.h"
+#include "Util/TypedArena.h"
 
 namespace SVF
 {
@@ -36,13 +37,15 @@ protected:
     ConstraintEdge::ConstraintEdgeSetTy LoadCGEdgeSet;
     ConstraintEdge::ConstraintEdgeSetTy StoreCGEdgeSet;
 
+    static u32_t numLiveGraphs; ///< Number of constraint graphs sharing the arenas
+
     void buildCG();
 
     void destroy();
 
     void clearSolitaries();  // remove nodes that are neither pointers nor connected with any edge
 
-    SVFStmt::SVFStmtSetTy& getPAGEdgeSet(SVFStmt::PEDGEK kind)
+    SVFStmt::SVFStmtTableTy& getPAGEdgeSet(SVFStmt::PEDGEK kind)
     {
         return pag->getPTASVFStmtSet(kind);
     }
@@ -64,6 +67,7 @@ public:
     /// Constructor
     ConstraintGraph(SVFIR* p): pag(p), edgeIndex(0)
     {
+        ++numLiveGraphs;
         buildCG();
     }
 
@@ -73,6 +77,13 @@ public:
         destroy();
     }
 
+    /// Arenas shared by all constraint graphs, enabled by -consg-arena.
+    /// Slabs are released in bulk once the last graph is destroyed.
+    //@{
+    static TypedArena<ConstraintNode>& getNodeArena();
+    static TypedArena<ConstraintEdge>& getEdgeArena();
+    //@}
+
     /// Get/add/remove constraint node
     //@{
     inline ConstraintNode* getConstraintNode(NodeID id) const
@@ -240,6 +251,12 @@ public:
     }
     //@}
 
+    /// Give live nodes new IDs (old ID -> new ID in newIDs) and forget the merged-away
+    /// nodes in removed, updating rep/sub relations accordingly. The renumbering must
+    /// preserve the relative order of all nodes on the graph so that the ordered edge
+    /// sets stay valid.
+    void renumberNodes(const Map<NodeID, NodeID>& newIDs, const NodeBS& removed);
+
     /// Move incoming direct edges of a sub node which is outside the SCC to its rep node
     /// Remove incoming direct edges of a sub node which is inside the SCC from its rep node
     /// Return TRUE if there's a gep edge inside this SCC (PWC).
@@ -38,6 +38,11 @@ public:
     ~ConstraintEdge()
     {
     }
+    /// Edges are allocated from ConstraintGraph::getEdgeArena()
+    //@{
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+    //@}
     /// Return edge ID
     inline EdgeID getEdgeID() const
     {
@@ -11,6 +11,7 @@ namespace SVF
 typedef GenericNode<ConstraintNode,ConstraintEdge> GenericConsNodeTy;
 class ConstraintNode : public GenericConsNodeTy
 {
+    friend class ConstraintGraph;
 
 public:
     typedef ConstraintEdge::ConstraintEdgeSetTy::iterator iterator;
@@ -48,6 +49,20 @@ public:
 
     }
 
+private:
+    /// Only used by ConstraintGraph::renumberNodes
+    inline void setId(NodeID newId)
+    {
+        id = newId;
+    }
+
+public:
+    /// Nodes are allocated from ConstraintGraph::getNodeArena()
+    //@{
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+    //@}
+
     /// Whether a node involves in PWC, if so, all its points-to elements should become field-insensitive.
     //@{
     inline bool isPWCNode() const
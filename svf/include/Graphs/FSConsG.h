@@ -66,12 +66,28 @@ public:
 
     typedef Map<NodeID, NodePair> IDToPairMap; // FSConsGNodeID to (PAGNodeID, SVFGNodeID)
     typedef Map<NodePair, NodeID> PairToIDMap; // (PAGNodeID, SVFGNodeID) to FSConsGNodeID
+    typedef Map<NodeID, NodeID> NodeToNodeMap;
+
+    /// Renumber the live versioned nodes densely after SCC merging has left holes in
+    /// their ID range. Return false if compaction was not worthwhile (fewer than
+    /// a quarter of the versioned IDs are dead) or not possible. Otherwise, movedIDs
+    /// holds old -> new IDs of live versioned nodes which got a new ID and removedIDs
+    /// the versioned nodes which had been merged away and no longer exist.
+    bool compactNodeIDs(NodeToNodeMap& movedIDs, NodeBS& removedIDs);
+
+    /// Return the ID a (possibly compacted) node was given when the graph was built
+    inline NodeID getOriginalID(NodeID id) const
+    {
+        NodeToNodeMap::const_iterator it = compactedToOriginal.find(id);
+        return it == compactedToOriginal.end() ? id : it->second;
+    }
 
 protected:
     u32_t totalCGNode;
     // SVFG* svfg;
     IDToPairMap idTopairMap;
     PairToIDMap pairToidMap;
+    NodeToNodeMap compactedToOriginal;  ///< translation table of compacted IDs for reporting
 
     void buildSVFG2CG(SVFG* svfg);
 
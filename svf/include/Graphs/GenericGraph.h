@@ -147,6 +147,16 @@ public:
             delete edge;
     }
 
+protected:
+    /// Forget the outgoing edges without deleting them, for graphs which
+    /// release the memory of their edges in bulk
+    inline void dropOutEdges()
+    {
+        OutEdges.clear();
+    }
+
+public:
+
     /// Get incoming/outgoing edge set
     ///@{
     inline const GEdgeSetTy& getOutEdges() const
@@ -78,13 +78,23 @@ public:
     typedef Set<const SVFStmt*> SVFStmtSet;
 
 protected:
-    SVFStmt::KindToSVFStmtMapTy KindToSVFStmtSetMap; ///< SVFIR edge map containing all PAGEdges
-    SVFStmt::KindToSVFStmtMapTy KindToPTASVFStmtSetMap; ///< SVFIR edge map containing only pointer-related edges, i.e., both LHS and RHS are of pointer type
+    SVFStmt::KindToSVFStmtTableMapTy KindToSVFStmtSetMap; ///< SVFIR edge map containing all PAGEdges
+    SVFStmt::KindToSVFStmtTableMapTy KindToPTASVFStmtSetMap; ///< SVFIR edge map containing only pointer-related edges, i.e., both LHS and RHS are of pointer type
     bool fromFile; ///< Whether the SVFIR is built according to user specified data from a txt file
     NodeID nodeNumAfterPAGBuild; ///< initial node number after building SVFIR, excluding later added nodes, e.g., gepobj nodes
     u32_t totalPTAPAGEdge;
     u32_t valVarNum;
     u32_t objVarNum;
+    bool storageCompacted; ///< Whether compactStorage has sorted the statement tables
+
+    /// Add a statement to a statement table: appended during the build, inserted in order afterwards
+    inline void addToStmtTable(SVFStmt::SVFStmtTableTy& table, SVFStmt* edge)
+    {
+        if (storageCompacted)
+            table.insert(edge);
+        else
+            table.append(edge);
+    }
 
     /// Add a node into the graph
     inline NodeID addNode(SVFVar* node)
@@ -111,12 +121,16 @@ protected:
 public:
     IRGraph(bool buildFromFile)
         : totalSymNum(0), fromFile(buildFromFile), nodeNumAfterPAGBuild(0), totalPTAPAGEdge(0), valVarNum(0), objVarNum(0),
-          maxStruct(nullptr), maxStSize(0)
+          storageCompacted(false), maxStruct(nullptr), maxStSize(0)
     {
     }
 
     virtual ~IRGraph();
 
+    /// Sort the statement tables and release the spare memory of the statement
+    /// tables and the per-variable edge maps once the graph is built
+    void compactStorage();
+
 
     /// Whether this SVFIR built from a txt file
     inline bool isBuiltFromFile()
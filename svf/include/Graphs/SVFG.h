@@ -81,6 +81,15 @@ protected:
     PointerAnalysis* pta;
     Set<IndirectSVFGEdge*> indirectEdgeSet;
 
+    static u32_t numLiveSVFGs; ///< Number of SVFGs sharing the label cache of indirect edges
+
+    /// Regions, defs and versions of the memory SSA nodes read from a binary file
+    //@{
+    std::vector<std::unique_ptr<MemRegion>> loadedMRs;
+    std::vector<std::unique_ptr<MSSADEF>> loadedMRDefs;
+    std::vector<std::unique_ptr<MRVer>> loadedMRVers;
+    //@}
+
     /// Clean up memory
     void destroy();
 
@@ -247,6 +256,17 @@ public:
     virtual void readFile(const std::string& filename);
     virtual MRVer* getMRVERFromString(const std::string& input);
 
+    /// Binary SVFG files, written unless -write-svfg-text is set; readFile
+    /// recognises either format. Like the text format, a file holds the
+    /// address-taken part of the SVFG: memory SSA nodes with their versions
+    /// and the indirect edges, whose points-to labels are stored once per
+    /// distinct set. The file is mapped and its records are read in place.
+    //@{
+    static bool isBinarySVFGFile(const std::string& filename);
+    virtual void writeBinaryToFile(const std::string& filename);
+    virtual bool readBinaryFile(const std::string& filename);
+    //@}
+
 protected:
     /// Add indirect def-use edges of a memory region between two statements,
     //@{
@@ -4,6 +4,7 @@
 
 #include "MSSA/MemSSA.h"
 #include "Graphs/VFGEdge.h"
+#include "MemoryModel/PersistentPointsToCache.h"
 
 namespace SVF
 {
@@ -16,25 +17,40 @@ class IndirectSVFGEdge : public VFGEdge
 
 public:
     typedef Set<const MRVer*> MRVerSet;
+    /// Points-to labels of all indirect edges, each distinct set stored once
+    typedef PersistentPointsToCache<NodeBS> LabelCache;
 private:
-    NodeBS cpts;
+    PointsToID cpts;
 public:
     /// Constructor
-    IndirectSVFGEdge(VFGNode* s, VFGNode* d, GEdgeFlag k): VFGEdge(s,d,k)
+    IndirectSVFGEdge(VFGNode* s, VFGNode* d, GEdgeFlag k): VFGEdge(s,d,k), cpts(LabelCache::emptyPointsToId())
     {
     }
     /// Handle memory region
     //@{
     inline bool addPointsTo(const NodeBS& c)
     {
-        return (cpts |= c);
+        LabelCache& labels = getLabelCache();
+        PointsToID newCPts = labels.unionPts(cpts, labels.emplacePts(c));
+        if (newCPts == cpts)
+            return false;
+        cpts = newCPts;
+        return true;
     }
     inline const NodeBS& getPointsTo() const
+    {
+        return getLabelCache().getActualPts(cpts);
+    }
+    /// Edges with the same label share its ID
+    inline PointsToID getPointsToId() const
     {
         return cpts;
     }
     //@}
 
+    /// Shared by all SVFGs and reset when the last one is destroyed
+    static LabelCache& getLabelCache();
+
     /// Methods for support type inquiry through isa, cast, and dyn_cast:
     //@{
     static inline bool classof(const IndirectSVFGEdge *)
@@ -128,6 +128,27 @@ protected:
     //@}
 
 private:
+    /// An edge replacing an actual-in/formal-out and one of its out edges
+    struct BypassEdge
+    {
+        NodeID dst;
+        bool isCall;
+        CallSiteID csId;
+        NodeBS cpts;
+    };
+    /// The def site of an actual-in/formal-out and the edges bypassing it
+    struct AInFOutBypass
+    {
+        SVFGNode* node;
+        SVFGNode* def;
+        std::vector<BypassEdge> edges;
+    };
+
+    /// Compute how an actual-in/formal-out is bypassed, without changing the graph
+    void collectAInFOutBypass(AInFOutBypass& bypass) const;
+    /// Record the def site, add the bypass edges and remove the node's edges
+    void applyAInFOutBypass(const AInFOutBypass& bypass);
+
     void parseSelfCycleHandleOption();
 
     /// Add inter-procedural value flow edge
@@ -158,6 +179,10 @@ private:
     /// Record def sites of actual-in/formal-out and connect from those def-sites
     /// to formal-in/actual-out directly if they exist.
     void retargetEdgesOfAInFOut(SVFGNode* node);
+    /// Retarget the edges of all actual-in/formal-out nodes, with
+    /// -svfgopt-threads threads. The edges are computed concurrently, one
+    /// function at a time, and added in the order of the functions.
+    void retargetEdgesOfAInFOutInParallel(const std::vector<SVFGNode*>& nodes);
     /// Connect actual-out/formal-in's predecessors to their successors directly.
     void retargetEdgesOfAOutFIn(SVFGNode* node);
     //@}
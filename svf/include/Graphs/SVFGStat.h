@@ -123,6 +123,19 @@ public:
         svfgOptTimeEnd = PTAStat::getClk(true);
     }
 
+    void setOptRemoved(u32_t nodes, u32_t edges)
+    {
+        optRemovedNodes = nodes;
+        optRemovedEdges = edges;
+    }
+
+    /// Wall time of a parallel optimisation phase, and the time its workers spent
+    void addOptBypassTime(double wallTime, double workerTime)
+    {
+        optBypassTime += wallTime;
+        optBypassWorkerTime += workerTime;
+    }
+
 private:
     void clear();
 
@@ -195,6 +208,11 @@ private:
     double svfgOptTimeStart;
     double svfgOptTimeEnd;
 
+    u32_t optRemovedNodes;
+    u32_t optRemovedEdges;
+    double optBypassTime;
+    double optBypassWorkerTime;
+
     SVFGNodeSet forwardSlice;
     SVFGNodeSet backwardSlice;
     SVFGNodeSet	sources;
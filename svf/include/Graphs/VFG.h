@@ -405,7 +405,7 @@ protected:
     void addVFGNodes();
 
     /// Get PAGEdge set
-    virtual inline SVFStmt::SVFStmtSetTy& getPAGEdgeSet(SVFStmt::PEDGEK kind)
+    virtual inline SVFStmt::SVFStmtTableTy& getPAGEdgeSet(SVFStmt::PEDGEK kind)
     {
         if (isPtrOnlySVFG())
             return pag->getPTASVFStmtSet(kind);
@@ -4,6 +4,8 @@
 
 #include "MSSA/MemRegion.h"
 
+#include <atomic>
+
 namespace SVF
 {
 
@@ -19,7 +21,7 @@ public:
     typedef MSSADEF MSSADef;
 private:
     /// ver ID 0 is reserved
-    static u32_t totalVERNum;
+    static std::atomic<u32_t> totalVERNum;
     const MemRegion* mr;
     MRVERSION version;
     MRVERID vid;
@@ -54,6 +56,24 @@ public:
     {
         return vid;
     }
+
+    /// Versions created concurrently draw their IDs in no particular order.
+    /// Rewinding the counter and renumbering them in creation order of a
+    /// sequential run makes the IDs deterministic again.
+    //@{
+    static inline u32_t getTotalVERNum()
+    {
+        return totalVERNum;
+    }
+    static inline void setTotalVERNum(u32_t num)
+    {
+        totalVERNum = num;
+    }
+    inline void renumber()
+    {
+        vid = totalVERNum++;
+    }
+    //@}
 };
 
 
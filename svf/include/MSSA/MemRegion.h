@@ -8,6 +8,8 @@
 #include "SVFIR/SVFIR.h"
 #include "Util/WorkList.h"
 
+#include <atomic>
+#include <memory>
 #include <set>
 
 namespace SVF
@@ -27,13 +29,22 @@ public:
     typedef bool Condition;
 private:
     /// region ID 0 is reserved
-    static u32_t totalMRNum;
+    static std::atomic<u32_t> totalMRNum;
     MRID rid;
-    const NodeBS cptsSet;
+    /// Either ownedCPts or a set shared with others
+    const NodeBS* cptsSet;
+    std::unique_ptr<const NodeBS> ownedCPts;
 
 public:
-    /// Constructor
+    /// Constructor, the region keeps its own copy of cp
     MemRegion(const NodeBS& cp) :
+        rid(++totalMRNum), cptsSet(nullptr), ownedCPts(new NodeBS(cp))
+    {
+        cptsSet = ownedCPts.get();
+    }
+    /// Constructor, the region shares cp (e.g., interned by MRGenerator),
+    /// which must outlive it
+    explicit MemRegion(const NodeBS* cp) :
         rid(++totalMRNum), cptsSet(cp)
     {
     }
@@ -50,7 +61,7 @@ public:
     /// Return points-to
     inline const NodeBS &getPointsTo() const
     {
-        return cptsSet;
+        return *cptsSet;
     }
     /// Operator== overriding
     inline bool operator==(const MemRegion* rhs) const
@@ -62,7 +73,7 @@ public:
     {
         std::string str;
         str += "pts{";
-        for (NodeBS::iterator ii = cptsSet.begin(), ie = cptsSet.end();
+        for (NodeBS::iterator ii = cptsSet->begin(), ie = cptsSet->end();
                 ii != ie; ii++)
         {
             char int2str[16];
@@ -89,7 +100,7 @@ public:
     /// Return memory object number inside a region
     inline u32_t getRegionSize() const
     {
-        return cptsSet.count();
+        return cptsSet->count();
     }
 };
 
@@ -125,8 +136,8 @@ public:
 
     /// Map loads/stores/callsites to their cpts set
     //@{
-    typedef Map<const LoadStmt*, NodeBS> LoadsToPointsToMap;
-    typedef Map<const StoreStmt*, NodeBS> StoresToPointsToMap;
+    typedef Map<const LoadStmt*, const NodeBS*> LoadsToPointsToMap;
+    typedef Map<const StoreStmt*, const NodeBS*> StoresToPointsToMap;
     typedef Map<const CallICFGNode*, NodeBS> CallSiteToPointsToMap;
     //@}
 
@@ -207,6 +218,10 @@ private:
     /// Map a pointer to its cached points-to chain;
     NodeToPTSSMap cachedPtsChainMap;
 
+    /// Points-to sets of regions, loads and stores, hash-consed so that
+    /// equal sets share one copy
+    Set<NodeBS> internedPts;
+
     /// All global variable SVFIR node ids
     NodeBS allGlobals;
 
@@ -236,6 +251,20 @@ private:
     /// Get all the objects in callee's modref escaped via global objects (the chain pts of globals)
     void getEscapObjviaGlobals(NodeBS& globs, const NodeBS& pts);
 
+    /// Conditional points-to of the loads/stores of a function, with the
+    /// non-local objects they use and define
+    struct FunCPts
+    {
+        std::vector<std::pair<const StoreStmt*, NodeBS>> stores;
+        std::vector<std::pair<const LoadStmt*, NodeBS>> loads;
+        PointsToList cptsList;
+        NodeBS refs;
+        NodeBS mods;
+    };
+    /// Collect the conditional points-to of fun. Only reads the statement
+    /// lists and points-to sets, so functions can be processed in parallel.
+    void collectFunCPts(const FunObjVar& fun, FunCPts& funCPts);
+
 
 protected:
     MRGenerator(BVDataPTAImpl* p, bool ptrOnly);
@@ -248,6 +277,12 @@ protected:
     /// Generate a memory region and put in into functions which use it
     void createMR(const FunObjVar* fun, const NodeBS& cpts);
 
+    /// Return the single, shared copy of pts
+    inline const NodeBS* internPts(const NodeBS& pts)
+    {
+        return &*internedPts.insert(pts).first;
+    }
+
     /// Collect all global variables for later escape analysis
     void collectGlobals();
 
@@ -306,13 +341,13 @@ protected:
     //@{
     inline void addCPtsToStore(NodeBS& cpts, const StoreStmt *st, const FunObjVar* fun)
     {
-        storesToPointsToMap[st] = cpts;
+        storesToPointsToMap[st] = internPts(cpts);
         funToPointsToMap[fun].insert(cpts);
         addModSideEffectOfFunction(fun,cpts);
     }
     inline void addCPtsToLoad(NodeBS& cpts, const LoadStmt *ld, const FunObjVar* fun)
     {
-        loadsToPointsToMap[ld] = cpts;
+        loadsToPointsToMap[ld] = internPts(cpts);
         funToPointsToMap[fun].insert(cpts);
         addRefSideEffectOfFunction(fun,cpts);
     }
@@ -388,6 +423,12 @@ public:
         return memRegSet.size();
     }
 
+    /// Number of distinct points-to sets shared by regions, loads and stores
+    inline u32_t getNumInternedPts() const
+    {
+        return internedPts.size();
+    }
+
     /// Destructor
     virtual ~MRGenerator()
     {
@@ -123,6 +123,28 @@ private:
 
     std::vector<std::unique_ptr<MRVer>> usedMRVers;
 
+    /// Parallel construction (see buildMemSSA(const FunList&))
+    //@{
+    /// The MemSSA this one builds functions for, or nullptr if it is not a worker
+    MemSSA* parent;
+    /// Range of usedMRVers created for each function built by a worker
+    Map<const FunObjVar*, std::pair<size_t, size_t>> funToMRVerRange;
+    /// Time a worker spent in each phase, kept apart from the static timers
+    double workerMUCHITime;
+    double workerPHITime;
+    double workerRenameTime;
+    /// Functions a worker stole from other workers
+    u32_t numBuildSteals;
+
+    /// Create a worker sharing the pointer analysis and memory regions of p
+    MemSSA(MemSSA* p);
+    /// Look up every region set a worker will ask mrGen for when building fun,
+    /// so that the lookups of workers never insert into the maps of mrGen
+    void prepareMRLookups(const FunObjVar& fun);
+    /// Move the mus/chis/phis built by a worker into this MemSSA
+    void mergeWorker(MemSSA& worker);
+    //@}
+
     /// Release the memory
     void destroy();
 
@@ -281,9 +303,24 @@ public:
     {
         return mrGen;
     }
+    typedef std::vector<const FunObjVar*> FunList;
+
     /// We start from here
     virtual void buildMemSSA(const FunObjVar& fun);
 
+    /// Build memory SSA for every function of funs using Options::MSSAThreads()
+    /// threads. Once the regions are generated, functions can be built
+    /// independently: each worker has its own version counters and stacks, and
+    /// the results are merged in the order of funs, numbering versions exactly
+    /// as building the functions one by one would.
+    void buildMemSSA(const FunList& funs);
+
+    /// Number of functions stolen by idle threads in buildMemSSA(const FunList&)
+    inline u32_t getNumBuildSteals() const
+    {
+        return numBuildSteals;
+    }
+
     /// Perform statistics
     void performStat();
 
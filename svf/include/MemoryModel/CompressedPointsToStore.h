@@ -0,0 +1,149 @@
+
+#ifndef COMPRESSEDPOINTSTOSTORE_H_
+#define COMPRESSEDPOINTSTOSTORE_H_
+
+#include "Util/GeneralType.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace SVF
+{
+
+/*!
+ * Points-to sets moved out of the way of a solver in compressed form.
+ * The elements of a set are sorted and delta encoded, each delta being
+ * written as a LEB128 varint, so dense sets take about a byte per element.
+ */
+template <typename Key, typename Data, typename DataSet>
+class CompressedPointsToStore
+{
+public:
+    CompressedPointsToStore() : numBytes(0) { }
+
+    CompressedPointsToStore(const CompressedPointsToStore&) = delete;
+    void operator=(const CompressedPointsToStore&) = delete;
+
+    /// Compress pts as the set of key, replacing any set stored for it.
+    /// Return the number of bytes it takes.
+    size_t store(const Key& key, const DataSet& pts)
+    {
+        std::vector<Data> elements;
+        elements.reserve(pts.count());
+        for (const Data& e : pts)
+            elements.push_back(e);
+        std::sort(elements.begin(), elements.end());
+
+        std::vector<u8_t> encoded;
+        encoded.reserve(elements.size() + 4);
+        writeVarint(encoded, elements.size());
+        Data prev = 0;
+        for (const Data& e : elements)
+        {
+            writeVarint(encoded, e - prev);
+            prev = e;
+        }
+
+        CompressedSet& set = sets[key];
+        numBytes -= set.size;
+        set.size = encoded.size();
+        set.bytes.reset(new u8_t[set.size]);
+        std::copy(encoded.begin(), encoded.end(), set.bytes.get());
+        numBytes += set.size;
+        return set.size;
+    }
+
+    /// Decompress the set of key into pts and drop it from the store.
+    /// Return false if no set is stored for key.
+    bool restore(const Key& key, DataSet& pts)
+    {
+        typename Map<Key, CompressedSet>::iterator it = sets.find(key);
+        if (it == sets.end())
+            return false;
+
+        const u8_t* cur = it->second.bytes.get();
+        const size_t num = readVarint(cur);
+        Data e = 0;
+        for (size_t i = 0; i < num; ++i)
+        {
+            e += readVarint(cur);
+            pts.set(e);
+        }
+
+        numBytes -= it->second.size;
+        sets.erase(it);
+        return true;
+    }
+
+    inline bool contains(const Key& key) const
+    {
+        return sets.find(key) != sets.end();
+    }
+
+    /// Keys of all stored sets
+    inline void getKeys(std::vector<Key>& keys) const
+    {
+        for (const typename Map<Key, CompressedSet>::value_type& ks : sets)
+            keys.push_back(ks.first);
+    }
+
+    inline bool empty() const
+    {
+        return sets.empty();
+    }
+
+    inline size_t size() const
+    {
+        return sets.size();
+    }
+
+    /// Bytes taken by the compressed sets
+    inline size_t getNumBytes() const
+    {
+        return numBytes;
+    }
+
+    inline void clear()
+    {
+        sets.clear();
+        numBytes = 0;
+    }
+
+private:
+    struct CompressedSet
+    {
+        std::unique_ptr<u8_t[]> bytes;
+        size_t size = 0;
+    };
+
+    static inline void writeVarint(std::vector<u8_t>& out, u64_t v)
+    {
+        while (v >= 0x80)
+        {
+            out.push_back(static_cast<u8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<u8_t>(v));
+    }
+
+    static inline u64_t readVarint(const u8_t*& cur)
+    {
+        u64_t v = 0;
+        unsigned shift = 0;
+        while (*cur & 0x80)
+        {
+            v |= static_cast<u64_t>(*cur++ & 0x7f) << shift;
+            shift += 7;
+        }
+        v |= static_cast<u64_t>(*cur++) << shift;
+        return v;
+    }
+
+    Map<Key, CompressedSet> sets;
+    size_t numBytes;
+};
+
+} // End namespace SVF
+
+#endif /* COMPRESSEDPOINTSTOSTORE_H_ */
@@ -5,8 +5,13 @@
 #include<fstream>
 
 #include "MemoryModel/AbstractPointsToDS.h"
+#include "MemoryModel/CompressedPointsToStore.h"
 #include "SVFIR/SVFType.h"
 #include "Util/SVFUtil.h"
+#include "Util/WorkStealing.h"
+
+#include <chrono>
+#include <type_traits>
 
 namespace SVF
 {
@@ -29,14 +34,32 @@ public:
     typedef typename PtsMap::const_iterator PtsMapConstIter;
     typedef typename DataSet::iterator iterator;
 
+    /// Statistics of spilling cold points-to sets
+    struct SpillStats
+    {
+        /// Points-to set accesses while spilling is enabled
+        u64_t numAccesses = 0;
+        /// Accesses which had to decompress a spilled set
+        u64_t numRestores = 0;
+        /// Sets spilled, bytes they took, and the elements in them
+        u64_t numSpilled = 0;
+        u64_t numSpilledBytes = 0;
+        u64_t numSpilledElements = 0;
+        /// Most bytes held by spilled sets at once
+        u64_t peakSpilledBytes = 0;
+        /// Seconds spent decompressing
+        double restoreTime = 0;
+    };
+
     /// Constructor
-    MutablePTData(bool reversePT = true, PTDataTy ty = PTDataTy::MutBase) : BasePTData(reversePT, ty) { }
+    MutablePTData(bool reversePT = true, PTDataTy ty = PTDataTy::MutBase) : BasePTData(reversePT, ty), spillEnabled(false) { }
 
     virtual ~MutablePTData() { }
 
     /// Return Points-to map
     virtual inline const PtsMap& getPtsMap() const
     {
+        assert(spilledPts.empty() && "MutablePTData::getPtsMap: restore spilled points-to sets first!");
         return ptsMap;
     }
 
@@ -44,11 +67,13 @@ public:
     {
         ptsMap.clear();
         revPtsMap.clear();
+        spilledPts.clear();
+        hotKeys.clear();
     }
 
     virtual inline const DataSet& getPts(const Key& var) override
     {
-        return ptsMap[var];
+        return accessPts(var);
     }
 
     virtual inline const KeySet& getRevPts(const Data& datum) override
@@ -60,46 +85,51 @@ public:
     virtual inline bool addPts(const Key &dstKey, const Data& element) override
     {
         addSingleRevPts(revPtsMap[element], dstKey);
-        return addPts(ptsMap[dstKey], element);
+        return addPts(accessPts(dstKey), element);
     }
 
     virtual inline bool unionPts(const Key& dstKey, const Key& srcKey) override
     {
-        addRevPts(ptsMap[srcKey], dstKey);
-        return unionPts(ptsMap[dstKey], getPts(srcKey));
+        const DataSet& srcPts = accessPts(srcKey);
+        DataSet& dstPts = accessPts(dstKey);
+        addRevPts(srcPts, dstKey);
+        return unionPts(dstPts, srcPts);
     }
 
     virtual inline bool unionPts(const Key& dstKey, const DataSet& srcDataSet) override
     {
         addRevPts(srcDataSet,dstKey);
-        return unionPts(ptsMap[dstKey], srcDataSet);
+        return unionPts(accessPts(dstKey), srcDataSet);
     }
 
     virtual inline void dumpPTData() override
     {
+        restoreAllPts();
         dumpPts(ptsMap);
     }
 
     virtual void clearPts(const Key& var, const Data& element) override
     {
         clearSingleRevPts(revPtsMap[element], var);
-        ptsMap[var].reset(element);
+        accessPts(var).reset(element);
     }
 
     virtual void clearFullPts(const Key& var) override
     {
-        DataSet &pts = ptsMap[var];
+        DataSet &pts = accessPts(var);
         clearRevPts(pts, var);
         pts.clear();
     }
 
     virtual void remapAllPts(void) override
     {
+        restoreAllPts();
         for (typename PtsMap::value_type &ppt : ptsMap) ppt.second.checkAndRemap();
     }
 
     virtual inline Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
     {
+        assert(spilledPts.empty() && "MutablePTData::getAllPts: restore spilled points-to sets first!");
         Map<DataSet, unsigned> allPts;
         for (typename PtsMap::value_type ppt : ptsMap)
         {
@@ -110,6 +140,73 @@ public:
         return allPts;
     }
 
+    /// Spilling of cold points-to sets
+    ///@{
+    /// Track which points-to sets are accessed so that those which are not can
+    /// be spilled. Spilled sets are decompressed again when next accessed.
+    inline void enableSpill()
+    {
+        static_assert(std::is_integral<Data>::value, "MutablePTData::enableSpill: can only compress integral elements!");
+        spillEnabled = true;
+    }
+    inline bool isSpillEnabled() const
+    {
+        return spillEnabled;
+    }
+    /// Compress every non-empty points-to set which has not been accessed
+    /// since the previous call. Return the number of sets spilled.
+    u32_t spillColdPts()
+    {
+        assert(spillEnabled && "MutablePTData::spillColdPts: spilling not enabled!");
+        std::vector<Key> cold;
+        for (const typename PtsMap::value_type& ppt : ptsMap)
+        {
+            if (!ppt.second.empty() && hotKeys.find(ppt.first) == hotKeys.end())
+                cold.push_back(ppt.first);
+        }
+        hotKeys.clear();
+
+        for (const Key& var : cold)
+        {
+            PtsMapIter it = ptsMap.find(var);
+            spillStats.numSpilledBytes += spilledPts.store(var, it->second);
+            spillStats.numSpilledElements += it->second.count();
+            ptsMap.erase(it);
+        }
+        spillStats.numSpilled += cold.size();
+        if (spilledPts.getNumBytes() > spillStats.peakSpilledBytes)
+            spillStats.peakSpilledBytes = spilledPts.getNumBytes();
+        return cold.size();
+    }
+    /// Start a new period for spillColdPts without spilling
+    inline void resetAccessedPts()
+    {
+        hotKeys.clear();
+    }
+    /// Decompress all spilled points-to sets
+    void restoreAllPts()
+    {
+        if constexpr (std::is_integral<Data>::value)
+        {
+            if (spilledPts.empty())
+                return;
+            std::vector<Key> keys;
+            spilledPts.getKeys(keys);
+            for (const Key& var : keys)
+                spilledPts.restore(var, ptsMap[var]);
+        }
+    }
+    /// Bytes currently held by spilled sets
+    inline size_t getSpilledBytes() const
+    {
+        return spilledPts.getNumBytes();
+    }
+    inline const SpillStats& getSpillStats() const
+    {
+        return spillStats;
+    }
+    ///@}
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const MutablePTData<Key, KeySet, Data, DataSet> *)
@@ -142,6 +239,37 @@ protected:
     }
 
 private:
+    /// The points-to set of var, decompressed first if it was spilled.
+    inline DataSet& accessPts(const Key& var)
+    {
+        if constexpr (std::is_integral<Data>::value)
+        {
+            if (spillEnabled)
+                return accessSpillablePts(var);
+        }
+        return ptsMap[var];
+    }
+
+    DataSet& accessSpillablePts(const Key& var)
+    {
+        ++spillStats.numAccesses;
+        hotKeys.insert(var);
+        PtsMapIter it = ptsMap.find(var);
+        if (it != ptsMap.end())
+            return it->second;
+
+        DataSet& pts = ptsMap[var];
+        if (spilledPts.contains(var))
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            spilledPts.restore(var, pts);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            spillStats.restoreTime += elapsed.count();
+            ++spillStats.numRestores;
+        }
+        return pts;
+    }
+
     /// Internal union/add points-to helper methods.
     ///@{
     inline bool unionPts(DataSet& dstDataSet, const DataSet& srcDataSet)
@@ -186,6 +314,13 @@ private:
 protected:
     PtsMap ptsMap;
     RevPtsMap revPtsMap;
+
+private:
+    bool spillEnabled;
+    /// Keys whose points-to set was accessed since the last spill
+    Set<Key> hotKeys;
+    CompressedPointsToStore<Key, Data, DataSet> spilledPts;
+    SpillStats spillStats;
 };
 
 /// DiffPTData implemented with points-to sets which are updated continuously.
@@ -198,9 +333,10 @@ public:
     typedef typename BasePTData::PTDataTy PTDataTy;
 
     typedef typename MutablePTData<Key, KeySet, Data, DataSet>::PtsMap PtsMap;
+    typedef typename MutablePTData<Key, KeySet, Data, DataSet>::SpillStats SpillStats;
 
     /// Constructor
-    explicit MutableDiffPTData(bool reversePT = true, PTDataTy ty = PTDataTy::Diff) : BaseDiffPTData(reversePT, ty), mutPTData(reversePT) { }
+    explicit MutableDiffPTData(bool reversePT = true, PTDataTy ty = PTDataTy::MutDiff) : BaseDiffPTData(reversePT, ty), mutPTData(reversePT) { }
 
     ~MutableDiffPTData() override = default;
 
@@ -296,6 +432,38 @@ public:
         return mutPTData.getAllPts(liveOnly);
     }
 
+    /// Spilling of cold (full) points-to sets, see MutablePTData
+    ///@{
+    inline void enableSpill()
+    {
+        mutPTData.enableSpill();
+    }
+    inline bool isSpillEnabled() const
+    {
+        return mutPTData.isSpillEnabled();
+    }
+    inline u32_t spillColdPts()
+    {
+        return mutPTData.spillColdPts();
+    }
+    inline void resetAccessedPts()
+    {
+        mutPTData.resetAccessedPts();
+    }
+    inline void restoreAllPts()
+    {
+        mutPTData.restoreAllPts();
+    }
+    inline size_t getSpilledBytes() const
+    {
+        return mutPTData.getSpilledBytes();
+    }
+    inline const SpillStats& getSpillStats() const
+    {
+        return mutPTData.getSpillStats();
+    }
+    ///@}
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const MutableDiffPTData<Key, KeySet, Data, DataSet> *)
@@ -342,7 +510,7 @@ public:
     typedef typename DFPtsMap::const_iterator DFPtsMapconstIter;
 
     /// Constructor
-    MutableDFPTData(bool reversePT = true, PTDataTy ty = BaseDFPTData::MutDataFlow) : BaseDFPTData(reversePT, ty), mutPTData(reversePT) { }
+    MutableDFPTData(bool reversePT = true, PTDataTy ty = BaseDFPTData::MutDataFlow) : BaseDFPTData(reversePT, ty), mutPTData(reversePT), concurrent(false) { }
 
     virtual ~MutableDFPTData() { }
 
@@ -397,16 +565,45 @@ public:
 
     virtual inline DataSet& getDFInPtsSet(LocID loc, const Key& var) override
     {
+        if (concurrent)
+            return getConcurrentSet(dfInPtsMap, loc, var);
         PtsMap& inSet = dfInPtsMap[loc];
         return inSet[var];
     }
 
     virtual inline DataSet& getDFOutPtsSet(LocID loc, const Key& var) override
     {
+        if (concurrent)
+            return getConcurrentSet(dfOutPtsMap, loc, var);
         PtsMap& outSet = dfOutPtsMap[loc];
         return outSet[var];
     }
 
+    /// Concurrent access
+    //@{
+    /// Create the IN and OUT maps of locations which will be accessed while concurrent.
+    virtual void prepareLocs(const std::vector<LocID>& inLocs, const std::vector<LocID>& outLocs)
+    {
+        for (LocID loc : inLocs)
+            dfInPtsMap[loc];
+        for (LocID loc : outLocs)
+            dfOutPtsMap[loc];
+    }
+    /// While concurrent, IN/OUT sets of prepared locations may be updated from
+    /// several threads as long as each variable is only handled by one thread.
+    /// The per-location maps are guarded by lock stripes; sets are not.
+    inline void setConcurrent(bool c)
+    {
+        if (c && locStripes == nullptr)
+            locStripes = std::make_unique<LockStripes>(1024, dfInPtsMap.size() + dfOutPtsMap.size());
+        concurrent = c;
+    }
+    inline bool isConcurrent() const
+    {
+        return concurrent;
+    }
+    //@}
+
     /// Get internal flow-sensitive data structures.
     ///@{
     inline const PtsMap& getDFInPtsMap(LocID loc)
@@ -634,6 +831,14 @@ public:
     ///@}
 
 protected:
+    /// Lock of loc's maps, held only while concurrent
+    inline std::unique_lock<std::mutex> lockLocIfConcurrent(LocID loc) const
+    {
+        if (!concurrent)
+            return std::unique_lock<std::mutex>();
+        return std::unique_lock<std::mutex>(locStripes->get(loc));
+    }
+
     /// Data-flow IN set.
     DFPtsMap dfInPtsMap;
     /// Data-flow OUT set.
@@ -641,6 +846,18 @@ protected:
     /// Backing to implement the basic PTData methods which are not overridden.
     /// This allows us to avoid multiple-inheritance.
     MutablePTData<Key, KeySet, Data, DataSet> mutPTData;
+
+private:
+    inline DataSet& getConcurrentSet(DFPtsMap& dfPtsMap, LocID loc, const Key& var)
+    {
+        DFPtsMapIter it = dfPtsMap.find(loc);
+        assert(it != dfPtsMap.end() && "location not prepared for concurrent access!");
+        std::unique_lock<std::mutex> lock = lockLocIfConcurrent(loc);
+        return it->second[var];
+    }
+
+    bool concurrent;
+    std::unique_ptr<LockStripes> locStripes;
 };
 
 /// Incremental version of the mutable data-flow points-to data structure.
@@ -670,6 +887,15 @@ public:
 
     virtual ~MutableIncDFPTData() { }
 
+    virtual void prepareLocs(const std::vector<LocID>& inLocs, const std::vector<LocID>& outLocs) override
+    {
+        BaseMutDFPTData::prepareLocs(inLocs, outLocs);
+        for (LocID loc : inLocs)
+            inUpdatedVarMap[loc];
+        for (LocID loc : outLocs)
+            outUpdatedVarMap[loc];
+    }
+
     virtual inline bool updateDFInFromIn(LocID srcLoc, const Key& srcVar, LocID dstLoc, const Key& dstVar) override
     {
         if(varHasNewDFInPts(srcLoc, srcVar) &&
@@ -797,12 +1023,21 @@ private:
     /// Add var into loc's IN updated set. Called when var's pts in loc's IN set changed
     inline void setVarDFInSetUpdated(LocID loc,const Key& var)
     {
+        if (this->isConcurrent())
+        {
+            UpdatedVarMapIter it = inUpdatedVarMap.find(loc);
+            assert(it != inUpdatedVarMap.end() && "location not prepared for concurrent access!");
+            std::unique_lock<std::mutex> lock = this->lockLocIfConcurrent(loc);
+            it->second.set(var);
+            return;
+        }
         inUpdatedVarMap[loc].set(var);
     }
     /// Remove var from loc's IN updated set
     inline void removeVarFromDFInUpdatedSet(LocID loc,const Key& var)
     {
         UpdatedVarMapIter it = inUpdatedVarMap.find(loc);
+        std::unique_lock<std::mutex> lock = this->lockLocIfConcurrent(loc);
         if (it != inUpdatedVarMap.end())
             it->second.reset(var);
     }
@@ -810,6 +1045,7 @@ private:
     inline bool varHasNewDFInPts(LocID loc,const Key& var)
     {
         UpdatedVarMapIter it = inUpdatedVarMap.find(loc);
+        std::unique_lock<std::mutex> lock = this->lockLocIfConcurrent(loc);
         if (it != inUpdatedVarMap.end())
             return it->second.test(var);
         return false;
@@ -826,12 +1062,21 @@ private:
     /// Add var into loc's OUT updated set. Called when var's pts in loc's OUT set changed
     inline void setVarDFOutSetUpdated(LocID loc,const Key& var)
     {
+        if (this->isConcurrent())
+        {
+            UpdatedVarMapIter it = outUpdatedVarMap.find(loc);
+            assert(it != outUpdatedVarMap.end() && "location not prepared for concurrent access!");
+            std::unique_lock<std::mutex> lock = this->lockLocIfConcurrent(loc);
+            it->second.set(var);
+            return;
+        }
         outUpdatedVarMap[loc].set(var);
     }
     /// Remove var from loc's OUT updated set
     inline void removeVarFromDFOutUpdatedSet(LocID loc,const Key& var)
     {
         UpdatedVarMapIter it = outUpdatedVarMap.find(loc);
+        std::unique_lock<std::mutex> lock = this->lockLocIfConcurrent(loc);
         if (it != outUpdatedVarMap.end())
             it->second.reset(var);
     }
@@ -839,6 +1084,7 @@ private:
     inline bool varHasNewDFOutPts(LocID loc,const Key& var)
     {
         UpdatedVarMapIter it = outUpdatedVarMap.find(loc);
+        std::unique_lock<std::mutex> lock = this->lockLocIfConcurrent(loc);
         if (it != outUpdatedVarMap.end())
             return it->second.test(var);
         return false;
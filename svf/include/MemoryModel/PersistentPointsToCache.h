@@ -6,6 +6,7 @@
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <mutex>
 
 #include "SVFIR/SVFType.h"
 
@@ -16,6 +17,8 @@ namespace SVF
 /// PointsToDS and PointsToDFDS. Hides points-to sets and union operations from users and hands
 /// out PointsToIDs.
 /// Points-to sets are interned, and union operations are lazy and hash-consed.
+/// The cache is not thread-safe unless setConcurrent(true) is called, after which
+/// every operation is serialised except the actual set operations.
 template <typename Data>
 class PersistentPointsToCache
 {
@@ -31,7 +34,7 @@ public:
     };
 
 public:
-    PersistentPointsToCache(void) : idCounter(1)
+    PersistentPointsToCache(void) : idCounter(1), concurrent(false)
     {
         idToPts.push_back(std::make_unique<Data>());
         ptsToId[Data()] = emptyPointsToId();
@@ -74,10 +77,30 @@ public:
         for (PointsToID i = 0; i < idToPts.size(); ++i) ptsToId[*idToPts[i]] = i;
     }
 
+    /// Whether the cache may be used by multiple threads at once.
+    void setConcurrent(bool c)
+    {
+        concurrent = c;
+    }
+
+    bool isConcurrent(void) const
+    {
+        return concurrent;
+    }
+
+    /// Number of distinct points-to sets stored, including the empty set.
+    size_t getNumStoredPts(void) const
+    {
+        std::unique_lock<std::mutex> lock = lockIfConcurrent();
+        return idToPts.size();
+    }
+
     /// If pts is not in the PersistentPointsToCache, inserts it, assigns an ID, and returns
     /// that ID. If it is, then the ID is returned.
     PointsToID emplacePts(const Data &pts)
     {
+        std::unique_lock<std::mutex> lock = lockIfConcurrent();
+
         // Is it already in the cache?
         typename PTSToIDMap::const_iterator foundId = ptsToId.find(pts);
         if (foundId != ptsToId.end()) return foundId->second;
@@ -93,6 +116,8 @@ public:
     /// Returns the points-to set which id represents. id must be stored in the cache.
     const Data &getActualPts(PointsToID id) const
     {
+        std::unique_lock<std::mutex> lock = lockIfConcurrent();
+
         // Check if the points-to set for ID has already been stored.
         assert(idToPts.size() > id && "PPTC::getActualPts: points-to set not stored!");
         return *idToPts.at(id);
@@ -106,6 +131,8 @@ public:
             return lhs | rhs;
         };
 
+        std::unique_lock<std::mutex> lock = lockIfConcurrent();
+
         ++totalUnions;
 
         // Order operands so we don't perform x U y and y U x separately.
@@ -127,7 +154,7 @@ public:
         }
 
         bool opPerformed = false;
-        PointsToID result = opPts(lhs, rhs, unionOp, unionCache, true, opPerformed);
+        PointsToID result = opPts(lhs, rhs, unionOp, unionCache, true, opPerformed, lock);
 
         if (opPerformed)
         {
@@ -165,6 +192,8 @@ public:
             return lhs - rhs;
         };
 
+        std::unique_lock<std::mutex> lock = lockIfConcurrent();
+
         ++totalComplements;
 
         // Property cases.
@@ -190,7 +219,7 @@ public:
         }
 
         bool opPerformed = false;
-        const PointsToID result = opPts(lhs, rhs, complementOp, complementCache, false, opPerformed);
+        const PointsToID result = opPts(lhs, rhs, complementOp, complementCache, false, opPerformed, lock);
 
         if (opPerformed)
         {
@@ -228,6 +257,8 @@ public:
             return lhs & rhs;
         };
 
+        std::unique_lock<std::mutex> lock = lockIfConcurrent();
+
         ++totalIntersections;
 
         // Order operands so we don't perform x U y and y U x separately.
@@ -249,7 +280,7 @@ public:
         }
 
         bool opPerformed = false;
-        const PointsToID result = opPts(lhs, rhs, intersectionOp, intersectionCache, true, opPerformed);
+        const PointsToID result = opPts(lhs, rhs, intersectionOp, intersectionCache, true, opPerformed, lock);
         if (opPerformed)
         {
             ++uniqueIntersections;
@@ -350,8 +381,9 @@ private:
     /// Performs dataOp on lhs and rhs, checking the opCache first and updating it afterwards.
     /// commutative indicates whether the operation in question is commutative or not.
     /// opPerformed is set to true if the operation was *not* cached and thus performed, false otherwise.
+    /// lock is the caller's hold on the cache, if any; it is released while dataOp runs.
     inline PointsToID opPts(PointsToID lhs, PointsToID rhs, const DataOp &dataOp, OpCache &opCache,
-                            bool commutative, bool &opPerformed)
+                            bool commutative, bool &opPerformed, std::unique_lock<std::mutex> &lock)
     {
         std::pair<PointsToID, PointsToID> operands;
         // If we're commutative, we want to always perform the same operation: x op y.
@@ -365,10 +397,13 @@ private:
 
         opPerformed = true;
 
-        const Data &lhsPts = getActualPts(lhs);
-        const Data &rhsPts = getActualPts(rhs);
+        // Interned points-to sets never move, so these stay valid once the lock is released.
+        const Data &lhsPts = *idToPts.at(lhs);
+        const Data &rhsPts = *idToPts.at(rhs);
 
+        if (lock.owns_lock()) lock.unlock();
         Data result = dataOp(lhsPts, rhsPts);
+        if (concurrent) lock.lock();
 
         PointsToID resultId;
         // Intern points-to set: check if result already exists.
@@ -387,6 +422,12 @@ private:
         return resultId;
     }
 
+    /// Locks the cache if it is in concurrent mode.
+    inline std::unique_lock<std::mutex> lockIfConcurrent(void) const
+    {
+        return concurrent ? std::unique_lock<std::mutex>(cacheMutex) : std::unique_lock<std::mutex>();
+    }
+
     /// Initialises statistics variables to 0.
     inline void initStats(void)
     {
@@ -428,6 +469,10 @@ private:
     /// Used to generate new PointsToIDs. Any non-zero is valid.
     PointsToID idCounter;
 
+    /// Whether operations must lock cacheMutex.
+    bool concurrent;
+    mutable std::mutex cacheMutex;
+
     // Statistics:
     u64_t totalUnions;
     u64_t uniqueUnions;
@@ -4,6 +4,7 @@
 
 #include <Graphs/ConsG.h>
 #include "MemoryModel/PointerAnalysis.h"
+#include "Util/BinaryFile.h"
 
 namespace SVF
 {
@@ -122,6 +123,24 @@ public:
     virtual void readAndSetObjFieldSensitivity(std::ifstream& f, const std::string& delimiterStr);
     //@}
 
+    /// Binary analysis result files, written unless -write-ander-text is set.
+    /// A file is a header followed by sections which are written in the same
+    /// stages as the text format; readFromFile recognises either format.
+    //@{
+    enum PtsFileSection
+    {
+        FIObjsBeforeSolving = 1,    ///< field-insensitive base objects before solving
+        TopLevelPts = 2,            ///< points-to sets of SVFIR nodes
+        GepObjVars = 3,             ///< gep objects created while solving
+        FIObjsAfterSolving = 4,     ///< field-insensitive base objects after solving
+        VersionedPts = 5            ///< points-to sets of versioned objects (VFS)
+    };
+    static bool isBinaryPtsFile(const std::string& filename);
+    virtual void writeBinaryObjVarToFile(const std::string& filename);
+    virtual void writeBinaryToFile(const std::string& filename);
+    virtual bool readBinaryFromFile(const std::string& filename);
+    //@}
+
 protected:
     /// Get points-to data structure
     inline PTDataTy* getPTDataTy() const
@@ -129,6 +148,28 @@ protected:
         return ptD.get();
     }
 
+    /// Helpers for binary analysis result files
+    //@{
+    /// Append a section of the given kind to sections
+    static void addPtsFileSection(BinaryWriter& sections, PtsFileSection kind, const BinaryWriter& payload);
+    /// Write sections to filename, after a header when the file is new or replace is set
+    static bool writePtsFileSections(const std::string& filename, const BinaryWriter& sections, bool replace);
+    /// Points-to sets of a list of keys: each distinct set is stored once,
+    /// followed by the index of the set of every key
+    static void writePtsTable(BinaryWriter& w, const std::vector<const PointsTo*>& keyPts);
+    static bool readPtsTable(BinaryReader& r, u32_t numKeys, std::vector<PointsTo>& sets, const u32_t*& keyToSet);
+    /// Recreate a gep object read from a file
+    void addGepObjVarFromFile(NodeID base, APOffset offset, NodeID id);
+    /// Base objects which are currently field-insensitive
+    void writeFIObjs(BinaryWriter& w);
+    bool readAndSetFIObjs(BinaryReader& r);
+    /// Versioned points-to sections are only understood by versioned analyses
+    virtual bool readVersionedPtsSection(BinaryReader&)
+    {
+        return true;
+    }
+    //@}
+
 
     /// Finalization of pointer analysis, and normalize points-to information to Bit Vector representation
     void finalize() override;
@@ -171,6 +212,17 @@ protected:
     /// On the fly call graph construction
     virtual void onTheFlyCallGraphSolve(const CallSiteToFunPtrMap& callsites, CallEdgeMap& newEdges);
 
+    /// On the fly call graph construction which only resolves the call sites
+    /// whose function (or vtable) pointer's points-to set changed since they
+    /// were last resolved by this method
+    virtual void onTheFlyChangedCallGraphSolve(const CallSiteToFunPtrMap& callsites, CallEdgeMap& newEdges);
+
+    /// Number of call sites (re-)resolved by onTheFlyChangedCallGraphSolve
+    inline u32_t getNumOfReResolvedCallSites() const
+    {
+        return numOfReResolvedCallSites;
+    }
+
     /// On the fly thread call graph construction respecting forksite
     virtual void onTheFlyThreadCallGraphSolve(const CallSiteToFunPtrMap& callsites,
             CallEdgeMap& newForkEdges);
@@ -185,6 +237,18 @@ private:
 
     PersistentPointsToCache<PointsTo> ptCache;
 
+    /// Call sites resolved by onTheFlyChangedCallGraphSolve, indexed by the
+    /// pointer they are resolved from
+    Map<NodeID, std::vector<const CallICFGNode*>> funPtrToCallSites;
+    /// The call site map funPtrToCallSites was built from, and the SVFIR's
+    /// indirect call site generation at that time; the index is rebuilt when
+    /// either changes
+    const CallSiteToFunPtrMap* indexedCallSites;
+    u32_t indexedCallSitesGen;
+    /// Points-to set of each such pointer when its call sites were last resolved
+    Map<NodeID, PointsTo> resolvedFunPtrPts;
+    u32_t numOfReResolvedCallSites;
+
 public:
     /// Interface expose to users of our pointer analysis, given Value infos
     AliasResult alias(const SVFVar* V1,
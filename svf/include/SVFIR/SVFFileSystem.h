@@ -0,0 +1,305 @@
+#ifndef INCLUDE_SVFIR_SVFFILESYSTEM_H_
+#define INCLUDE_SVFIR_SVFFILESYSTEM_H_
+
+#include "SVFIR/SVFIR.h"
+#include "Util/BinaryFile.h"
+
+namespace SVF
+{
+
+class AccessPath;
+class CHGraph;
+class SVFLoop;
+
+/*!
+ * Write an SVFIR together with its ICFG, basic blocks, class hierarchy and
+ * type information into a compact binary file. Analyses can then start from
+ * the file (see SVFIRReader) without parsing any LLVM IR.
+ *
+ * Objects refer to each other by IDs (variables, ICFG nodes) or by their
+ * position in the file (types, basic blocks, statements, ICFG edges), so a
+ * file can be read in one sequential pass.
+ */
+class SVFIRWriter
+{
+public:
+    /// Write svfir to filename. Return false if the file could not be written.
+    static bool writeToFile(const SVFIR* svfir, const std::string& filename);
+
+private:
+    explicit SVFIRWriter(const SVFIR* svfir);
+
+    /// Sections of the body, in the order they are read back
+    //@{
+    void writeShells();
+    void writeVars();
+    void writeBasicBlocks();
+    void writeICFGNodes();
+    void writeStmts();
+    void writeICFGEdges();
+    void writeLoops();
+    void writeSVFIRMaps();
+    void writeCallGraph();
+    void writeCHGraph();
+    void writeGlobals();
+    //@}
+
+    /// Tables written ahead of the body, after the body has added to them
+    //@{
+    void writeObjTypeInfos();
+    void writeTypes();
+    void writeStrings();
+    //@}
+
+    /// Positions in the tables, adding objects seen for the first time
+    //@{
+    u32_t getStrIdx(const std::string& str);
+    u32_t getTypeIdx(const SVFType* type);
+    u32_t getStInfoIdx(const StInfo* stInfo);
+    //@}
+
+    /// References
+    //@{
+    void writeStr(const std::string& str);
+    void writeType(const SVFType* type);
+    void writeStInfo(const StInfo* stInfo);
+    void writeObjTypeInfo(const ObjTypeInfo* objTypeInfo);
+    void writeVar(const SVFVar* var);
+    void writeICFGNode(const ICFGNode* node);
+    void writeBB(const SVFBasicBlock* bb);
+    void writeStmt(const SVFStmt* stmt);
+    void writeICFGEdge(const ICFGEdge* edge);
+    void writeAccessPath(const AccessPath& ap);
+    void writeSVFValue(const SVFValue* value);
+    //@}
+
+    template<class Container>
+    void writeVars(const Container& vars)
+    {
+        w.write<u32_t>(vars.size());
+        for (const auto* var : vars)
+            writeVar(var);
+    }
+    template<class Container>
+    void writeICFGNodes(const Container& nodes)
+    {
+        w.write<u32_t>(nodes.size());
+        for (const auto* node : nodes)
+            writeICFGNode(node);
+    }
+    template<class Container>
+    void writeBBs(const Container& bbs)
+    {
+        w.write<u32_t>(bbs.size());
+        for (const SVFBasicBlock* bb : bbs)
+            writeBB(bb);
+    }
+    template<class Container>
+    void writeStmts(const Container& stmts)
+    {
+        w.write<u32_t>(stmts.size());
+        for (const auto* stmt : stmts)
+            writeStmt(stmt);
+    }
+    template<class Container>
+    void writeNodeIDs(const Container& ids)
+    {
+        w.write<u32_t>(ids.size());
+        for (NodeID id : ids)
+            w.write<NodeID>(id);
+    }
+
+    const SVFIR* pag;
+    BinaryWriter w;
+
+    Map<std::string, u32_t> strToIdx;
+    std::vector<const std::string*> strs;
+    Map<const SVFType*, u32_t> typeToIdx;
+    std::vector<const SVFType*> types;
+    Map<const StInfo*, u32_t> stInfoToIdx;
+    std::vector<const StInfo*> stInfos;
+    Map<const ObjTypeInfo*, u32_t> objTypeInfoToIdx;
+    std::vector<const ObjTypeInfo*> objTypeInfos;
+    Map<const SVFBasicBlock*, u32_t> bbToIdx;
+    Map<const SVFStmt*, u32_t> stmtToIdx;
+    std::vector<const SVFStmt*> stmts;
+    Map<const ICFGEdge*, u32_t> icfgEdgeToIdx;
+    std::vector<const ICFGEdge*> icfgEdges;
+    Map<const SVFLoop*, u32_t> loopToIdx;
+    std::vector<const SVFLoop*> loops;
+};
+
+/*!
+ * Build the SVFIR (with its ICFG, call graph and class hierarchy) from a file
+ * written by SVFIRWriter. Every reference in the file is checked, so a
+ * truncated or malformed file is rejected instead of producing a broken SVFIR.
+ */
+class SVFIRReader
+{
+public:
+    /// Return the SVFIR read from filename, or nullptr if it cannot be read
+    static SVFIR* read(const std::string& filename);
+
+    /// Whether filename starts like a file written by SVFIRWriter
+    static bool isSVFIRFile(const std::string& filename);
+
+private:
+    typedef SVFValue::GNodeK GNodeK;
+    typedef GenericPAGEdgeTy::GEdgeFlag GEdgeFlag;
+
+    SVFIRReader(SVFIR* svfir, const BinaryReader& reader);
+
+    bool readAll();
+
+    /// Tables ahead of the body
+    //@{
+    void readStrings();
+    void readTypes();
+    void readObjTypeInfos();
+    //@}
+
+    /// Sections of the body, in the order of SVFIRWriter
+    //@{
+    void readShells();
+    void readVars();
+    void readBasicBlocks();
+    void readICFGNodes();
+    void readStmts();
+    void readICFGEdges();
+    void readLoops();
+    void readSVFIRMaps();
+    void readCallGraph();
+    void readCHGraph();
+    void readGlobals();
+    //@}
+
+    /// Create empty objects which are filled in by the later sections
+    //@{
+    SVFVar* createVar(NodeID id, GNodeK kind);
+    ICFGNode* createICFGNode(NodeID id, GNodeK kind);
+    SVFStmt* createStmt(GEdgeFlag kind);
+    ICFGEdge* createICFGEdge(GEdgeFlag kind);
+    //@}
+
+    /// Read a value; a read past the end marks the file malformed
+    template<class T>
+    T get()
+    {
+        T value{};
+        if (ok && !r.read(value))
+            ok = false;
+        return value;
+    }
+    /// Read the number of elements which follow (each takes at least a byte)
+    u32_t getCount();
+
+    /// References (nullptr for a null reference, or if it is invalid)
+    //@{
+    const std::string& getStr();
+    SVFType* getType();
+    StInfo* getStInfo();
+    ObjTypeInfo* getObjTypeInfo();
+    SVFVar* getVar();
+    ICFGNode* getICFGNode();
+    SVFBasicBlock* getBB();
+    SVFStmt* getStmt();
+    ICFGEdge* getICFGEdge();
+    SVFLoop* getLoop();
+    void getAccessPath(AccessPath& ap);
+    void getSVFValue(SVFValue* value);
+    //@}
+
+    /// Typed references: a reference to an object of another kind is invalid
+    //@{
+    template<class T>
+    T* getType()
+    {
+        return checkKind<T>(getType());
+    }
+    template<class T>
+    T* getVar()
+    {
+        return checkKind<T>(getVar());
+    }
+    template<class T>
+    T* getICFGNode()
+    {
+        return checkKind<T>(getICFGNode());
+    }
+    template<class T>
+    T* getStmt()
+    {
+        return checkKind<T>(getStmt());
+    }
+    template<class T, class Base>
+    T* checkKind(Base* obj)
+    {
+        if (obj == nullptr)
+            return nullptr;
+        if (T* t = SVFUtil::dyn_cast<T>(obj))
+            return t;
+        ok = false;
+        return nullptr;
+    }
+    //@}
+
+    /// Read a sequence of references into a container
+    //@{
+    template<class T, class Container>
+    void getVars(Container& vars)
+    {
+        u32_t num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+            vars.insert(vars.end(), getVar<T>());
+    }
+    template<class T, class Container>
+    void getICFGNodes(Container& nodes)
+    {
+        u32_t num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+            nodes.insert(nodes.end(), getICFGNode<T>());
+    }
+    template<class Container>
+    void getBBs(Container& bbs)
+    {
+        u32_t num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+            bbs.insert(bbs.end(), getBB());
+    }
+    template<class T, class Container>
+    void getStmts(Container& stmts)
+    {
+        u32_t num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+            stmts.insert(stmts.end(), getStmt<T>());
+    }
+    template<class Container>
+    void getNodeIDs(Container& ids)
+    {
+        u32_t num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+            ids.insert(ids.end(), get<NodeID>());
+    }
+    //@}
+
+    SVFIR* pag;
+    BinaryReader r;
+    bool ok;
+
+    std::vector<std::string> strs;
+    std::vector<SVFType*> types;
+    std::vector<StInfo*> stInfos;
+    std::vector<ObjTypeInfo*> objTypeInfos;
+    Map<NodeID, SVFVar*> vars;
+    std::vector<NodeID> varOrder;
+    Map<NodeID, ICFGNode*> icfgNodes;
+    std::vector<NodeID> icfgNodeOrder;
+    std::vector<SVFBasicBlock*> bbs;
+    std::vector<SVFStmt*> stmts;
+    std::vector<ICFGEdge*> icfgEdges;
+    std::vector<SVFLoop*> loops;
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_SVFIR_SVFFILESYSTEM_H_ */
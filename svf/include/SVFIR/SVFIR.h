@@ -62,6 +62,7 @@ private:
     FunToRetMap funRetMap;	///< Map a function to its unique function return PAGNodes
     CallSiteToFunPtrMap indCallSiteToFunPtrMap; ///< Map an indirect callsite to its function pointer
     FunPtrToCallSitesMap funPtrToCallSitesMap;	///< Map a function pointer to the callsites where it is used
+    u32_t indCallSiteGen; ///< Bumped whenever indirect callsites are added
     /// Valid pointers for pointer analysis resolution connected by SVFIR edges (constraints)
     /// this set of candidate pointers can change during pointer resolution (e.g. adding new object nodes)
     OrderedNodeSet candidatePointers;
@@ -198,12 +199,12 @@ public:
     /// Get/set methods to get SVFStmts based on their kinds and ICFGNodes
     //@{
     /// Get edges set according to its kind
-    inline SVFStmt::SVFStmtSetTy& getSVFStmtSet(SVFStmt::PEDGEK kind)
+    inline SVFStmt::SVFStmtTableTy& getSVFStmtSet(SVFStmt::PEDGEK kind)
     {
         return KindToSVFStmtSetMap[kind];
     }
     /// Get PTA edges set according to its kind
-    inline SVFStmt::SVFStmtSetTy& getPTASVFStmtSet(SVFStmt::PEDGEK kind)
+    inline SVFStmt::SVFStmtTableTy& getPTASVFStmtSet(SVFStmt::PEDGEK kind)
     {
         return KindToPTASVFStmtSetMap[kind];
     }
@@ -351,6 +352,11 @@ public:
     {
         return indCallSiteToFunPtrMap;
     }
+    /// Changes whenever indirect callsites are added, for analyses caching them
+    inline u32_t getIndirectCallsitesGeneration() const
+    {
+        return indCallSiteGen;
+    }
     inline NodeID getFunPtr(const CallICFGNode* cs) const
     {
         CallSiteToFunPtrMap::const_iterator it = indCallSiteToFunPtrMap.find(cs);
@@ -381,8 +387,8 @@ public:
     inline SVFStmt* getIntraPAGEdge(SVFVar* src, SVFVar* dst, SVFStmt::PEDGEK kind)
     {
         SVFStmt edge(src, dst, kind, false);
-        const SVFStmt::SVFStmtSetTy& edgeSet = getSVFStmtSet(kind);
-        SVFStmt::SVFStmtSetTy::const_iterator it = edgeSet.find(&edge);
+        const SVFStmt::SVFStmtTableTy& edgeSet = getSVFStmtSet(kind);
+        SVFStmt::SVFStmtTableTy::const_iterator it = edgeSet.find(&edge);
         assert(it != edgeSet.end() && "can not find pag edge");
         return (*it);
     }
@@ -483,14 +489,13 @@ private:
     /// Map a SVFStatement type to a set of corresponding SVF statements
     inline void addToStmt2TypeMap(SVFStmt* edge)
     {
-        bool added = KindToSVFStmtSetMap[edge->getEdgeKind()].insert(edge).second;
-        (void)added; // Suppress warning of unused variable under release build
-        assert(added && "duplicated edge, not added!!!");
+        assert(!edge->getSrcNode()->getOutEdges().count(edge) && "duplicated edge, not added!!!");
+        addToStmtTable(KindToSVFStmtSetMap[edge->getEdgeKind()], edge);
         /// this is a pointer-related SVFStmt if (1) both RHS and LHS are pointers or (2) this an int2ptr statment, i.e., LHS = int2ptr RHS
         if (edge->isPTAEdge() || (SVFUtil::isa<CopyStmt>(edge) && SVFUtil::cast<CopyStmt>(edge)->isInt2Ptr()))
         {
             totalPTAPAGEdge++;
-            KindToPTASVFStmtSetMap[edge->getEdgeKind()].insert(edge);
+            addToStmtTable(KindToPTASVFStmtSetMap[edge->getEdgeKind()], edge);
         }
     }
     /// Get/set method for function/callsite arguments and returns
@@ -527,6 +532,7 @@ private:
         bool added = indCallSiteToFunPtrMap.emplace(cs, funPtr).second;
         (void) added;
         funPtrToCallSitesMap[funPtr].insert(cs);
+        ++indCallSiteGen;
         assert(added && "adding the same indirect callsite twice?");
     }
 
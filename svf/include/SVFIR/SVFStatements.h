@@ -15,6 +15,7 @@ class CallICFGNode;
 class FunEntryICFGNode;
 class FunExitICFGNode;
 class SVFBasicBlock;
+class SVFStmtTable;
 
 /*
  * SVFIR program statements (PAGEdges)
@@ -186,6 +187,8 @@ public:
     typedef Map<EdgeID, SVFStmtSetTy> PAGEdgeToSetMapTy;
     typedef PAGEdgeToSetMapTy KindToSVFStmtMapTy;
     typedef SVFStmtSetTy PAGEdgeSetTy;
+    typedef SVFStmtTable SVFStmtTableTy;
+    typedef Map<EdgeID, SVFStmtTableTy> KindToSVFStmtTableMapTy;
 
 private:
     typedef Map<const ICFGNode*, u32_t> Inst2LabelMap;
@@ -197,6 +200,62 @@ private:
     static u64_t multiOpndLabelCounter;  ///< MultiOpndStmt counter
 };
 
+/*!
+ * All statements of one kind in a contiguous array, which takes a pointer per
+ * statement instead of a tree node. Statements are appended while the SVFIR
+ * is built and sorted in the order of SVFStmtSetTy (so the table is iterated
+ * exactly like the set it replaces) by compact() at the end of the build.
+ * Statements added afterwards are inserted at their sorted position, so the
+ * const accessors never modify the table.
+ */
+class SVFStmtTable
+{
+public:
+    typedef std::vector<SVFStmt*> StmtVector;
+    typedef StmtVector::const_iterator iterator;
+    typedef StmtVector::const_iterator const_iterator;
+
+    SVFStmtTable() : sorted(true) {}
+
+    /// Append a statement, which must not be in the table yet, during the build
+    void append(SVFStmt* stmt);
+
+    /// Insert a statement, which must not be in the table yet, at its sorted position
+    void insert(SVFStmt* stmt);
+
+    /// Sort the statements and release the spare capacity
+    void compact();
+
+    inline iterator begin() const
+    {
+        assert(sorted && "SVFStmtTable::begin: table is not compacted after the build");
+        return stmts.begin();
+    }
+    inline iterator end() const
+    {
+        return stmts.end();
+    }
+    inline u32_t size() const
+    {
+        return stmts.size();
+    }
+    inline bool empty() const
+    {
+        return stmts.empty();
+    }
+    /// Find the statement with the same kind, label and operands (a binary
+    /// search once the table is sorted, a linear one while it is built)
+    iterator find(const SVFStmt* stmt) const;
+    inline u32_t count(const SVFStmt* stmt) const
+    {
+        return find(stmt) != end();
+    }
+
+private:
+    StmtVector stmts;
+    bool sorted;
+};
+
 /*
  Parent class of Addr, Copy, Store, Load, Call, Ret, NormalGep, VariantGep, ThreadFork, ThreadJoin
  connecting RHS expression and LHS expression with an assignment  (e.g., LHSExpr = RHSExpr)
@@ -12,6 +12,8 @@ namespace SVF
 
 class SVFValue
 {
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
 
 public:
 
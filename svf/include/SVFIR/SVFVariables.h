@@ -1714,7 +1714,7 @@ class ConstDataObjVar : public BaseObjVar
 
 protected:
     /// Constructor to create empty DummyObjVar (for SVFIRReader/deserialization)
-    ConstDataObjVar(NodeID i, const ICFGNode* node) : BaseObjVar(i, node, ConstDataObjNode) {}
+    ConstDataObjVar(NodeID i, const ICFGNode* node, PNODEK ty = ConstDataObjNode) : BaseObjVar(i, node, ty) {}
 
 public:
     //@{ Methods for support type inquiry through isa, cast, and dyn_cast:
@@ -1771,7 +1771,7 @@ class ConstFPObjVar : public ConstDataObjVar
 
 private:
     /// Constructor to create empty DummyObjVar (for SVFIRReader/deserialization)
-    ConstFPObjVar(NodeID i, const ICFGNode* node) : ConstDataObjVar(i, node) {}
+    ConstFPObjVar(NodeID i, const ICFGNode* node) : ConstDataObjVar(i, node, ConstFPObjNode) {}
 
 private:
     float dval;
@@ -1834,7 +1834,7 @@ class ConstIntObjVar : public ConstDataObjVar
 
 private:
     /// Constructor to create empty DummyObjVar (for SVFIRReader/deserialization)
-    ConstIntObjVar(NodeID i, const ICFGNode* node) : ConstDataObjVar(i, node) {}
+    ConstIntObjVar(NodeID i, const ICFGNode* node) : ConstDataObjVar(i, node, ConstIntObjNode) {}
 
 private:
     u64_t zval;
@@ -1904,7 +1904,7 @@ class ConstNullPtrObjVar : public ConstDataObjVar
 
 private:
     /// Constructor to create empty DummyObjVar (for SVFIRReader/deserialization)
-    ConstNullPtrObjVar(NodeID i, const ICFGNode* node) : ConstDataObjVar(i, node) {}
+    ConstNullPtrObjVar(NodeID i, const ICFGNode* node) : ConstDataObjVar(i, node, ConstNullptrObjNode) {}
 
 public:
     //@{ Methods for support type inquiry through isa, cast, and dyn_cast:
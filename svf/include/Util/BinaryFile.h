@@ -0,0 +1,205 @@
+
+#ifndef BINARYFILE_H_
+#define BINARYFILE_H_
+
+#include "Util/GeneralType.h"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace SVF
+{
+
+/*!
+ * Builds the content of a binary file in memory.
+ * Values are stored in host byte order; arrays can be aligned so that a
+ * BinaryReader over a mapped file hands them out without copying.
+ */
+class BinaryWriter
+{
+public:
+    template<class T>
+    inline void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter::write: not trivially copyable!");
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<class T>
+    inline void writeArray(const T* values, size_t num)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter::writeArray: not trivially copyable!");
+        const char* bytes = reinterpret_cast<const char*>(values);
+        buffer.insert(buffer.end(), bytes, bytes + num * sizeof(T));
+    }
+
+    template<class T>
+    inline void writeVector(const std::vector<T>& values)
+    {
+        writeArray(values.data(), values.size());
+    }
+
+    inline void writeBytes(const char* bytes, size_t num)
+    {
+        buffer.insert(buffer.end(), bytes, bytes + num);
+    }
+
+    /// Pad with zeros to a multiple of alignment bytes
+    inline void align(size_t alignment = 8)
+    {
+        while (buffer.size() % alignment != 0)
+            buffer.push_back(0);
+    }
+
+    inline size_t size() const
+    {
+        return buffer.size();
+    }
+
+    inline const std::vector<char>& getBuffer() const
+    {
+        return buffer;
+    }
+
+    inline void clear()
+    {
+        buffer.clear();
+    }
+
+    /// Write the buffer to filename, appending to it or replacing it.
+    /// Return false if the file could not be written.
+    bool writeToFile(const std::string& filename, bool append) const;
+
+private:
+    std::vector<char> buffer;
+};
+
+/*!
+ * Sequential reader over a byte range, typically a MappedFile.
+ * Every read checks the bounds and fails (returns false/nullptr) rather than
+ * running off the end of a truncated or malformed file.
+ */
+class BinaryReader
+{
+public:
+    BinaryReader(const char* data, size_t size) : begin(data), cur(data), end(data + size)
+    {
+    }
+
+    template<class T>
+    inline bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryReader::read: not trivially copyable!");
+        if (remaining() < sizeof(T))
+            return false;
+        std::memcpy(&value, cur, sizeof(T));
+        cur += sizeof(T);
+        return true;
+    }
+
+    /// Return num values of type T in place, or nullptr if they are out of
+    /// bounds or misaligned.
+    template<class T>
+    inline const T* readArray(size_t num)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryReader::readArray: not trivially copyable!");
+        if (num > remaining() / sizeof(T))
+            return nullptr;
+        if (reinterpret_cast<uintptr_t>(cur) % alignof(T) != 0)
+            return nullptr;
+        const T* values = reinterpret_cast<const T*>(cur);
+        cur += num * sizeof(T);
+        return num == 0 ? reinterpret_cast<const T*>(end) : values;
+    }
+
+    /// Return a reader over the next num bytes and skip them.
+    inline bool readSub(size_t num, BinaryReader& sub)
+    {
+        if (num > remaining())
+            return false;
+        sub = BinaryReader(cur, num);
+        cur += num;
+        return true;
+    }
+
+    /// Skip padding up to a multiple of alignment bytes from the beginning
+    inline bool align(size_t alignment = 8)
+    {
+        size_t offset = cur - begin;
+        size_t padding = (alignment - offset % alignment) % alignment;
+        if (padding > remaining())
+            return false;
+        cur += padding;
+        return true;
+    }
+
+    inline size_t remaining() const
+    {
+        return end - cur;
+    }
+
+    inline bool atEnd() const
+    {
+        return cur == end;
+    }
+
+private:
+    const char* begin;
+    const char* cur;
+    const char* end;
+};
+
+/*!
+ * A file mapped read-only into memory.
+ */
+class MappedFile
+{
+public:
+    MappedFile() : data(nullptr), size(0)
+    {
+    }
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    void operator=(const MappedFile&) = delete;
+
+    /// Map filename. Return false if it cannot be opened or mapped.
+    bool open(const std::string& filename);
+
+    void close();
+
+    inline bool isOpen() const
+    {
+        return data != nullptr;
+    }
+
+    inline const char* getData() const
+    {
+        return data;
+    }
+
+    inline size_t getSize() const
+    {
+        return size;
+    }
+
+    inline BinaryReader getReader() const
+    {
+        return BinaryReader(data, size);
+    }
+
+private:
+    const char* data;
+    size_t size;
+};
+
+} // End namespace SVF
+
+#endif /* BINARYFILE_H_ */
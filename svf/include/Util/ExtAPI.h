@@ -19,6 +19,38 @@ class ExtAPI
 {
     friend class LLVMModuleSet;
     friend class SVFIRBuilder;
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
+
+public:
+    /// Properties of an external function which are queried for every call
+    /// site, compiled from its annotations when they are set
+    enum ExtFuncFlag : u32_t
+    {
+        EXT_ANNOTATED = 1 << 0,         ///< has some annotation
+        EXT_OVERWRITE_ONLY = 1 << 1,    ///< its only annotation is OVERWRITE
+        EXT_MEMCPY = 1 << 2,            ///< MEMCPY, STRCPY or STRCAT
+        EXT_MEMSET = 1 << 3,
+        EXT_ALLOC_HEAP_RET = 1 << 4,
+        EXT_ALLOC_HEAP_ARG = 1 << 5,
+        EXT_ALLOC_STACK_RET = 1 << 6,
+        EXT_REALLOC_HEAP_RET = 1 << 7
+    };
+
+    struct ExtFuncInfo
+    {
+        u32_t flags;
+        s32_t allocArgPos; ///< the number in ALLOC_HEAP_ARG, or -1
+        ExtFuncInfo() : flags(0), allocArgPos(-1) {}
+        inline bool has(ExtFuncFlag flag) const
+        {
+            return flags & flag;
+        }
+    };
+
+    /// Compile annotations into flags. Names are matched as substrings of
+    /// the annotations, like hasExtFuncAnnotation does.
+    static ExtFuncInfo compileAnnotations(const std::vector<std::string>& funcAnnotations);
 
 private:
 
@@ -27,6 +59,12 @@ private:
     // Map SVFFunction to its annotations
     Map<const FunObjVar*, std::vector<std::string>> funObjVar2Annotations;
 
+    // Map SVFFunction to its compiled annotations
+    Map<const FunObjVar*, ExtFuncInfo> funObjVar2ExtInfo;
+
+    // Compiled annotations of fun (no flags if it has no annotations)
+    const ExtFuncInfo& getExtFuncInfo(const FunObjVar* fun) const;
+
     // extapi.bc file path
     static std::string extBcPath;
 
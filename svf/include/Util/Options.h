@@ -70,12 +70,18 @@ public:
     /// Time limit for the main phase (i.e., the actual solving) of FS analyses.
     static const Option<u32_t> FsTimeLimit;
 
+    /// Number of threads to propagate address-taken objects with in FS.
+    static const Option<u32_t> FsThreads;
+
     /// Time limit for the Andersen's analyses.
     static const Option<u32_t> AnderTimeLimit;
 
     /// Number of threads for the versioning phase.
     static const Option<u32_t> VersioningThreads;
 
+    /// Number of threads for propagating versions while solving VFS.
+    static const Option<u32_t> VersionPropThreads;
+
     // ContextDDA.cpp
     static const Option<u32_t> CxtBudget;
 
@@ -105,6 +111,7 @@ public:
     static const Option<bool> ContextInsensitive;
     static const Option<bool> KeepAOFI;
     static const Option<std::string> SelfCycle;
+    static const Option<u32_t> SVFGOptThreads;
 
     // Sparse value-flow graph (VFG.cpp)
     static const Option<bool> DumpVFG;
@@ -120,8 +127,8 @@ public:
     static const Option<bool> PAGDotGraph;
     static const Option<bool> ShowSVFIRValue;
     static const Option<bool> DumpICFG;
-    static const Option<std::string> DumpJson;
-    static const Option<bool> ReadJson;
+    static const Option<std::string> WriteSVFIR;
+    static const Option<bool> ReadSVFIR;
     static const Option<bool> CallGraphDotGraph;
     static const Option<bool> PAGPrint;
     static const Option<u32_t> IndirectCallLimit;
@@ -142,6 +149,7 @@ public:
     static const Option<std::string> MSSAFun;
     // static const llvm::cl::opt<string> MSSAFun;
     static const OptionMap<MemSSA::MemPartition> MemPar;
+    static const Option<u32_t> MSSAThreads;
 
     // SVFG builder (SVFGBuilder.cpp)
     static const Option<bool> SVFGWithIndirectCall;
@@ -149,6 +157,7 @@ public:
 
     static const Option<std::string> WriteSVFG;
     static const Option<std::string> ReadSVFG;
+    static const Option<bool> WriteSVFGText;
 
     // LockAnalysis.cpp
     static const Option<bool> IntraLock;
@@ -173,6 +182,7 @@ public:
 
     // CHG.cpp
     static const Option<bool> DumpCHA;
+    static const Option<u32_t> CHGThreads;
 
     // DCHG.cpp
     static const Option<bool> PrintDCHG;
@@ -180,6 +190,10 @@ public:
     // LLVMModule.cpp
     static const Option<std::string> Graphtxt;
     static const Option<bool> SVFMain;
+    static const Option<u32_t> ModuleLoadThreads;
+    static const Option<u32_t> DomInfoThreads;
+    static const Option<std::string> SVFIRCacheDir;
+    static const Option<bool> ReleaseLLVMIR;
 
     // SymbolTableInfo.cpp
     static const Option<bool> LocMemModel;
@@ -187,6 +201,8 @@ public:
     static Option<bool> ModelArrays;
     static const Option<bool> CyclicFldIdx;
     static const Option<bool> SymTabPrint;
+    static const Option<u32_t> TypeInferenceThreads;
+    static const Option<u32_t> SymbolTableThreads;
 
     // Conditions.cpp
     static const Option<u32_t> MaxZ3Size;
@@ -207,11 +223,16 @@ public:
     static const Option<bool> ConsCGDotGraph;
     static const Option<bool> SVFG2CG;
     static const Option<bool> BriefConsCGDotGraph;
+    static const Option<bool> ConsGArena;
+    static const Option<bool> CompactFSConsG;
+    static const Option<u32_t> PtsMemBudget;
+    static const Option<u32_t> AnderThreads;
     static const Option<bool> PrintCGGraph;
     // static const Option<string> WriteAnder;
     static const Option<std::string> WriteAnder;
     // static const Option<string> ReadAnder;
     static const Option<std::string> ReadAnder;
+    static const Option<bool> WriteAnderText;
     static const Option<bool> DiffPts;
     static Option<bool> DetectPWC;
     static const Option<bool> VtableInSVFIR;
@@ -63,8 +63,12 @@ public:
     virtual void callgraphStat() {}
 
     static double timeOfBuildingLLVMModule;
+    static double timeOfLoadingModules;
+    static double timeOfBuildingDomInfo;
     static double timeOfBuildingSymbolTable;
     static double timeOfBuildingSVFIR;
+    static u32_t numOfSVFIRCacheHits;
+    static u32_t numOfSVFIRCacheMisses;
 
 private:
     void branchStat();
@@ -0,0 +1,237 @@
+
+#ifndef TYPEDARENA_H_
+#define TYPEDARENA_H_
+
+#include <assert.h>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace SVF
+{
+
+/*!
+ * Arena for objects of type T and its subclasses.
+ *
+ * Objects are carved out of large slabs, segregated by (aligned) object size so
+ * that every subclass gets its own size class. A freed object is put on the free
+ * list of its size class and reused by the next allocation of that size; slabs
+ * are only handed back to the system in bulk, through release(), once no object
+ * allocated from the arena is alive.
+ *
+ * Whether the arena is used is decided once, when the arena is created, so that
+ * an object is always deallocated the same way it was allocated. When disabled,
+ * allocate/deallocate simply forward to the global operator new/delete.
+ */
+template<class T>
+class TypedArena
+{
+public:
+    /// Bytes per slab
+    static const size_t SlabSize = 1 << 20;
+    /// Allocation granularity (and alignment) of objects
+    static const size_t Granularity = alignof(std::max_align_t);
+    /// Objects larger than this are not served from slabs
+    static const size_t MaxObjectSize = 1024;
+
+    TypedArena(bool enabled) : enabled(enabled), liveBytes(0), peakLiveBytes(0),
+        freeBytes(0), numLive(0), numAllocated(0), numReused(0)
+    {
+    }
+
+    ~TypedArena()
+    {
+        // Objects may still be referenced by statics at exit; only
+        // give the memory back if everything was destroyed.
+        release();
+    }
+
+    TypedArena(const TypedArena&) = delete;
+    void operator=(const TypedArena&) = delete;
+
+    inline bool isEnabled() const
+    {
+        return enabled;
+    }
+
+    /// Allocate uninitialised memory for an object of size bytes
+    void* allocate(size_t size)
+    {
+        if (!enabled || size > MaxObjectSize)
+            return ::operator new(size);
+
+        const size_t cls = sizeClass(size);
+        const size_t bytes = classBytes(cls);
+        if (cls >= classes.size())
+            classes.resize(cls + 1);
+        SizeClass& sc = classes[cls];
+
+        void* obj = nullptr;
+        if (sc.freeList != nullptr)
+        {
+            obj = sc.freeList;
+            sc.freeList = sc.freeList->next;
+            freeBytes -= bytes;
+            ++numReused;
+        }
+        else
+        {
+            if (sc.cur == nullptr || sc.cur + bytes > sc.end)
+            {
+                char* slab = static_cast<char*>(::operator new(SlabSize));
+                slabs.push_back(slab);
+                sc.cur = slab;
+                sc.end = slab + SlabSize;
+            }
+            obj = sc.cur;
+            sc.cur += bytes;
+        }
+
+        ++numLive;
+        ++numAllocated;
+        liveBytes += bytes;
+        if (liveBytes > peakLiveBytes)
+            peakLiveBytes = liveBytes;
+        return obj;
+    }
+
+    /// Return the memory of a destroyed object of size bytes to its free list
+    void deallocate(void* obj, size_t size)
+    {
+        if (obj == nullptr)
+            return;
+        if (!enabled || size > MaxObjectSize)
+        {
+            ::operator delete(obj);
+            return;
+        }
+
+        const size_t cls = sizeClass(size);
+        assert(cls < classes.size() && "deallocating from an unused size class?");
+        FreeSlot* slot = static_cast<FreeSlot*>(obj);
+        slot->next = classes[cls].freeList;
+        classes[cls].freeList = slot;
+
+        const size_t bytes = classBytes(cls);
+        assert(numLive > 0 && liveBytes >= bytes && "more deallocations than allocations?");
+        --numLive;
+        liveBytes -= bytes;
+        freeBytes += bytes;
+    }
+
+    /// Free all slabs at once. Only possible when no object is alive.
+    /// Return true if the slabs were released.
+    bool release()
+    {
+        if (numLive != 0)
+            return false;
+        for (char* slab : slabs)
+            ::operator delete(slab);
+        slabs.clear();
+        classes.clear();
+        liveBytes = 0;
+        freeBytes = 0;
+        return true;
+    }
+
+    /// Free all slabs at once although objects are still alive. The caller
+    /// guarantees that these objects are never used or deallocated again and
+    /// own no memory besides their slots (their destructors have run or have
+    /// nothing to release), and that none is larger than MaxObjectSize.
+    void reset()
+    {
+        for (char* slab : slabs)
+            ::operator delete(slab);
+        slabs.clear();
+        classes.clear();
+        liveBytes = 0;
+        freeBytes = 0;
+        numLive = 0;
+    }
+
+    /// Statistics
+    //@{
+    /// Number of objects currently alive
+    inline size_t getNumLive() const
+    {
+        return numLive;
+    }
+    /// Number of allocations served, and how many of them reused a freed slot
+    inline size_t getNumAllocated() const
+    {
+        return numAllocated;
+    }
+    inline size_t getNumReused() const
+    {
+        return numReused;
+    }
+    inline size_t getNumSlabs() const
+    {
+        return slabs.size();
+    }
+    inline size_t getReservedBytes() const
+    {
+        return slabs.size() * SlabSize;
+    }
+    inline size_t getLiveBytes() const
+    {
+        return liveBytes;
+    }
+    inline size_t getPeakLiveBytes() const
+    {
+        return peakLiveBytes;
+    }
+    /// Fraction of reserved memory which is not occupied by live objects
+    /// (freed slots and unused slab tails).
+    inline double getFragmentation() const
+    {
+        const size_t reserved = getReservedBytes();
+        return reserved == 0 ? 0.0 : (double)(reserved - liveBytes) / reserved;
+    }
+    /// Bytes sitting in free lists
+    inline size_t getFreeBytes() const
+    {
+        return freeBytes;
+    }
+    //@}
+
+private:
+    /// A freed object, linked into the free list of its size class
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    /// Bump pointer and free list of one size class
+    struct SizeClass
+    {
+        char* cur = nullptr;
+        char* end = nullptr;
+        FreeSlot* freeList = nullptr;
+    };
+
+    static inline size_t sizeClass(size_t size)
+    {
+        return (size + Granularity - 1) / Granularity;
+    }
+
+    static inline size_t classBytes(size_t cls)
+    {
+        return cls * Granularity;
+    }
+
+    bool enabled;
+    std::vector<char*> slabs;
+    std::vector<SizeClass> classes;
+
+    size_t liveBytes;
+    size_t peakLiveBytes;
+    size_t freeBytes;
+    size_t numLive;
+    size_t numAllocated;
+    size_t numReused;
+};
+
+} // End namespace SVF
+
+#endif /* TYPEDARENA_H_ */
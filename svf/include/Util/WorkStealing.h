@@ -0,0 +1,196 @@
+
+#ifndef WORKSTEALING_H_
+#define WORKSTEALING_H_
+
+#include <assert.h>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SVF
+{
+
+/*!
+ * A fixed set of work items processed by a pool of threads.
+ *
+ * Items are dealt round-robin into one deque per thread before the pool runs.
+ * A thread takes work from the front of its own deque and, once that is empty,
+ * steals from the back of the others. Each deque has its own lock which is only
+ * contended while stealing, so there is no global queue every thread has to go
+ * through. No work is added while running: a thread is done when its own deque
+ * and all others are empty.
+ */
+template<class T>
+class WorkStealingPool
+{
+public:
+    WorkStealingPool(unsigned numThreads) : numThreads(numThreads), next(0),
+        deques(new Deque[numThreads])
+    {
+        assert(numThreads > 0 && "WorkStealingPool: need at least one thread!");
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    void operator=(const WorkStealingPool&) = delete;
+
+    inline unsigned getNumThreads() const
+    {
+        return numThreads;
+    }
+
+    /// Add an item before running the pool.
+    void push(const T &item)
+    {
+        deques[next].items.push_back(item);
+        next = (next + 1) % numThreads;
+    }
+
+    /// Process every item with worker(item, thread). With a single thread
+    /// everything runs on the calling thread.
+    template<class Worker>
+    void run(Worker worker)
+    {
+        if (numThreads == 1)
+        {
+            work(worker, 0);
+            return;
+        }
+
+        auto threadMain = [this, &worker](unsigned thread)
+        {
+            work(worker, thread);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (unsigned t = 0; t < numThreads; ++t) threads.push_back(std::thread(threadMain, t));
+        for (std::thread &thread : threads) thread.join();
+    }
+
+    /// Statistics, valid after run.
+    //@{
+    inline size_t getNumProcessed(unsigned thread) const
+    {
+        return deques[thread].numProcessed;
+    }
+    inline size_t getNumSteals(unsigned thread) const
+    {
+        return deques[thread].numSteals;
+    }
+    size_t getNumSteals() const
+    {
+        size_t steals = 0;
+        for (unsigned t = 0; t < numThreads; ++t) steals += deques[t].numSteals;
+        return steals;
+    }
+    size_t getMaxProcessed() const
+    {
+        size_t max = 0;
+        for (unsigned t = 0; t < numThreads; ++t)
+            if (deques[t].numProcessed > max) max = deques[t].numProcessed;
+        return max;
+    }
+    size_t getMinProcessed() const
+    {
+        size_t min = deques[0].numProcessed;
+        for (unsigned t = 1; t < numThreads; ++t)
+            if (deques[t].numProcessed < min) min = deques[t].numProcessed;
+        return min;
+    }
+    //@}
+
+private:
+    /// Per-thread deque, padded to its own cache line(s).
+    struct alignas(64) Deque
+    {
+        std::mutex lock;
+        std::deque<T> items;
+        /// Only written by the owning thread.
+        size_t numProcessed = 0;
+        size_t numSteals = 0;
+    };
+
+    template<class Worker>
+    void work(Worker &worker, unsigned thread)
+    {
+        T item;
+        while (popOwn(thread, item) || steal(thread, item))
+        {
+            worker(item, thread);
+            ++deques[thread].numProcessed;
+        }
+    }
+
+    bool popOwn(unsigned thread, T &item)
+    {
+        Deque &d = deques[thread];
+        std::lock_guard<std::mutex> guard(d.lock);
+        if (d.items.empty()) return false;
+        item = d.items.front();
+        d.items.pop_front();
+        return true;
+    }
+
+    /// Steal from the back of another thread's deque, starting from the
+    /// next thread so victims are spread out.
+    bool steal(unsigned thread, T &item)
+    {
+        for (unsigned i = 1; i < numThreads; ++i)
+        {
+            Deque &victim = deques[(thread + i) % numThreads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.items.empty()) continue;
+            item = victim.items.back();
+            victim.items.pop_back();
+            ++deques[thread].numSteals;
+            return true;
+        }
+
+        return false;
+    }
+
+    unsigned numThreads;
+    unsigned next;
+    std::unique_ptr<Deque[]> deques;
+};
+
+/*!
+ * A fixed, power-of-two number of mutexes shared by a (possibly much larger)
+ * set of keys, key k being guarded by stripe k mod #stripes.
+ */
+class LockStripes
+{
+public:
+    /// At least minStripes stripes, but never more than needed for numKeys keys.
+    LockStripes(size_t minStripes, size_t numKeys) : mask(0)
+    {
+        size_t n = 1;
+        while (n < minStripes && n < numKeys) n <<= 1;
+        stripes.reset(new std::mutex[n]);
+        mask = n - 1;
+    }
+
+    LockStripes(const LockStripes&) = delete;
+    void operator=(const LockStripes&) = delete;
+
+    inline std::mutex &get(size_t key)
+    {
+        return stripes[key & mask];
+    }
+
+    inline size_t getNumStripes() const
+    {
+        return mask + 1;
+    }
+
+private:
+    std::unique_ptr<std::mutex[]> stripes;
+    size_t mask;
+};
+
+} // End namespace SVF
+
+#endif /* WORKSTEALING_H_ */
@@ -137,6 +137,7 @@ public:
     static double timeOfProcessCopyGep;
     static double timeOfProcessLoadStore;
     static double timeOfUpdateCallGraph;
+    static u32_t numOfWaveLevels;      /// Number of topological levels propagated by parallel wave propagation
     //@}
 
 protected:
@@ -395,6 +396,17 @@ public:
     virtual void postProcessNode(NodeID nodeId);
     virtual bool handleLoad(NodeID id, const ConstraintEdge* load);
     virtual bool handleStore(NodeID id, const ConstraintEdge* store);
+
+protected:
+    /// Parallel wave propagation (-ander-threads > 1)
+    //@{
+    /// Propagate along copy/gep edges level by level in topological order;
+    /// nodes of one level have no edges between them.
+    void propagateByLevel(NodeStack& nodeStack);
+    /// Process loads/stores of all nodes in the worklist, finding new copy
+    /// edges in parallel and adding them in worklist order.
+    void postProcessNodes();
+    //@}
 };
 
 } // End namespace SVF
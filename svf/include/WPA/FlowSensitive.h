@@ -41,6 +41,9 @@ public:
         numOfProcessedPhi = numOfProcessedActualParam = numOfProcessedFormalRet = 0;
         numOfProcessedMSSANode = 0;
         maxSCCSize = numOfSCC = numOfNodesInSCC = 0;
+        numOfParallelRounds = numOfParallelSteals = 0;
+        parallelPropaTime = 0;
+        deferIndirectProp = false;
         iterationForPrintStat = OnTheFlyIterBudgetForStat;
     }
 
@@ -113,6 +116,24 @@ protected:
     /// SCC detection
     NodeStack& SCCDetect() override;
 
+    /// Solve the worklist, with indirect propagation done objects in
+    /// parallel when fs-threads > 1.
+    void solveWorklist() override;
+
+    /// Parallel propagation of address-taken objects
+    //@{
+    /// Whether indirect edges are propagated by propagateObjectsInParallel.
+    bool isParallelSolve() const;
+    /// Create the IN/OUT maps of every statement with indirect edges so that
+    /// workers never insert into the data-flow maps shared between objects.
+    void prepareParallelSolve();
+    /// Propagate the objects of deferred indirect edges to a fixed point
+    /// through memory SSA nodes, objects in parallel. Loads and stores whose
+    /// IN set changed are pushed into the worklist.
+    /// Return true if the worklist is not empty afterwards.
+    bool propagateObjectsInParallel();
+    //@}
+
     /// Propagation
     //@{
     /// Propagate points-to information from an edge's src node to its dst node.
@@ -123,6 +144,15 @@ protected:
     virtual bool propAlongIndirectEdge(const IndirectSVFGEdge* edge);
     /// Propagate points-to information of a certain variable from src to dst.
     virtual bool propVarPtsFromSrcToDst(NodeID var, const SVFGNode* src, const SVFGNode* dst);
+    /// Objects propagated along an indirect edge: those in its label and all
+    /// fields of the field-insensitive ones. Edges propagated in one batch
+    /// share the result for the same label, so each distinct label is
+    /// expanded once per batch.
+    const NodeBS& getIndirectEdgeVars(const IndirectSVFGEdge* edge);
+    /// As above, for a label.
+    const NodeBS& getLabelVars(PointsToID label);
+    /// Compute the objects propagated along edges labelled label into vars.
+    void expandLabel(PointsToID label, NodeBS& vars);
     /// Propagate points-to information from an actual-param to a formal-param.
     /// Not necessary if SVFGOPT is used instead of original SVFG.
     virtual bool propagateFromAPToFP(const ActualParmSVFGNode* ap, const SVFGNode* dst);
@@ -215,6 +245,16 @@ protected:
     virtual void countAliases(Set<std::pair<NodeID, NodeID>> cmp, unsigned *mayAliases, unsigned *noAliases);
 
     SVFG* svfg;
+    /// Label of an indirect edge -> objects to propagate, for the current batch
+    Map<PointsToID, NodeBS> labelToVars;
+    /// Label -> objects to propagate, for propagateObjectsInParallel. Labels
+    /// are dense, so only labels added since the last round are expanded; the
+    /// table is dropped when an object becomes field-insensitive.
+    std::vector<NodeBS> parallelLabelVars;
+    /// Whether propagation along indirect edges is deferred to propagateObjectsInParallel
+    bool deferIndirectProp;
+    /// Object -> indirect edges it is still to be propagated along
+    Map<NodeID, std::vector<const IndirectSVFGEdge*>> objToPendingEdges;
     ///Get points-to set for a node from data flow IN/OUT set at a statement.
     //@{
     inline const PointsTo& getDFInPtsSet(const SVFGNode* stmt, const NodeID node)
@@ -286,6 +326,10 @@ protected:
     double storeTime;	///< time of store edges
     double phiTime;	///< time of phi nodes.
     double updateCallGraphTime; ///< time of updating call graph
+    double parallelPropaTime;	///< time of propagating objects in parallel
+
+    u32_t numOfParallelRounds;	///< Number of propagateObjectsInParallel rounds
+    u32_t numOfParallelSteals;	///< Objects stolen by another thread while propagating in parallel
 
     NodeBS svfgHasSU;
     //@}
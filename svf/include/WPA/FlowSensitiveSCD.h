@@ -20,7 +20,7 @@ protected:
 
 public:
     /// Constructor
-    FlowSensitiveSCD(SVFIR* _pag, PTATY type = FlowSensitiveSCD_WPA, bool alias_check = false) : Andersen(_pag, type) {}
+    FlowSensitiveSCD(SVFIR* _pag, PTATY type = FlowSensitiveSCD_WPA, bool alias_check = false) : Andersen(_pag, type), numOfNodesSinceMemCheck(0) {}
 
     ~FlowSensitiveSCD() override
     {
@@ -38,7 +38,31 @@ public:
         return fsconsCG;
     }
 
+    /// Statistics of node ID compaction
+    //@{
+    static u32_t numOfCompaction;
+    static u32_t numOfCompactedIDs;
+    static double timeOfCompaction;
+    //@}
+
+    /// Statistics of spilling cold points-to sets under pts-mem-budget
+    //@{
+    static u32_t numOfMemChecks;
+    static u32_t numOfSpills;
+    static double timeOfSpill;
+    /// Taken from the points-to data when solving finishes
+    static MutDiffPTDataTy::SpillStats spillStats;
+    //@}
+
 protected:
+    /// Cluster objects based on the auxiliary Andersen's, setting the global best
+    /// mapping. Points-to sets of fsconsCG only hold SVFIR objects, never the
+    /// versioned nodes, so only objects are mapped.
+    virtual void cluster(void) const override;
+
+    /// Use a plain mapping (identity) for objects, setting the global best mapping
+    virtual void plainMap(void) const;
+
     virtual bool addCopyEdge(NodeID src, NodeID dst) override;
     virtual bool addCopyEdgeOriginal(NodeID src, NodeID dst);
 
@@ -59,6 +83,17 @@ protected:
     virtual void processNode(NodeID nodeId) override;
     virtual void processAllAddr();
 
+    /// Renumber live FSConsG nodes densely and move their points-to sets,
+    /// worklist entries and SCC candidates to the new IDs
+    void compactNodeIDs();
+
+    /// Nodes processed between two checks of the memory budget
+    static const u32_t MemCheckInterval = 4096;
+    /// Compress the points-to sets not accessed since the last check if the
+    /// resident set size is close to pts-mem-budget
+    void checkMemBudget();
+    u32_t numOfNodesSinceMemCheck;
+
     void mergeSccCycle();
     void mergeSccNodes(NodeID repNodeId, const NodeBS& subNodes);
     virtual bool mergeSrcToTgt(NodeID srcId,NodeID tgtId) override;
@@ -88,6 +88,7 @@ protected:
     virtual bool processLoad(const LoadSVFGNode* load) override;
     virtual bool processStore(const StoreSVFGNode* store) override;
     virtual void processNode(NodeID n) override;
+    virtual void solveWorklist() override;
     virtual void updateConnectedNodes(const SVFGEdgeSetTy& newEdges) override;
 
     /// Override to do nothing. Instead, we will use propagateVersion when necessary.
@@ -119,6 +120,11 @@ private:
     /// taken itself.
     void propagateVersion(const NodeID o, const Version v, const Version vp, bool time=true);
 
+    /// Propagates the versions in pendingVersions, objects in parallel, until no reliant
+    /// version changes and adds statements relying on changed versions to the worklist.
+    /// Returns true if the worklist is no longer empty.
+    bool propagatePendingVersions(void);
+
     /// Fills in isStoreMap and isLoadMap.
     virtual void buildIsStoreLoadMaps(void);
 
@@ -175,6 +181,11 @@ private:
 
     void readVersionedAnalysisResultFromFile(std::ifstream& F);
 
+    /// Binary counterparts of the above.
+    void writeBinaryVersionedAnalysisResultToFile(const std::string& filename);
+
+    bool readVersionedPtsSection(BinaryReader& section) override;
+
     void readPtsFromFile(const std::string& filename) override;
 
     /// Dumps a MeldVersion to stdout.
@@ -206,6 +217,10 @@ private:
 
     Set<NodeID> prelabeledObjects;
 
+    /// Changed versions (o -> versions of o) whose propagation to reliant versions
+    /// waits for propagatePendingVersions. Only used with more than one propagation thread.
+    Map<NodeID, Set<Version>> pendingVersions;
+
     /// Points-to DS for working with versions.
     BVDataPTAImpl::VersionedPTDataTy *vPtD;
 
@@ -232,6 +247,12 @@ private:
     double prelabelingTime;  ///< Time to prelabel SVFG.
     double meldLabelingTime; ///< Time to meld label SVFG.
     double versionPropTime;  ///< Time to propagate versions to versions which rely on them.
+
+    u32_t numMeldSteals;         ///< Objects stolen from another versioning thread.
+    u32_t maxMeldObjsPerThread;  ///< Most objects meld labeled by one versioning thread.
+    u32_t minMeldObjsPerThread;  ///< Fewest objects meld labeled by one versioning thread.
+    u32_t numVersionLockStripes; ///< Locks guarding consume/yield updates during meld labeling.
+    u32_t numVersionPropRounds;  ///< Number of (parallel) propagatePendingVersions rounds.
     //@}
 
     static VersionedFlowSensitive *vfspta;
@@ -4,6 +4,7 @@
 #include "Util/SVFUtil.h"
 #include "Graphs/ICFG.h"
 #include "SVFIR/SVFIR.h"
+#include "Util/WorkStealing.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -99,18 +100,12 @@ void CHGraph::getVFnsFromVtbls(const CallICFGNode* callsite, const VTableSet &vt
     /// get target virtual functions
     size_t idx = callsite->getFunIdxInVtable();
     /// get the function name of the virtual callsite
-    string funName = callsite->getFunNameOfVirtualCall();
+    const string& funName = callsite->getFunNameOfVirtualCall();
     for (const GlobalObjVar *vt : vtbls)
     {
-        const CHNode *child = getNode(vt->getName());
-        if (child == nullptr)
-            continue;
-        CHNode::FuncVector vfns;
-        child->getVirtualFunctions(idx, vfns);
-        for (CHNode::FuncVector::const_iterator fit = vfns.begin(),
-                feit = vfns.end(); fit != feit; ++fit)
+        for (const VFnTarget& target : getVFnTargets(vt, idx))
         {
-            const FunObjVar* callee = *fit;
+            const FunObjVar* callee = target.callee;
             if (callsite->arg_size() == callee->arg_size() ||
                     (callsite->isVarArg() && callee->isVarArg()))
             {
@@ -120,21 +115,7 @@ void CHGraph::getVFnsFromVtbls(const CallICFGNode* callsite, const VTableSet &vt
                 if (!checkArgTypes(callsite, callee))
                     continue;
 
-                string calleeName = callee->getName();
-
-                /*
-                 * The compiler will add some special suffix (e.g.,
-                 * "[abi:cxx11]") to the end of some virtual function:
-                 * In dealII
-                 * function: FE_Q<3>::get_name
-                 * will be mangled as: _ZNK4FE_QILi3EE8get_nameB5cxx11Ev
-                 * after demangling: FE_Q<3>::get_name[abi:cxx11]
-                 * The special suffix ("[abi:cxx11]") needs to be removed
-                 */
-                const std::string suffix("[abi:cxx11]");
-                size_t suffix_pos = calleeName.rfind(suffix);
-                if (suffix_pos != string::npos)
-                    calleeName.erase(suffix_pos, suffix.size());
+                const string& calleeName = target.name;
 
                 /*
                  * if we can't get the function name of a virtual callsite, all virtual
@@ -177,6 +158,78 @@ void CHGraph::getVFnsFromVtbls(const CallICFGNode* callsite, const VTableSet &vt
     }
 }
 
+/*
+ * Collect the virtual functions at index "idx" of the vtables of the class
+ * of vtbl. This only reads the graph, so it may run on several threads.
+ */
+void CHGraph::collectVFnTargets(const GlobalObjVar* vtbl, u32_t idx, VFnTargets& targets) const
+{
+    const CHNode *child = getNode(vtbl->getName());
+    if (child == nullptr)
+        return;
+    CHNode::FuncVector vfns;
+    child->getVirtualFunctions(idx, vfns);
+    for (const FunObjVar* callee : vfns)
+    {
+        string calleeName = callee->getName();
+
+        /*
+         * The compiler will add some special suffix (e.g.,
+         * "[abi:cxx11]") to the end of some virtual function:
+         * In dealII
+         * function: FE_Q<3>::get_name
+         * will be mangled as: _ZNK4FE_QILi3EE8get_nameB5cxx11Ev
+         * after demangling: FE_Q<3>::get_name[abi:cxx11]
+         * The special suffix ("[abi:cxx11]") needs to be removed
+         */
+        const std::string suffix("[abi:cxx11]");
+        size_t suffix_pos = calleeName.rfind(suffix);
+        if (suffix_pos != string::npos)
+            calleeName.erase(suffix_pos, suffix.size());
+
+        targets.push_back({callee, calleeName});
+    }
+}
+
+const CHGraph::VFnTargets& CHGraph::getVFnTargets(const GlobalObjVar* vtbl, u32_t idx)
+{
+    VTableIdxPair key(vtbl, idx);
+    VTableIdxToVFnsMap::const_iterator it = vtblIdxToVFnsMap.find(key);
+    if (it != vtblIdxToVFnsMap.end())
+        return it->second;
+    VFnTargets& targets = vtblIdxToVFnsMap[key];
+    collectVFnTargets(vtbl, idx, targets);
+    return targets;
+}
+
+/*
+ * Fill the (vtable, index) -> virtual functions table for the pairs which
+ * virtual call sites refer to, so that resolving the call sites during
+ * call graph updates only looks them up.
+ */
+void CHGraph::buildVFnTargets(const std::vector<VTableIdxPair>& vtblIdxPairs, u32_t numThreads)
+{
+    std::vector<VTableIdxPair> todo;
+    for (const VTableIdxPair& key : vtblIdxPairs)
+    {
+        if (vtblIdxToVFnsMap.find(key) == vtblIdxToVFnsMap.end())
+            todo.push_back(key);
+    }
+    if (todo.empty())
+        return;
+
+    std::vector<VFnTargets> results(todo.size());
+    WorkStealingPool<size_t> pool(std::max(1u, std::min<unsigned>(numThreads, todo.size())));
+    for (size_t i = 0; i < todo.size(); ++i)
+        pool.push(i);
+    pool.run([this, &todo, &results](const size_t i, const unsigned)
+    {
+        collectVFnTargets(todo[i].first, todo[i].second, results[i]);
+    });
+
+    for (size_t i = 0; i < todo.size(); ++i)
+        vtblIdxToVFnsMap.emplace(todo[i], std::move(results[i]));
+}
 
 void CHNode::getVirtualFunctions(u32_t idx, FuncVector &virtualFunctions) const
 {
@@ -19,16 +19,16 @@ void ConstraintGraph::buildCG()
     }
 
     // initialize edges
-    SVFStmt::SVFStmtSetTy& addrs = getPAGEdgeSet(SVFStmt::Addr);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = addrs.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& addrs = getPAGEdgeSet(SVFStmt::Addr);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = addrs.begin(), eiter =
                 addrs.end(); iter != eiter; ++iter)
     {
         const AddrStmt* edge = SVFUtil::cast<AddrStmt>(*iter);
         addAddrCGEdge(edge->getRHSVarID(),edge->getLHSVarID());
     }
 
-    SVFStmt::SVFStmtSetTy& copys = getPAGEdgeSet(SVFStmt::Copy);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = copys.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& copys = getPAGEdgeSet(SVFStmt::Copy);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = copys.begin(), eiter =
                 copys.end(); iter != eiter; ++iter)
     {
         const CopyStmt* edge = SVFUtil::cast<CopyStmt>(*iter);
@@ -36,8 +36,8 @@ void ConstraintGraph::buildCG()
             addCopyCGEdge(edge->getRHSVarID(),edge->getLHSVarID());
     }
 
-    SVFStmt::SVFStmtSetTy& phis = getPAGEdgeSet(SVFStmt::Phi);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = phis.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& phis = getPAGEdgeSet(SVFStmt::Phi);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = phis.begin(), eiter =
                 phis.end(); iter != eiter; ++iter)
     {
         const PhiStmt* edge = SVFUtil::cast<PhiStmt>(*iter);
@@ -45,8 +45,8 @@ void ConstraintGraph::buildCG()
             addCopyCGEdge(opVar->getId(),edge->getResID());
     }
 
-    SVFStmt::SVFStmtSetTy& selects = getPAGEdgeSet(SVFStmt::Select);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = selects.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& selects = getPAGEdgeSet(SVFStmt::Select);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = selects.begin(), eiter =
                 selects.end(); iter != eiter; ++iter)
     {
         const SelectStmt* edge = SVFUtil::cast<SelectStmt>(*iter);
@@ -54,40 +54,40 @@ void ConstraintGraph::buildCG()
             addCopyCGEdge(opVar->getId(),edge->getResID());
     }
 
-    SVFStmt::SVFStmtSetTy& calls = getPAGEdgeSet(SVFStmt::Call);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = calls.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& calls = getPAGEdgeSet(SVFStmt::Call);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = calls.begin(), eiter =
                 calls.end(); iter != eiter; ++iter)
     {
         const CallPE* edge = SVFUtil::cast<CallPE>(*iter);
         addCopyCGEdge(edge->getRHSVarID(),edge->getLHSVarID());
     }
 
-    SVFStmt::SVFStmtSetTy& rets = getPAGEdgeSet(SVFStmt::Ret);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = rets.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& rets = getPAGEdgeSet(SVFStmt::Ret);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = rets.begin(), eiter =
                 rets.end(); iter != eiter; ++iter)
     {
         const RetPE* edge = SVFUtil::cast<RetPE>(*iter);
         addCopyCGEdge(edge->getRHSVarID(),edge->getLHSVarID());
     }
 
-    SVFStmt::SVFStmtSetTy& tdfks = getPAGEdgeSet(SVFStmt::ThreadFork);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = tdfks.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& tdfks = getPAGEdgeSet(SVFStmt::ThreadFork);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = tdfks.begin(), eiter =
                 tdfks.end(); iter != eiter; ++iter)
     {
         const TDForkPE* edge = SVFUtil::cast<TDForkPE>(*iter);
         addCopyCGEdge(edge->getRHSVarID(),edge->getLHSVarID());
     }
 
-    SVFStmt::SVFStmtSetTy& tdjns = getPAGEdgeSet(SVFStmt::ThreadJoin);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = tdjns.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& tdjns = getPAGEdgeSet(SVFStmt::ThreadJoin);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = tdjns.begin(), eiter =
                 tdjns.end(); iter != eiter; ++iter)
     {
         const TDJoinPE* edge = SVFUtil::cast<TDJoinPE>(*iter);
         addCopyCGEdge(edge->getRHSVarID(),edge->getLHSVarID());
     }
 
-    SVFStmt::SVFStmtSetTy& ngeps = getPAGEdgeSet(SVFStmt::Gep);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = ngeps.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& ngeps = getPAGEdgeSet(SVFStmt::Gep);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = ngeps.begin(), eiter =
                 ngeps.end(); iter != eiter; ++iter)
     {
         GepStmt* edge = SVFUtil::cast<GepStmt>(*iter);
@@ -97,16 +97,16 @@ void ConstraintGraph::buildCG()
             addNormalGepCGEdge(edge->getRHSVarID(),edge->getLHSVarID(),edge->getAccessPath());
     }
 
-    SVFStmt::SVFStmtSetTy& loads = getPAGEdgeSet(SVFStmt::Load);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = loads.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& loads = getPAGEdgeSet(SVFStmt::Load);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = loads.begin(), eiter =
                 loads.end(); iter != eiter; ++iter)
     {
         LoadStmt* edge = SVFUtil::cast<LoadStmt>(*iter);
         addLoadCGEdge(edge->getRHSVarID(),edge->getLHSVarID(),0);
     }
 
-    SVFStmt::SVFStmtSetTy& stores = getPAGEdgeSet(SVFStmt::Store);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = stores.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& stores = getPAGEdgeSet(SVFStmt::Store);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = stores.begin(), eiter =
                 stores.end(); iter != eiter; ++iter)
     {
         StoreStmt* edge = SVFUtil::cast<StoreStmt>(*iter);
@@ -146,11 +146,79 @@ void ConstraintGraph::clearSolitaries()
         removeConstraintNode(node);
 }
 
+u32_t ConstraintGraph::numLiveGraphs = 0;
+
 /*!
- * Memory has been cleaned up at GenericGraph
+ * Release nodes (and with them their outgoing edges) here rather than in
+ * GenericGraph so that the arenas can drop their slabs once the last
+ * constraint graph is gone.
+ *
+ * The last graph owns every object left in the arenas, so its edges are
+ * not deleted one by one: only the access paths of normal gep edges are
+ * destroyed, and the edge slabs are then dropped at once. Nodes are still
+ * deleted since their edge sets and bit vectors own memory.
  */
 void ConstraintGraph::destroy()
 {
+    static_assert(sizeof(NormalGepCGEdge) <= TypedArena<ConstraintEdge>::MaxObjectSize,
+                  "constraint edges must be allocated from the edge slabs");
+
+    assert(numLiveGraphs > 0 && "destroying a constraint graph twice?");
+    --numLiveGraphs;
+    const bool dropEdges = getEdgeArena().isEnabled() && numLiveGraphs == 0;
+    for (auto& entry : IDToNodeMap)
+    {
+        ConstraintNode* node = entry.second;
+        if (dropEdges)
+        {
+            for (ConstraintEdge* edge : node->getOutEdges())
+            {
+                if (NormalGepCGEdge* gep = SVFUtil::dyn_cast<NormalGepCGEdge>(edge))
+                    gep->~NormalGepCGEdge();
+            }
+            node->dropOutEdges();
+        }
+        delete node;
+    }
+    IDToNodeMap.clear();
+
+    if (dropEdges)
+        getEdgeArena().reset();
+    else
+        getEdgeArena().release();
+    getNodeArena().release();
+}
+
+TypedArena<ConstraintNode>& ConstraintGraph::getNodeArena()
+{
+    static TypedArena<ConstraintNode> arena(Options::ConsGArena());
+    return arena;
+}
+
+TypedArena<ConstraintEdge>& ConstraintGraph::getEdgeArena()
+{
+    static TypedArena<ConstraintEdge> arena(Options::ConsGArena());
+    return arena;
+}
+
+void* ConstraintNode::operator new(size_t size)
+{
+    return ConstraintGraph::getNodeArena().allocate(size);
+}
+
+void ConstraintNode::operator delete(void* ptr, size_t size)
+{
+    ConstraintGraph::getNodeArena().deallocate(ptr, size);
+}
+
+void* ConstraintEdge::operator new(size_t size)
+{
+    return ConstraintGraph::getEdgeArena().allocate(size);
+}
+
+void ConstraintEdge::operator delete(void* ptr, size_t size)
+{
+    ConstraintGraph::getEdgeArena().deallocate(ptr, size);
 }
 
 /*!
@@ -297,6 +365,52 @@ StoreCGEdge* ConstraintGraph::addStoreCGEdge(NodeID src, NodeID dst, NodeID fsID
 }
 
 
+/*!
+ * Renumber nodes
+ */
+void ConstraintGraph::renumberNodes(const Map<NodeID, NodeID>& newIDs, const NodeBS& removed)
+{
+    auto mapID = [&newIDs](NodeID id)
+    {
+        Map<NodeID, NodeID>::const_iterator it = newIDs.find(id);
+        return it == newIDs.end() ? id : it->second;
+    };
+
+    IDToNodeMapTy renumbered;
+    for (auto& entry : IDToNodeMap)
+    {
+        ConstraintNode* node = entry.second;
+        assert(!removed.test(entry.first) && "removed node still on the graph?");
+        node->setId(mapID(entry.first));
+        renumbered.emplace_hint(renumbered.end(), node->getId(), node);
+    }
+    IDToNodeMap = std::move(renumbered);
+
+    NodeToRepMap newNodeToRepMap;
+    for (const auto& it : nodeToRepMap)
+    {
+        if (removed.test(it.first))
+            continue;
+        assert(!removed.test(it.second) && "rep node has been removed?");
+        newNodeToRepMap[mapID(it.first)] = mapID(it.second);
+    }
+    nodeToRepMap = std::move(newNodeToRepMap);
+
+    NodeToSubsMap newNodeToSubsMap;
+    for (const auto& it : nodeToSubsMap)
+    {
+        if (removed.test(it.first))
+            continue;
+        NodeBS& subs = newNodeToSubsMap[mapID(it.first)];
+        for (NodeID sub : it.second)
+        {
+            if (!removed.test(sub))
+                subs.set(mapID(sub));
+        }
+    }
+    nodeToSubsMap = std::move(newNodeToSubsMap);
+}
+
 /*!
  * Re-target dst node of an edge
  *
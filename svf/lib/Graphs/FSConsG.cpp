@@ -319,69 +319,157 @@ void FSConsG::buildSVFG2CG(SVFG* svfg)
 
     }
 
-    /// connect indirect constraint edges
+    /// connect indirect constraint edges, grouped by their shared label so
+    /// that each distinct points-to set is iterated only once
+    OrderedMap<PointsToID, std::vector<IndirectSVFGEdge*>> labelToEdges;
     for (IndirectSVFGEdge* edge : svfg->indirectEdgeSet)
+        labelToEdges[edge->getPointsToId()].push_back(edge);
+    for (const auto& labelEdges : labelToEdges)
     {
-        auto srcIndirect = edge->getSrcID(); // SrcSVFGID
-        auto dstIndirect = edge->getDstID(); // DstSVFGID
-        for (NodeID i : edge->getPointsTo())
+        const NodeBS& pts = IndirectSVFGEdge::getLabelCache().getActualPts(labelEdges.first);
+        for (NodeID i : pts)
         {
-            if (!hasConstraintNodePair(i, srcIndirect))
+            for (IndirectSVFGEdge* edge : labelEdges.second)
             {
-                totalCGNode++;
-                NodeID src = totalCGNode;
-                auto srcsvfgID = srcIndirect;
-                insertConstraintMapping(i, srcsvfgID, src);
-                // pairToidMap[NodePair(i, srcsvfgID)] = src;
-                // idTopairMap[src] = NodePair(i, srcsvfgID);
-                // SVFGNode* srcNodeType = svfg->getSVFGNode(srcsvfgID);
-                // initialPts(src);
-                addConstraintNode(new ConstraintNode(src), src);
-                //if it is a load node
-                if (SVFUtil::isa<LoadSVFGNode>(svfg->getSVFGNode(srcsvfgID)))
+                auto srcIndirect = edge->getSrcID(); // SrcSVFGID
+                auto dstIndirect = edge->getDstID(); // DstSVFGID
+                if (!hasConstraintNodePair(i, srcIndirect))
                 {
-                    NumberOfLoad++;
-                }
-                //if it is a store node
-                if (SVFUtil::isa<StoreSVFGNode>(svfg->getSVFGNode(srcsvfgID)))
-                {
-                    NumberOfStore++;
+                    totalCGNode++;
+                    NodeID src = totalCGNode;
+                    auto srcsvfgID = srcIndirect;
+                    insertConstraintMapping(i, srcsvfgID, src);
+                    // pairToidMap[NodePair(i, srcsvfgID)] = src;
+                    // idTopairMap[src] = NodePair(i, srcsvfgID);
+                    // SVFGNode* srcNodeType = svfg->getSVFGNode(srcsvfgID);
+                    // initialPts(src);
+                    addConstraintNode(new ConstraintNode(src), src);
+                    //if it is a load node
+                    if (SVFUtil::isa<LoadSVFGNode>(svfg->getSVFGNode(srcsvfgID)))
+                    {
+                        NumberOfLoad++;
+                    }
+                    //if it is a store node
+                    if (SVFUtil::isa<StoreSVFGNode>(svfg->getSVFGNode(srcsvfgID)))
+                    {
+                        NumberOfStore++;
+                    }
                 }
-            }
 
-            if (!hasConstraintNodePair(i, dstIndirect))
-            {
-                totalCGNode++;
-                NodeID dst = totalCGNode;
-                auto dstsvfgID = dstIndirect;
-                insertConstraintMapping(i, dstsvfgID, dst);
-                // pairToidMap[NodePair(i, dstsvfgID)] = dst;
-                // idTopairMap[dst] = NodePair(i, dstsvfgID);
-                // SVFGNode* dstNodeType = svfg->getSVFGNode(dstsvfgID);
-                // initialPts(dst);
-                addConstraintNode(new ConstraintNode(dst), dst);
-                //if it is a load node
-                if (SVFUtil::isa<LoadSVFGNode>(svfg->getSVFGNode(dstsvfgID)))
+                if (!hasConstraintNodePair(i, dstIndirect))
                 {
-                    NumberOfLoad++;
+                    totalCGNode++;
+                    NodeID dst = totalCGNode;
+                    auto dstsvfgID = dstIndirect;
+                    insertConstraintMapping(i, dstsvfgID, dst);
+                    // pairToidMap[NodePair(i, dstsvfgID)] = dst;
+                    // idTopairMap[dst] = NodePair(i, dstsvfgID);
+                    // SVFGNode* dstNodeType = svfg->getSVFGNode(dstsvfgID);
+                    // initialPts(dst);
+                    addConstraintNode(new ConstraintNode(dst), dst);
+                    //if it is a load node
+                    if (SVFUtil::isa<LoadSVFGNode>(svfg->getSVFGNode(dstsvfgID)))
+                    {
+                        NumberOfLoad++;
+                    }
+                    //if it is a store node
+                    if (SVFUtil::isa<StoreSVFGNode>(svfg->getSVFGNode(dstsvfgID)))
+                    {
+                        NumberOfStore++;
+                    }
                 }
-                //if it is a store node
-                if (SVFUtil::isa<StoreSVFGNode>(svfg->getSVFGNode(dstsvfgID)))
+
+                NodeID srcNode = pairToidMap[NodePair(i, srcIndirect)];
+                NodeID dstNode = pairToidMap[NodePair(i, dstIndirect)];
+                // number of initial copy
+                if (addCopyCGEdge(srcNode, dstNode))
                 {
-                    NumberOfStore++;
+                    NumberOfInitialCopy++;
                 }
             }
+        }
+    }
+}
 
-            NodeID srcNode = pairToidMap[NodePair(i, srcIndirect)];
-            NodeID dstNode = pairToidMap[NodePair(i, dstIndirect)];
-            // number of initial copy
-            if (addCopyCGEdge(srcNode, dstNode))
-            {
-                NumberOfInitialCopy++;
-            }
+/*!
+ * Compact the IDs of versioned (PAG node, SVFG node) nodes
+ */
+bool FSConsG::compactNodeIDs(NodeToNodeMap& movedIDs, NodeBS& removedIDs)
+{
+    NodeBS versioned;
+    NodeBS live;
+    for (const IDToPairMap::value_type& it : idTopairMap)
+    {
+        if (it.first == it.second.first)
+            continue;
+        versioned.set(it.first);
+        if (hasGNode(it.first))
+            live.set(it.first);
+        else
+            removedIDs.set(it.first);
+    }
+
+    if (versioned.empty() || removedIDs.count() * 4 < versioned.count())
+    {
+        removedIDs.clear();
+        return false;
+    }
+
+    /// Versioned nodes are allocated past the SVFIR. If other nodes have since been
+    /// placed within their range (e.g., field objects), renumbering would reorder
+    /// nodes and break the ordered edge sets, so give up.
+    NodeID first = versioned.find_first();
+    NodeID last = versioned.find_last();
+    for (IDToNodeMapTy::const_iterator it = IDToNodeMap.lower_bound(first), eit = IDToNodeMap.end();
+            it != eit && it->first <= last; ++it)
+    {
+        if (!versioned.test(it->first))
+        {
+            removedIDs.clear();
+            return false;
         }
     }
 
+    NodeID next = first;
+    for (NodeID id : live)
+    {
+        if (id != next)
+            movedIDs[id] = next;
+        ++next;
+    }
+
+    /// Pairs of merged-away nodes will map straight to their rep.
+    for (PairToIDMap::value_type& it : pairToidMap)
+        it.second = sccRepNode(it.second);
+
+    renumberNodes(movedIDs, removedIDs);
+
+    auto mapID = [&movedIDs](NodeID id)
+    {
+        NodeToNodeMap::const_iterator it = movedIDs.find(id);
+        return it == movedIDs.end() ? id : it->second;
+    };
+
+    IDToPairMap newIdTopairMap;
+    NodeToNodeMap newCompactedToOriginal;
+    for (const IDToPairMap::value_type& it : idTopairMap)
+    {
+        if (removedIDs.test(it.first))
+            continue;
+        NodeID newId = mapID(it.first);
+        newIdTopairMap[newId] = it.second;
+        NodeID orig = getOriginalID(it.first);
+        if (orig != newId)
+            newCompactedToOriginal[newId] = orig;
+    }
+    idTopairMap = std::move(newIdTopairMap);
+    compactedToOriginal = std::move(newCompactedToOriginal);
+
+    for (PairToIDMap::value_type& it : pairToidMap)
+        it.second = mapID(it.second);
+
+    totalCGNode = next - 1;
+    return true;
 }
 
 /*!
@@ -236,13 +236,43 @@ bool IRGraph::addEdge(SVFVar* src, SVFVar* dst, SVFStmt* edge)
 }
 
 /*!
- * Return true if it is an intra-procedural edge
+ * Sort the statement tables once all statements are added; statements added
+ * later are inserted in order, so reading a table (possibly from several
+ * threads) never modifies it. Empty edge sets which lookups by kind left in
+ * the variables are dropped as well.
+ */
+void IRGraph::compactStorage()
+{
+    for (auto& it : KindToSVFStmtSetMap)
+        it.second.compact();
+    for (auto& it : KindToPTASVFStmtSetMap)
+        it.second.compact();
+    storageCompacted = true;
+    for (auto& it : *this)
+    {
+        SVFVar* var = it.second;
+        for (SVFStmt::KindToSVFStmtMapTy* edgeMap : {&var->InEdgeKindToSetMap, &var->OutEdgeKindToSetMap})
+        {
+            for (auto eit = edgeMap->begin(); eit != edgeMap->end();)
+            {
+                if (eit->second.empty())
+                    eit = edgeMap->erase(eit);
+                else
+                    ++eit;
+            }
+        }
+    }
+}
+
+/*!
+ * Search the outgoing edges of src, which are ordered by flag (kind and label),
+ * src and dst
  */
 SVFStmt* IRGraph::hasNonlabeledEdge(SVFVar* src, SVFVar* dst, SVFStmt::PEDGEK kind)
 {
     SVFStmt edge(src,dst,kind, false);
-    SVFStmt::SVFStmtSetTy::iterator it = KindToSVFStmtSetMap[kind].find(&edge);
-    if (it != KindToSVFStmtSetMap[kind].end())
+    SVFStmt::SVFStmtSetTy::const_iterator it = src->getOutEdges().find(&edge);
+    if (it != src->getOutEdges().end())
     {
         return *it;
     }
@@ -255,8 +285,8 @@ SVFStmt* IRGraph::hasNonlabeledEdge(SVFVar* src, SVFVar* dst, SVFStmt::PEDGEK ki
 SVFStmt* IRGraph::hasLabeledEdge(SVFVar* src, SVFVar* op1, SVFStmt::PEDGEK kind, const SVFVar* op2)
 {
     SVFStmt edge(src,op1,SVFStmt::makeEdgeFlagWithAddionalOpnd(kind,op2), false);
-    SVFStmt::SVFStmtSetTy::iterator it = KindToSVFStmtSetMap[kind].find(&edge);
-    if (it != KindToSVFStmtSetMap[kind].end())
+    SVFStmt::SVFStmtSetTy::const_iterator it = src->getOutEdges().find(&edge);
+    if (it != src->getOutEdges().end())
     {
         return *it;
     }
@@ -269,8 +299,8 @@ SVFStmt* IRGraph::hasLabeledEdge(SVFVar* src, SVFVar* op1, SVFStmt::PEDGEK kind,
 SVFStmt* IRGraph::hasLabeledEdge(SVFVar* src, SVFVar* dst, SVFStmt::PEDGEK kind, const ICFGNode* callInst)
 {
     SVFStmt edge(src,dst,SVFStmt::makeEdgeFlagWithCallInst(kind,callInst), false);
-    SVFStmt::SVFStmtSetTy::iterator it = KindToSVFStmtSetMap[kind].find(&edge);
-    if (it != KindToSVFStmtSetMap[kind].end())
+    SVFStmt::SVFStmtSetTy::const_iterator it = src->getOutEdges().find(&edge);
+    if (it != src->getOutEdges().end())
     {
         return *it;
     }
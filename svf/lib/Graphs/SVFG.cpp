@@ -14,6 +14,12 @@
 using namespace SVF;
 using namespace SVFUtil;
 
+IndirectSVFGEdge::LabelCache& IndirectSVFGEdge::getLabelCache()
+{
+    static LabelCache labels;
+    return labels;
+}
+
 const NodeBS MRSVFGNode::getDefSVFVars() const
 {
     return getPointsTo();
@@ -174,19 +180,28 @@ FormalOUTSVFGNode::FormalOUTSVFGNode(NodeID id, const MRVer* mrVer, const FunExi
 /*!
  * Constructor
  */
+u32_t SVFG::numLiveSVFGs = 0;
+
 SVFG::SVFG(std::unique_ptr<MemSSA> mssa, VFGK k): VFG(mssa->getPTA()->getCallGraph(),k),mssa(std::move(mssa)), pta(this->mssa->getPTA())
 {
     stat = new SVFGStat(this);
+    ++numLiveSVFGs;
 }
 
 /*!
- * Memory has been cleaned up at GenericGraph
+ * Memory has been cleaned up at GenericGraph.
+ * Labels of indirect edges are interned across SVFGs, so the label cache is
+ * only emptied with the last SVFG.
  */
 void SVFG::destroy()
 {
     delete stat;
     stat = nullptr;
     clearMSSA();
+
+    assert(numLiveSVFGs > 0 && "destroying an SVFG twice?");
+    if (--numLiveSVFGs == 0)
+        IndirectSVFGEdge::getLabelCache().reset();
 }
 
 /*!
@@ -229,8 +244,8 @@ void SVFG::addSVFGNodesForAddrTakenVars()
 {
 
     // set defs for address-taken vars defined at store statements
-    SVFStmt::SVFStmtSetTy& stores = getPAGEdgeSet(SVFStmt::Store);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = stores.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& stores = getPAGEdgeSet(SVFStmt::Store);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = stores.begin(), eiter =
                 stores.end(); iter != eiter; ++iter)
     {
         StoreStmt* store = SVFUtil::cast<StoreStmt>(*iter);
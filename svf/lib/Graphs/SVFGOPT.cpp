@@ -1,6 +1,7 @@
 
 
 #include "Util/Options.h"
+#include "Util/WorkStealing.h"
 #include "Graphs/SVFGOPT.h"
 #include "Graphs/SVFGStat.h"
 
@@ -12,6 +13,15 @@ static std::string KeepContextSelfCycle = "context";
 static std::string KeepNoneSelfCycle = "none";
 
 
+/// Number of edges of a graph
+static u32_t countEdges(const SVFG& g)
+{
+    u32_t num = 0;
+    for (SVFG::const_iterator it = g.begin(), eit = g.end(); it != eit; ++it)
+        num += it->second->getInEdges().size();
+    return num;
+}
+
 void SVFGOPT::buildSVFG()
 {
     SVFG::buildSVFG();
@@ -23,12 +33,16 @@ void SVFGOPT::buildSVFG()
 
     keepActualOutFormalIn = Options::KeepAOFI();
 
+    u32_t nodesBefore = getTotalNodeNum();
+    u32_t edgesBefore = countEdges(*this);
+
     stat->sfvgOptStart();
     handleInterValueFlow();
 
     handleIntraValueFlow();
     stat->sfvgOptEnd();
 
+    stat->setOptRemoved(nodesBefore - getTotalNodeNum(), edgesBefore - countEdges(*this));
 }
 /*!
  *
@@ -68,6 +82,21 @@ void SVFGOPT::handleInterValueFlow()
             candidates.insert(node);
     }
 
+    /// Actual-ins/formal-outs do not depend on each other, so all of them
+    /// can be retargeted up front
+    bool aInFOutRetargeted = false;
+    if (Options::SVFGOptThreads() > 1)
+    {
+        std::vector<SVFGNode*> aInFOuts;
+        for (SVFGNodeIDToNodeMapTy::iterator it = SVFG::begin(), eit = SVFG::end(); it != eit; ++it)
+        {
+            if (SVFUtil::isa<ActualINSVFGNode, FormalOUTSVFGNode>(it->second))
+                aInFOuts.push_back(it->second);
+        }
+        retargetEdgesOfAInFOutInParallel(aInFOuts);
+        aInFOutRetargeted = true;
+    }
+
     SVFGNodeSet nodesToBeDeleted;
     for (SVFGNodeSet::const_iterator it = candidates.begin(), eit = candidates.end();
             it!=eit; ++it)
@@ -89,7 +118,8 @@ void SVFGOPT::handleInterValueFlow()
         }
         else if (SVFUtil::isa<ActualINSVFGNode, FormalOUTSVFGNode>(node))
         {
-            retargetEdgesOfAInFOut(node);
+            if (aInFOutRetargeted == false)
+                retargetEdgesOfAInFOut(node);
             nodesToBeDeleted.insert(node);
         }
         else if (SVFUtil::isa<ActualOUTSVFGNode, FormalINSVFGNode>(node))
@@ -171,27 +201,26 @@ void SVFGOPT::replaceFParamARetWithPHI(PHISVFGNode* phi, SVFGNode* svfgNode)
  */
 void SVFGOPT::retargetEdgesOfAInFOut(SVFGNode* node)
 {
-    assert(node->getInEdges().size() == 1 && "actual-in/formal-out can only have one incoming edge as its def size");
+    AInFOutBypass bypass;
+    bypass.node = node;
+    collectAInFOutBypass(bypass);
+    applyAInFOutBypass(bypass);
+}
 
-    SVFGNode* def = nullptr;
-    NodeBS inPointsTo;
+/*!
+ * Only the node's own edges are read, so actual-ins/formal-outs of different
+ * functions can be collected concurrently.
+ */
+void SVFGOPT::collectAInFOutBypass(AInFOutBypass& bypass) const
+{
+    const SVFGNode* node = bypass.node;
+    assert(node->getInEdges().size() == 1 && "actual-in/formal-out can only have one incoming edge as its def size");
 
-    SVFGNode::const_iterator it = node->InEdgeBegin();
-    SVFGNode::const_iterator eit = node->InEdgeEnd();
-    for (; it != eit; ++it)
-    {
-        const IndirectSVFGEdge* inEdge = SVFUtil::cast<IndirectSVFGEdge>(*it);
-        inPointsTo = inEdge->getPointsTo();
-
-        def = inEdge->getSrcNode();
-        if (SVFUtil::isa<ActualINSVFGNode>(node))
-            setActualINDef(node->getId(), def->getId());
-        else if (SVFUtil::isa<FormalOUTSVFGNode>(node))
-            setFormalOUTDef(node->getId(), def->getId());
-    }
+    const IndirectSVFGEdge* inEdge = SVFUtil::cast<IndirectSVFGEdge>(*node->InEdgeBegin());
+    const NodeBS& inPointsTo = inEdge->getPointsTo();
+    bypass.def = inEdge->getSrcNode();
 
-    it = node->OutEdgeBegin(), eit = node->OutEdgeEnd();
-    for (; it != eit; ++it)
+    for (SVFGNode::const_iterator it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it != eit; ++it)
     {
         const IndirectSVFGEdge* outEdge = SVFUtil::cast<IndirectSVFGEdge>(*it);
         NodeBS intersection = inPointsTo;
@@ -200,18 +229,77 @@ void SVFGOPT::retargetEdgesOfAInFOut(SVFGNode* node)
         if (intersection.empty())
             continue;
 
-        SVFGNode* dstNode = outEdge->getDstNode();
+        NodeID dstId = outEdge->getDstID();
         if (const CallIndSVFGEdge* callEdge = SVFUtil::dyn_cast<CallIndSVFGEdge>(outEdge))
-            addCallIndirectSVFGEdge(def->getId(), dstNode->getId(), callEdge->getCallSiteId(), intersection);
+            bypass.edges.push_back({dstId, true, callEdge->getCallSiteId(), intersection});
         else if (const RetIndSVFGEdge* retEdge = SVFUtil::dyn_cast<RetIndSVFGEdge>(outEdge))
-            addRetIndirectSVFGEdge(def->getId(), dstNode->getId(), retEdge->getCallSiteId(), intersection);
+            bypass.edges.push_back({dstId, false, retEdge->getCallSiteId(), intersection});
         else
             assert(false && "expecting an inter-procedural SVFG edge");
     }
+}
+
+void SVFGOPT::applyAInFOutBypass(const AInFOutBypass& bypass)
+{
+    SVFGNode* node = bypass.node;
+    NodeID defId = bypass.def->getId();
+    if (SVFUtil::isa<ActualINSVFGNode>(node))
+        setActualINDef(node->getId(), defId);
+    else if (SVFUtil::isa<FormalOUTSVFGNode>(node))
+        setFormalOUTDef(node->getId(), defId);
+
+    for (const BypassEdge& edge : bypass.edges)
+    {
+        if (edge.isCall)
+            addCallIndirectSVFGEdge(defId, edge.dst, edge.csId, edge.cpts);
+        else
+            addRetIndirectSVFGEdge(defId, edge.dst, edge.csId, edge.cpts);
+    }
 
     removeAllEdges(node);
 }
 
+void SVFGOPT::retargetEdgesOfAInFOutInParallel(const std::vector<SVFGNode*>& nodes)
+{
+    double start = stat->getClk(true);
+
+    /// Partition the nodes by function, functions in order of their first node
+    Map<const FunObjVar*, u32_t> funToPart;
+    std::vector<std::vector<AInFOutBypass>> parts;
+    for (SVFGNode* node : nodes)
+    {
+        auto inserted = funToPart.emplace(node->getFun(), parts.size());
+        if (inserted.second)
+            parts.emplace_back();
+        AInFOutBypass bypass;
+        bypass.node = node;
+        parts[inserted.first->second].push_back(bypass);
+    }
+
+    std::vector<double> workerTime(Options::SVFGOptThreads(), 0);
+    WorkStealingPool<u32_t> pool(Options::SVFGOptThreads());
+    for (u32_t i = 0; i < parts.size(); ++i)
+        pool.push(i);
+    pool.run([&](u32_t i, unsigned thread)
+    {
+        double partStart = stat->getClk(true);
+        for (AInFOutBypass& bypass : parts[i])
+            collectAInFOutBypass(bypass);
+        workerTime[thread] += stat->getClk(true) - partStart;
+    });
+
+    for (const std::vector<AInFOutBypass>& part : parts)
+    {
+        for (const AInFOutBypass& bypass : part)
+            applyAInFOutBypass(bypass);
+    }
+
+    double totalWorkerTime = 0;
+    for (double t : workerTime)
+        totalWorkerTime += t;
+    stat->addOptBypassTime(stat->getClk(true) - start, totalWorkerTime);
+}
+
 /*!
  *
  */
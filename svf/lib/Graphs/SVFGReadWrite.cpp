@@ -6,6 +6,7 @@
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include <fstream>
 #include "Util/Options.h"
+#include "Util/BinaryFile.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -18,6 +19,12 @@ using namespace std;
 // srcSVFGNodeID: <id> => dstSVFGNodeID: <id> >= <edge type> | MVER: {MRVERID: <id> MemRegion: pts{<pts> } MRVERSION: <version> MSSADef: <version>, pts{<pts> }}
 void SVFG::writeToFile(const string& filename)
 {
+    if (!Options::WriteSVFGText())
+    {
+        writeBinaryToFile(filename);
+        return;
+    }
+
     outs() << "Writing SVFG analysis to '" << filename << "'...";
     error_code err;
     std::fstream f(filename.c_str(), std::ios_base::out);
@@ -178,6 +185,12 @@ void SVFG::writeToFile(const string& filename)
 
 void SVFG::readFile(const string& filename)
 {
+    if (isBinarySVFGFile(filename))
+    {
+        readBinaryFile(filename);
+        return;
+    }
+
     outs() << "Loading SVFG analysis results from '" << filename << "'...";
     ifstream F(filename.c_str());
     if (!F.is_open())
@@ -186,8 +199,8 @@ void SVFG::readFile(const string& filename)
         return;
     }
 
-    PAGEdge::PAGEdgeSetTy& stores = getPAGEdgeSet(PAGEdge::Store);
-    for (PAGEdge::PAGEdgeSetTy::iterator iter = stores.begin(), eiter =
+    PAGEdge::SVFStmtTableTy& stores = getPAGEdgeSet(PAGEdge::Store);
+    for (PAGEdge::SVFStmtTableTy::iterator iter = stores.begin(), eiter =
                 stores.end(); iter != eiter; ++iter)
     {
         StoreStmt* store = SVFUtil::cast<StoreStmt>(*iter);
@@ -449,4 +462,408 @@ MRVer* SVFG::getMRVERFromString(const string& s)
     // create mrver
     tempMRVer = new MRVer(tempMemRegion, obj2, tempDef);
     return tempMRVer;
-}
\ No newline at end of file
+}
+// Binary format (host byte order, arrays aligned to 8 bytes)
+// header:    magic, version, #sets, #elements, #versions, #nodes, #op versions, #edges
+// sets:      setBegin[#sets + 1], elements[#elements]
+// versions:  {set, SSA version, def type}[#versions]
+// nodes:     {id, kind, ICFG node, version, first op, #ops}[#nodes]
+// ops:       {phi operand position, version}[#op versions]
+// edges:     {src, dst, kind, set of an intra edge}[#edges]
+// Points-to sets of memory regions and of intra-procedural indirect edges
+// share the set table, so each distinct set is stored only once.
+static const u32_t SVFGFileMagic = 0x47465653;
+static const u32_t SVFGFileVersion = 1;
+
+namespace
+{
+
+enum SVFGFileNodeKind
+{
+    FormalINRecord, FormalOUTRecord, ActualINRecord, ActualOUTRecord, PHIRecord
+};
+
+enum SVFGFileEdgeKind
+{
+    IntraIndRecord, CallIndRecord, RetIndRecord
+};
+
+struct SVFGVerRecord
+{
+    u32_t set;
+    u32_t version;
+    u32_t defType;
+};
+
+struct SVFGNodeRecord
+{
+    NodeID id;
+    u32_t kind;
+    NodeID icfgNode;
+    u32_t ver;
+    u32_t opBegin;
+    u32_t opNum;
+};
+
+struct SVFGOpVerRecord
+{
+    u32_t pos;
+    u32_t ver;
+};
+
+struct SVFGEdgeRecord
+{
+    NodeID src;
+    NodeID dst;
+    u32_t kind;
+    u32_t label;
+};
+
+/// Whether a node of this kind can be attached to icfgNode
+bool isValidICFGNodeOf(u32_t kind, const ICFGNode* icfgNode)
+{
+    switch (kind)
+    {
+    case FormalINRecord:
+        return SVFUtil::isa<FunEntryICFGNode>(icfgNode);
+    case FormalOUTRecord:
+        return SVFUtil::isa<FunExitICFGNode>(icfgNode);
+    case ActualINRecord:
+    case ActualOUTRecord:
+        return SVFUtil::isa<CallICFGNode>(icfgNode);
+    default:
+        return true;
+    }
+}
+
+/// Distinct points-to sets and memory SSA versions of a binary SVFG file
+class SVFGFileTables
+{
+public:
+    u32_t getSet(const NodeBS& pts)
+    {
+        auto inserted = setToIndex.emplace(pts, setBegin.size());
+        if (inserted.second)
+        {
+            setBegin.push_back(elements.size());
+            for (NodeID n : pts)
+                elements.push_back(n);
+        }
+        return inserted.first->second;
+    }
+
+    u32_t getVer(const MRVer* ver)
+    {
+        auto it = verToIndex.find(ver);
+        if (it != verToIndex.end())
+            return it->second;
+        SVFGVerRecord rec = {getSet(ver->getMR()->getPointsTo()), ver->getSSAVersion(),
+                             static_cast<u32_t>(ver->getDef()->getType())
+                            };
+        verToIndex[ver] = vers.size();
+        vers.push_back(rec);
+        return vers.size() - 1;
+    }
+
+    Map<NodeBS, u32_t> setToIndex;
+    std::vector<u32_t> setBegin;
+    std::vector<NodeID> elements;
+    Map<const MRVer*, u32_t> verToIndex;
+    std::vector<SVFGVerRecord> vers;
+};
+
+}
+
+bool SVFG::isBinarySVFGFile(const string& filename)
+{
+    ifstream F(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    u32_t magic = 0;
+    return F.read(reinterpret_cast<char*>(&magic), sizeof(magic)) && magic == SVFGFileMagic;
+}
+
+/*!
+ * Write the memory SSA nodes and all indirect edges in the binary format.
+ * Top-level nodes and direct edges are rebuilt from the SVFIR on loading.
+ */
+void SVFG::writeBinaryToFile(const string& filename)
+{
+    outs() << "Writing SVFG analysis to '" << filename << "'...";
+
+    SVFGFileTables tables;
+    std::vector<SVFGNodeRecord> nodes;
+    std::vector<SVFGOpVerRecord> opVers;
+    std::vector<SVFGEdgeRecord> edges;
+    for (const_iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        const SVFGNode* node = it->second;
+        SVFGNodeRecord rec = {it->first, 0, 0, 0, static_cast<u32_t>(opVers.size()), 0};
+        if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+        {
+            rec.kind = FormalINRecord;
+            rec.icfgNode = formalIn->getFunEntryNode()->getId();
+            rec.ver = tables.getVer(formalIn->getMRVer());
+        }
+        else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+        {
+            rec.kind = FormalOUTRecord;
+            rec.icfgNode = formalOut->getFunExitNode()->getId();
+            rec.ver = tables.getVer(formalOut->getMRVer());
+        }
+        else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+        {
+            rec.kind = ActualINRecord;
+            rec.icfgNode = actualIn->getCallSite()->getId();
+            rec.ver = tables.getVer(actualIn->getMRVer());
+        }
+        else if (const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(node))
+        {
+            rec.kind = ActualOUTRecord;
+            rec.icfgNode = actualOut->getCallSite()->getId();
+            rec.ver = tables.getVer(actualOut->getMRVer());
+        }
+        else if (const IntraMSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<IntraMSSAPHISVFGNode>(node))
+        {
+            rec.kind = PHIRecord;
+            rec.icfgNode = phiNode->getICFGNode()->getId();
+            rec.ver = tables.getVer(phiNode->getResVer());
+            for (MemSSA::PHI::OPVers::const_iterator oit = phiNode->opVerBegin(), eoit = phiNode->opVerEnd();
+                    oit != eoit; ++oit)
+                opVers.push_back({oit->first, tables.getVer(oit->second)});
+            rec.opNum = phiNode->getOpVerNum();
+        }
+        else
+            continue;
+        nodes.push_back(rec);
+    }
+
+    for (const_iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        for (const SVFGEdge* edge : it->second->getOutEdges())
+        {
+            SVFGEdgeRecord rec = {edge->getSrcID(), edge->getDstID(), 0, 0};
+            if (const IntraIndSVFGEdge* intraEdge = SVFUtil::dyn_cast<IntraIndSVFGEdge>(edge))
+            {
+                rec.kind = IntraIndRecord;
+                rec.label = tables.getSet(intraEdge->getPointsTo());
+            }
+            else if (SVFUtil::isa<CallIndSVFGEdge>(edge))
+                rec.kind = CallIndRecord;
+            else if (SVFUtil::isa<RetIndSVFGEdge>(edge))
+                rec.kind = RetIndRecord;
+            else
+                continue;
+            edges.push_back(rec);
+        }
+    }
+    tables.setBegin.push_back(tables.elements.size());
+
+    BinaryWriter w;
+    w.write<u32_t>(SVFGFileMagic);
+    w.write<u32_t>(SVFGFileVersion);
+    w.write<u32_t>(tables.setBegin.size() - 1);
+    w.write<u32_t>(tables.elements.size());
+    w.write<u32_t>(tables.vers.size());
+    w.write<u32_t>(nodes.size());
+    w.write<u32_t>(opVers.size());
+    w.write<u32_t>(edges.size());
+    w.writeVector(tables.setBegin);
+    w.align();
+    w.writeVector(tables.elements);
+    w.align();
+    w.writeVector(tables.vers);
+    w.align();
+    w.writeVector(nodes);
+    w.align();
+    w.writeVector(opVers);
+    w.align();
+    w.writeVector(edges);
+    w.align();
+
+    if (!w.writeToFile(filename, false))
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+    outs() << "\n";
+}
+
+/*!
+ * Load a binary SVFG file. The file is mapped and its records are iterated
+ * in place; only the memory regions and versions are materialised.
+ */
+bool SVFG::readBinaryFile(const string& filename)
+{
+    outs() << "Loading SVFG analysis results from '" << filename << "'...";
+
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        outs() << "  error opening file for reading!\n";
+        return false;
+    }
+
+    BinaryReader r = file.getReader();
+    u32_t magic = 0, version = 0, numSets = 0, numElements = 0, numVers = 0, numNodes = 0, numOpVers = 0, numEdges = 0;
+    if (!r.read(magic) || !r.read(version) || magic != SVFGFileMagic || version != SVFGFileVersion)
+    {
+        outs() << "  unsupported file format!\n";
+        return false;
+    }
+    if (!r.read(numSets) || !r.read(numElements) || !r.read(numVers) || !r.read(numNodes) ||
+            !r.read(numOpVers) || !r.read(numEdges))
+    {
+        outs() << "  malformed file!\n";
+        return false;
+    }
+
+    const u32_t* setBegin = r.readArray<u32_t>(numSets + 1);
+    const NodeID* elements = setBegin && r.align() ? r.readArray<NodeID>(numElements) : nullptr;
+    const SVFGVerRecord* vers = elements && r.align() ? r.readArray<SVFGVerRecord>(numVers) : nullptr;
+    const SVFGNodeRecord* nodes = vers && r.align() ? r.readArray<SVFGNodeRecord>(numNodes) : nullptr;
+    const SVFGOpVerRecord* opVers = nodes && r.align() ? r.readArray<SVFGOpVerRecord>(numOpVers) : nullptr;
+    const SVFGEdgeRecord* edges = opVers && r.align() ? r.readArray<SVFGEdgeRecord>(numEdges) : nullptr;
+    if (edges == nullptr)
+    {
+        outs() << "  malformed file!\n";
+        return false;
+    }
+
+    // Validate every index, node kind and edge end before building anything
+    ICFG* icfg = pag->getICFG();
+    bool ok = setBegin[0] == 0 && setBegin[numSets] == numElements;
+    for (u32_t i = 0; ok && i < numSets; ++i)
+        ok = setBegin[i] <= setBegin[i + 1];
+    for (u32_t i = 0; ok && i < numVers; ++i)
+        ok = vers[i].set < numSets;
+    Map<NodeID, const SVFGNodeRecord*> idToNode;
+    for (u32_t i = 0; ok && i < numNodes; ++i)
+        ok = nodes[i].kind <= PHIRecord && nodes[i].ver < numVers && nodes[i].opBegin <= numOpVers &&
+             nodes[i].opNum <= numOpVers - nodes[i].opBegin && icfg->hasICFGNode(nodes[i].icfgNode) &&
+             isValidICFGNodeOf(nodes[i].kind, icfg->getICFGNode(nodes[i].icfgNode)) &&
+             !hasGNode(nodes[i].id) && idToNode.emplace(nodes[i].id, &nodes[i]).second;
+    for (u32_t i = 0; ok && i < numOpVers; ++i)
+        ok = opVers[i].ver < numVers;
+    for (u32_t i = 0; ok && i < numEdges; ++i)
+    {
+        const SVFGEdgeRecord& rec = edges[i];
+        auto srcIt = idToNode.find(rec.src), dstIt = idToNode.find(rec.dst);
+        if (rec.kind == IntraIndRecord)
+        {
+            ok = rec.label < numSets && (srcIt != idToNode.end() || hasGNode(rec.src)) &&
+                 (dstIt != idToNode.end() || hasGNode(rec.dst));
+        }
+        else if (rec.kind == CallIndRecord || rec.kind == RetIndRecord)
+        {
+            // actual-in to formal-in, or formal-out to actual-out, both loaded from this file
+            bool isCall = rec.kind == CallIndRecord;
+            ok = srcIt != idToNode.end() && dstIt != idToNode.end() &&
+                 srcIt->second->kind == (isCall ? ActualINRecord : FormalOUTRecord) &&
+                 dstIt->second->kind == (isCall ? FormalINRecord : ActualOUTRecord);
+            if (ok)
+            {
+                const ICFGNode* cs = icfg->getICFGNode((isCall ? srcIt : dstIt)->second->icfgNode);
+                const ICFGNode* fun = icfg->getICFGNode((isCall ? dstIt : srcIt)->second->icfgNode);
+                ok = callgraph->hasCallSiteID(SVFUtil::cast<CallICFGNode>(cs), fun->getFun());
+            }
+        }
+        else
+            ok = false;
+    }
+    if (!ok)
+    {
+        outs() << "  malformed file!\n";
+        return false;
+    }
+
+    PAGEdge::SVFStmtTableTy& stores = getPAGEdgeSet(PAGEdge::Store);
+    for (PAGEdge::SVFStmtTableTy::iterator iter = stores.begin(), eiter =
+                stores.end(); iter != eiter; ++iter)
+    {
+        StoreStmt* store = SVFUtil::cast<StoreStmt>(*iter);
+        const StmtSVFGNode* sNode = getStmtVFGNode(store);
+        for(CHISet::iterator pi = mssa->getCHISet(store).begin(), epi = mssa->getCHISet(store).end(); pi!=epi; ++pi)
+            setDef((*pi)->getResVer(),sNode);
+    }
+
+    // One memory region per distinct set, and the versions defined on them
+    std::vector<NodeBS> sets(numSets);
+    for (u32_t i = 0; i < numSets; ++i)
+    {
+        for (u32_t e = setBegin[i]; e < setBegin[i + 1]; ++e)
+            sets[i].set(elements[e]);
+    }
+    std::vector<MemRegion*> setToMR(numSets, nullptr);
+    std::vector<MRVer*> mrVers(numVers);
+    for (u32_t i = 0; i < numVers; ++i)
+    {
+        MemRegion*& mr = setToMR[vers[i].set];
+        if (mr == nullptr)
+        {
+            loadedMRs.emplace_back(new MemRegion(sets[vers[i].set]));
+            mr = loadedMRs.back().get();
+        }
+        loadedMRDefs.emplace_back(new MSSADEF(static_cast<MSSADEF::DEFTYPE>(vers[i].defType), mr));
+        loadedMRVers.emplace_back(new MRVer(mr, vers[i].version, loadedMRDefs.back().get()));
+        mrVers[i] = loadedMRVers.back().get();
+    }
+
+    stat->ATVFNodeStart();
+    for (u32_t i = 0; i < numNodes; ++i)
+    {
+        const SVFGNodeRecord& rec = nodes[i];
+        ICFGNode* icfgNode = icfg->getICFGNode(rec.icfgNode);
+        switch (rec.kind)
+        {
+        case FormalINRecord:
+            addFormalINSVFGNode(SVFUtil::cast<FunEntryICFGNode>(icfgNode), mrVers[rec.ver], rec.id);
+            break;
+        case FormalOUTRecord:
+            addFormalOUTSVFGNode(SVFUtil::cast<FunExitICFGNode>(icfgNode), mrVers[rec.ver], rec.id);
+            break;
+        case ActualINRecord:
+            addActualINSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), mrVers[rec.ver], rec.id);
+            break;
+        case ActualOUTRecord:
+            addActualOUTSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), mrVers[rec.ver], rec.id);
+            break;
+        case PHIRecord:
+        {
+            Map<u32_t,const MRVer*> opVerMap;
+            for (u32_t o = rec.opBegin; o < rec.opBegin + rec.opNum; ++o)
+                opVerMap[opVers[o].pos] = mrVers[opVers[o].ver];
+            addIntraMSSAPHISVFGNode(icfgNode, opVerMap.begin(), opVerMap.end(), mrVers[rec.ver], rec.id);
+            break;
+        }
+        }
+        if (totalVFGNode <= rec.id)
+            totalVFGNode = rec.id + 1;
+    }
+    stat->ATVFNodeEnd();
+
+    // The edges from global stores to the program entry were written as well
+    stat->indVFEdgeStart();
+    for (u32_t i = 0; i < numEdges; ++i)
+    {
+        const SVFGEdgeRecord& rec = edges[i];
+        if (rec.kind == IntraIndRecord)
+        {
+            addIntraIndirectVFEdge(rec.src, rec.dst, sets[rec.label]);
+        }
+        else if (rec.kind == CallIndRecord)
+        {
+            const ActualINSVFGNode* actualIn = SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(rec.src));
+            const FormalINSVFGNode* formalIn = SVFUtil::cast<FormalINSVFGNode>(getSVFGNode(rec.dst));
+            addInterIndirectVFCallEdge(actualIn, formalIn, getCallSiteID(actualIn->getCallSite(), formalIn->getFun()));
+        }
+        else
+        {
+            const FormalOUTSVFGNode* formalOut = SVFUtil::cast<FormalOUTSVFGNode>(getSVFGNode(rec.src));
+            const ActualOUTSVFGNode* actualOut = SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(rec.dst));
+            addInterIndirectVFRetEdge(formalOut, actualOut, getCallSiteID(actualOut->getCallSite(), formalOut->getFun()));
+        }
+    }
+    stat->indVFEdgeEnd();
+
+    outs() << "\n";
+    return true;
+}
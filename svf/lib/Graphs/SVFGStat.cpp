@@ -3,6 +3,7 @@
 #include "Graphs/SVFG.h"
 #include "Graphs/SVFGStat.h"
 #include "Graphs/CallGraph.h"
+#include "Util/Options.h"
 
 using namespace SVF;
 using namespace std;
@@ -75,6 +76,7 @@ void MemSSAStat::performStat()
     PTNumStatMap[NumOfMaxRegion] = maxRegionSize;
     timeStatMap[NumOfAveragePtsInRegion] = (regionNumber == 0) ? 0 : ((double)totalRegionPtsNum / regionNumber);
     PTNumStatMap[NumOfMemRegions] = regionNumber;
+    PTNumStatMap["InternedPts"] = mrGenerator->getNumInternedPts();
     PTNumStatMap[NumOfEntryChi] = mssa->getFunEntryChiNum();
     PTNumStatMap[NumOfRetMu] = mssa->getFunRetMuNum();
     PTNumStatMap[NumOfCSChi] = mssa->getCallSiteChiNum();
@@ -90,6 +92,8 @@ void MemSSAStat::performStat()
     PTNumStatMap[NumOfLoadHasMu] = mssa->getLoadToMUSetMap().size();
     PTNumStatMap[NumOfStoreHasChi] = mssa->getStoreToChiSetMap().size();
     PTNumStatMap[NumOfBBHasMSSAPhi] = mssa->getBBToPhiSetMap().size();
+    PTNumStatMap["MSSAThreads"] = Options::MSSAThreads();
+    PTNumStatMap["MSSASteals"] = mssa->getNumBuildSteals();
 
     printStat();
 
@@ -116,6 +120,8 @@ SVFGStat::SVFGStat(SVFG* g) : PTAStat(nullptr)
     addTopLevelNodeTimeStart = addTopLevelNodeTimeEnd = 0;
     addAddrTakenNodeTimeStart = addAddrTakenNodeTimeEnd = 0;
     svfgOptTimeStart = svfgOptTimeEnd = 0;
+    optRemovedNodes = optRemovedEdges = 0;
+    optBypassTime = optBypassWorkerTime = 0;
 }
 
 void SVFGStat::clear()
@@ -167,6 +173,11 @@ void SVFGStat::performStat()
     timeStatMap["ATNodeTime"] = (addAddrTakenNodeTimeEnd - addAddrTakenNodeTimeStart)/TIMEINTERVAL;
 
     timeStatMap["OptTime"] = (svfgOptTimeEnd - svfgOptTimeStart)/TIMEINTERVAL;
+    timeStatMap["OptBypassTime"] = optBypassTime/TIMEINTERVAL;
+    timeStatMap["OptBypassTimeSaved"] = (optBypassWorkerTime - optBypassTime)/TIMEINTERVAL;
+    PTNumStatMap["OptThreads"] = Options::SVFGOptThreads();
+    PTNumStatMap["OptRemovedNodes"] = optRemovedNodes;
+    PTNumStatMap["OptRemovedEdges"] = optRemovedEdges;
 
     PTNumStatMap["TotalNode"] = numOfNodes;
 
@@ -195,6 +206,7 @@ void SVFGStat::performStat()
     PTNumStatMap["DirectEdge"] = totalInEdge - totalIndInEdge;
     PTNumStatMap["IndirectEdge"] = totalIndInEdge;
     PTNumStatMap["IndirectEdgeLabels"] = totalIndEdgeLabels;
+    PTNumStatMap["IndEdgeLabelSets"] = IndirectSVFGEdge::getLabelCache().getNumStoredPts();
 
     PTNumStatMap["IndCallEdge"] = totalIndCallEdge;
     PTNumStatMap["IndRetEdge"] = totalIndRetEdge;
@@ -68,7 +68,7 @@ void DistinctMRG::getMRsForLoad(MRSet& mrs, const NodeBS& pts, const FunObjVar*)
         NodeBS newPts;
         newPts.set(id);
 
-        MemRegion mr(newPts);
+        MemRegion mr(&newPts);
         MRSet::iterator mit = memRegSet.find(&mr);
         assert(mit!=memRegSet.end() && "memory region not found!!");
         mrs.insert(*mit);
@@ -214,7 +214,7 @@ void IntraDisjointMRG::getMRsForLoadFromInterList(MRSet& mrs, const NodeBS& cpts
         const NodeBS& inter = *it;
         if (cpts.contains(inter))
         {
-            MemRegion mr(inter);
+            MemRegion mr(&inter);
             MRSet::iterator mit = memRegSet.find(&mr);
             assert(mit!=memRegSet.end() && "memory region not found!!");
             mrs.insert(*mit);
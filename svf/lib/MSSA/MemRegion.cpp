@@ -3,12 +3,13 @@
 #include "MSSA/MemRegion.h"
 #include "MSSA/MSSAMuChi.h"
 #include "Graphs/CallGraph.h"
+#include "Util/WorkStealing.h"
 
 using namespace SVF;
 using namespace SVFUtil;
 
-u32_t MemRegion::totalMRNum = 0;
-u32_t MRVer::totalVERNum = 0;
+std::atomic<u32_t> MemRegion::totalMRNum(0);
+std::atomic<u32_t> MRVer::totalVERNum(0);
 
 MRGenerator::MRGenerator(BVDataPTAImpl* p, bool ptrOnly) :
     pta(p), ptrOnlyMSSA(ptrOnly)
@@ -41,7 +42,7 @@ void MRGenerator::destroy()
 void MRGenerator::createMR(const FunObjVar* fun, const NodeBS& cpts)
 {
     const NodeBS& repCPts = getRepPointsTo(cpts);
-    MemRegion mr(repCPts);
+    MemRegion mr(&repCPts);
     MRSet::const_iterator mit = memRegSet.find(&mr);
     if(mit!=memRegSet.end())
     {
@@ -52,7 +53,7 @@ void MRGenerator::createMR(const FunObjVar* fun, const NodeBS& cpts)
     }
     else
     {
-        MemRegion* m = new MemRegion(repCPts);
+        MemRegion* m = new MemRegion(internPts(repCPts));
         memRegSet.insert(m);
         funToMRsMap[fun].insert(m);
     }
@@ -63,7 +64,7 @@ void MRGenerator::createMR(const FunObjVar* fun, const NodeBS& cpts)
  */
 const MemRegion* MRGenerator::getMR(const NodeBS& cpts) const
 {
-    MemRegion mr(getRepPointsTo(cpts));
+    MemRegion mr(&getRepPointsTo(cpts));
     MRSet::iterator mit = memRegSet.find(&mr);
     assert(mit!=memRegSet.end() && "memory region not found!!");
     return *mit;
@@ -146,6 +147,7 @@ void MRGenerator::collectModRefForLoadStore()
 {
 
     CallGraph* svfirCallGraph = PAG::getPAG()->getCallGraph();
+    std::vector<const FunObjVar*> funs;
     for (const auto& item: *svfirCallGraph)
     {
         const FunObjVar& fun = *item.second->getFunction();
@@ -154,41 +156,110 @@ void MRGenerator::collectModRefForLoadStore()
         if (Options::IgnoreDeadFun() && fun.isUncalledFunction())
             continue;
 
+        funs.push_back(&fun);
+
+        /// Look up every statement list and points-to set collectFunCPts
+        /// will read, so that it never inserts into the maps behind them
         for (FunObjVar::const_bb_iterator iter = fun.begin(), eiter = fun.end();
                 iter != eiter; ++iter)
         {
             const SVFBasicBlock* bb = iter->second;
             for (const auto& inst: bb->getICFGNodeList())
             {
-                SVFStmtList& pagEdgeList = getPAGEdgesFromInst(inst);
-                for (SVFStmtList::iterator bit = pagEdgeList.begin(), ebit =
-                            pagEdgeList.end(); bit != ebit; ++bit)
+                for (const PAGEdge* edge : getPAGEdgesFromInst(inst))
                 {
-                    const PAGEdge* inst = *bit;
-                    pagEdgeToFunMap[inst] = &fun;
-                    if (const StoreStmt *st = SVFUtil::dyn_cast<StoreStmt>(inst))
-                    {
-                        NodeBS cpts(pta->getPts(st->getLHSVarID()).toNodeBS());
-                        // TODO: change this assertion check later when we have conditional points-to set
-                        if (cpts.empty())
-                            continue;
-                        assert(!cpts.empty() && "null pointer!!");
-                        addCPtsToStore(cpts, st, &fun);
-                    }
-
-                    else if (const LoadStmt *ld = SVFUtil::dyn_cast<LoadStmt>(inst))
-                    {
-                        NodeBS cpts(pta->getPts(ld->getRHSVarID()).toNodeBS());
-                        // TODO: change this assertion check later when we have conditional points-to set
-                        if (cpts.empty())
-                            continue;
-                        assert(!cpts.empty() && "null pointer!!");
-                        addCPtsToLoad(cpts, ld, &fun);
-                    }
+                    pagEdgeToFunMap[edge] = &fun;
+                    if (const StoreStmt *st = SVFUtil::dyn_cast<StoreStmt>(edge))
+                        pta->getPts(st->getLHSVarID());
+                    else if (const LoadStmt *ld = SVFUtil::dyn_cast<LoadStmt>(edge))
+                        pta->getPts(ld->getRHSVarID());
                 }
             }
         }
     }
+
+    std::vector<FunCPts> funCPts(funs.size());
+    WorkStealingPool<u32_t> pool(Options::MSSAThreads());
+    for (u32_t i = 0; i < funs.size(); ++i)
+        pool.push(i);
+    pool.run([&](u32_t i, unsigned)
+    {
+        collectFunCPts(*funs[i], funCPts[i]);
+    });
+
+    for (u32_t i = 0; i < funs.size(); ++i)
+    {
+        const FunObjVar* fun = funs[i];
+        FunCPts& cpts = funCPts[i];
+        for (const auto& store : cpts.stores)
+            storesToPointsToMap[store.first] = internPts(store.second);
+        for (const auto& load : cpts.loads)
+            loadsToPointsToMap[load.first] = internPts(load.second);
+        if (!cpts.cptsList.empty())
+        {
+            PointsToList& cptsList = funToPointsToMap[fun];
+            if (cptsList.empty())
+                cptsList.swap(cpts.cptsList);
+            else
+                cptsList.insert(cpts.cptsList.begin(), cpts.cptsList.end());
+        }
+        if (!cpts.mods.empty())
+            funToModsMap[fun] |= cpts.mods;
+        if (!cpts.refs.empty())
+            funToRefsMap[fun] |= cpts.refs;
+    }
+}
+
+/*!
+ * Collect the conditional points-to of the loads/stores of a function,
+ * as addCPtsToStore/addCPtsToLoad would, but into cpts
+ */
+void MRGenerator::collectFunCPts(const FunObjVar& fun, FunCPts& funCPts)
+{
+    NodeBS modCPts, refCPts;
+    for (FunObjVar::const_bb_iterator iter = fun.begin(), eiter = fun.end();
+            iter != eiter; ++iter)
+    {
+        const SVFBasicBlock* bb = iter->second;
+        for (const auto& inst: bb->getICFGNodeList())
+        {
+            for (const PAGEdge* edge : getPAGEdgesFromInst(inst))
+            {
+                if (const StoreStmt *st = SVFUtil::dyn_cast<StoreStmt>(edge))
+                {
+                    NodeBS cpts(pta->getPts(st->getLHSVarID()).toNodeBS());
+                    // TODO: change this assertion check later when we have conditional points-to set
+                    if (cpts.empty())
+                        continue;
+                    modCPts |= cpts;
+                    funCPts.cptsList.insert(cpts);
+                    funCPts.stores.push_back(std::make_pair(st, std::move(cpts)));
+                }
+                else if (const LoadStmt *ld = SVFUtil::dyn_cast<LoadStmt>(edge))
+                {
+                    NodeBS cpts(pta->getPts(ld->getRHSVarID()).toNodeBS());
+                    // TODO: change this assertion check later when we have conditional points-to set
+                    if (cpts.empty())
+                        continue;
+                    refCPts |= cpts;
+                    funCPts.cptsList.insert(cpts);
+                    funCPts.loads.push_back(std::make_pair(ld, std::move(cpts)));
+                }
+            }
+        }
+    }
+
+    /// Side effects of the function, see addModSideEffectOfFunction/addRefSideEffectOfFunction
+    for (NodeBS::iterator it = modCPts.begin(), eit = modCPts.end(); it != eit; ++it)
+    {
+        if (isNonLocalObject(*it, &fun))
+            funCPts.mods.set(*it);
+    }
+    for (NodeBS::iterator it = refCPts.begin(), eit = refCPts.end(); it != eit; ++it)
+    {
+        if (isNonLocalObject(*it, &fun))
+            funCPts.refs.set(*it);
+    }
 }
 
 
@@ -311,62 +382,91 @@ void MRGenerator::partitionMRs()
 
 }
 
+/*!
+ * Compute query(i, mrs) for every i in [0, num) on Options::MSSAThreads()
+ * threads, then apply(i, mrs) the non-empty results in order of i
+ */
+template<class Query, class Apply>
+static void computeMRsInParallel(u32_t num, Query query, Apply apply)
+{
+    std::vector<MRGenerator::MRSet> mrs(num);
+    WorkStealingPool<u32_t> pool(Options::MSSAThreads());
+    for (u32_t i = 0; i < num; ++i)
+        pool.push(i);
+    pool.run([&](u32_t i, unsigned)
+    {
+        query(i, mrs[i]);
+    });
+
+    for (u32_t i = 0; i < num; ++i)
+    {
+        if (!mrs[i].empty())
+            apply(i, mrs[i]);
+    }
+}
+
 /*!
  * Update aliased regions for loads/stores/callsites
+ * Regions are only read at this point, so the aliased regions of different
+ * loads/stores/callsites are looked up in parallel. The region set of each
+ * function queried is created upfront as getAliasMemRegions would.
  */
 void MRGenerator::updateAliasMRs()
 {
 
     /// update stores with its aliased regions
+    std::vector<StoresToPointsToMap::const_iterator> stores;
     for(StoresToPointsToMap::const_iterator it = storesToPointsToMap.begin(), eit = storesToPointsToMap.end(); it!=eit; ++it)
     {
-        MRSet aliasMRs;
-        const FunObjVar* fun = getFunction(it->first);
-        const NodeBS& storeCPts = it->second;
-        getAliasMemRegions(aliasMRs,storeCPts,fun);
-        for(MRSet::iterator ait = aliasMRs.begin(), eait = aliasMRs.end(); ait!=eait; ++ait)
-        {
-            storesToMRsMap[it->first].insert(*ait);
-        }
+        stores.push_back(it);
+        getFunMRSet(getFunction(it->first));
     }
+    computeMRsInParallel(stores.size(), [&](u32_t i, MRSet& aliasMRs)
+    {
+        getAliasMemRegions(aliasMRs, *stores[i]->second, getFunction(stores[i]->first));
+    }, [&](u32_t i, const MRSet& aliasMRs)
+    {
+        storesToMRsMap[stores[i]->first].insert(aliasMRs.begin(), aliasMRs.end());
+    });
 
+    std::vector<LoadsToPointsToMap::const_iterator> loads;
     for(LoadsToPointsToMap::const_iterator it = loadsToPointsToMap.begin(), eit = loadsToPointsToMap.end(); it!=eit; ++it)
+        loads.push_back(it);
+    computeMRsInParallel(loads.size(), [&](u32_t i, MRSet& aliasMRs)
     {
-        MRSet aliasMRs;
-        const FunObjVar* fun = getFunction(it->first);
-        const NodeBS& loadCPts = it->second;
-        getMRsForLoad(aliasMRs, loadCPts, fun);
-        for(MRSet::iterator ait = aliasMRs.begin(), eait = aliasMRs.end(); ait!=eait; ++ait)
-        {
-            loadsToMRsMap[it->first].insert(*ait);
-        }
-    }
+        getMRsForLoad(aliasMRs, *loads[i]->second, getFunction(loads[i]->first));
+    }, [&](u32_t i, const MRSet& aliasMRs)
+    {
+        loadsToMRsMap[loads[i]->first].insert(aliasMRs.begin(), aliasMRs.end());
+    });
 
     /// update callsites with its aliased regions
+    std::vector<CallSiteToPointsToMap::const_iterator> modCallSites;
     for(CallSiteToPointsToMap::const_iterator it =  callsiteToModPointsToMap.begin(),
             eit = callsiteToModPointsToMap.end(); it!=eit; ++it)
     {
-        const FunObjVar* fun = it->first->getCaller();
-        MRSet aliasMRs;
-        const NodeBS& callsiteModCPts = it->second;
-        getAliasMemRegions(aliasMRs,callsiteModCPts,fun);
-        for(MRSet::iterator ait = aliasMRs.begin(), eait = aliasMRs.end(); ait!=eait; ++ait)
-        {
-            callsiteToModMRsMap[it->first].insert(*ait);
-        }
+        modCallSites.push_back(it);
+        getFunMRSet(it->first->getCaller());
     }
+    computeMRsInParallel(modCallSites.size(), [&](u32_t i, MRSet& aliasMRs)
+    {
+        getAliasMemRegions(aliasMRs, modCallSites[i]->second, modCallSites[i]->first->getCaller());
+    }, [&](u32_t i, const MRSet& aliasMRs)
+    {
+        callsiteToModMRsMap[modCallSites[i]->first].insert(aliasMRs.begin(), aliasMRs.end());
+    });
+
+    std::vector<CallSiteToPointsToMap::const_iterator> refCallSites;
     for(CallSiteToPointsToMap::const_iterator it =  callsiteToRefPointsToMap.begin(),
             eit = callsiteToRefPointsToMap.end(); it!=eit; ++it)
+        refCallSites.push_back(it);
+    computeMRsInParallel(refCallSites.size(), [&](u32_t i, MRSet& aliasMRs)
     {
-        const FunObjVar* fun = it->first->getCaller();
-        MRSet aliasMRs;
-        const NodeBS& callsiteRefCPts = it->second;
-        getMRsForCallSiteRef(aliasMRs, callsiteRefCPts, fun);
-        for(MRSet::iterator ait = aliasMRs.begin(), eait = aliasMRs.end(); ait!=eait; ++ait)
-        {
-            callsiteToRefMRsMap[it->first].insert(*ait);
-        }
-    }
+        getMRsForCallSiteRef(aliasMRs, refCallSites[i]->second, refCallSites[i]->first->getCaller());
+    }, [&](u32_t i, const MRSet& aliasMRs)
+    {
+        callsiteToRefMRsMap[refCallSites[i]->first].insert(aliasMRs.begin(), aliasMRs.end());
+    });
 }
 
 
@@ -5,6 +5,7 @@
 #include "Graphs/SVFGStat.h"
 #include "Graphs/CallGraph.h"
 #include "SVFIR/SVFVariables.h"
+#include "Util/WorkStealing.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -17,7 +18,8 @@ double MemSSA::timeOfSSARenaming  = 0;	///< Time for SSA rename
 /*!
  * Constructor
  */
-MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA)
+MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : parent(nullptr), workerMUCHITime(0),
+    workerPHITime(0), workerRenameTime(0), numBuildSteals(0)
 {
     pta = p;
     assert((pta->getAnalysisTy()!=PointerAnalysis::Default_PTA)
@@ -42,6 +44,14 @@ MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA)
     timeOfGeneratingMemRegions = (mrEnd - mrStart)/TIMEINTERVAL;
 }
 
+/*!
+ * Worker constructor, regions and statistics belong to p
+ */
+MemSSA::MemSSA(MemSSA* p) : pta(p->pta), mrGen(p->mrGen), stat(p->stat), parent(p),
+    workerMUCHITime(0), workerPHITime(0), workerRenameTime(0), numBuildSteals(0)
+{
+}
+
 SVFIR* MemSSA::getPAG()
 {
     return pta->getPAG();
@@ -60,25 +70,135 @@ void MemSSA::buildMemSSA(const FunObjVar& fun)
 
     usedRegs.clear();
     reg2BBMap.clear();
+    size_t firstVer = usedMRVers.size();
+
+    /// Workers run concurrently and must not touch the static timers
+    double& muchiTime = parent ? workerMUCHITime : timeOfCreateMUCHI;
+    double& phiTime = parent ? workerPHITime : timeOfInsertingPHI;
+    double& renameTime = parent ? workerRenameTime : timeOfSSARenaming;
 
     /// Create mus/chis for loads/stores/calls for memory regions
     double muchiStart = stat->getClk(true);
     createMUCHI(fun);
     double muchiEnd = stat->getClk(true);
-    timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
+    muchiTime += (muchiEnd - muchiStart)/TIMEINTERVAL;
 
     /// Insert PHI for memory regions
     double phiStart = stat->getClk(true);
     insertPHI(fun);
     double phiEnd = stat->getClk(true);
-    timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
+    phiTime += (phiEnd - phiStart)/TIMEINTERVAL;
 
     /// SSA rename for memory regions
     double renameStart = stat->getClk(true);
     SSARename(fun);
     double renameEnd = stat->getClk(true);
-    timeOfSSARenaming += (renameEnd - renameStart)/TIMEINTERVAL;
+    renameTime += (renameEnd - renameStart)/TIMEINTERVAL;
+
+    if (parent)
+        funToMRVerRange[&fun] = std::make_pair(firstVer, usedMRVers.size());
+}
+
+/*!
+ * Build memory SSA for all functions, in parallel when asked to
+ */
+void MemSSA::buildMemSSA(const FunList& funs)
+{
+    u32_t numThreads = Options::MSSAThreads();
+    if (numThreads <= 1 || funs.size() <= 1)
+    {
+        for (const FunObjVar* fun : funs)
+            buildMemSSA(*fun);
+        return;
+    }
+
+    for (const FunObjVar* fun : funs)
+        prepareMRLookups(*fun);
+
+    std::vector<std::unique_ptr<MemSSA>> workers;
+    for (u32_t t = 0; t < numThreads; ++t)
+        workers.push_back(std::unique_ptr<MemSSA>(new MemSSA(this)));
+
+    /// Each function is built as a whole by one worker
+    std::vector<u32_t> funToWorker(funs.size());
+    u32_t firstVerID = MRVer::getTotalVERNum();
+    WorkStealingPool<u32_t> pool(numThreads);
+    for (u32_t i = 0; i < funs.size(); ++i)
+        pool.push(i);
+    pool.run([&](u32_t i, unsigned thread)
+    {
+        workers[thread]->buildMemSSA(*funs[i]);
+        funToWorker[i] = thread;
+    });
+    numBuildSteals += pool.getNumSteals();
+
+    /// Take over the versions function by function, in the order a
+    /// sequential build would have created them
+    MRVer::setTotalVERNum(firstVerID);
+    for (u32_t i = 0; i < funs.size(); ++i)
+    {
+        MemSSA& worker = *workers[funToWorker[i]];
+        const std::pair<size_t, size_t>& range = worker.funToMRVerRange[funs[i]];
+        for (size_t v = range.first; v < range.second; ++v)
+        {
+            worker.usedMRVers[v]->renumber();
+            usedMRVers.push_back(std::move(worker.usedMRVers[v]));
+        }
+    }
 
+    for (std::unique_ptr<MemSSA>& worker : workers)
+        mergeWorker(*worker);
+}
+
+/*!
+ * Region sets are fetched through map lookups which insert missing (empty)
+ * entries, e.g. for a load whose pointer points to nothing. Do those
+ * lookups here, sequentially, for everything createMUCHI will ask for.
+ */
+void MemSSA::prepareMRLookups(const FunObjVar& fun)
+{
+    for (const SVFBasicBlock* bb : fun.getReachableBBs())
+    {
+        for (const auto& inst: bb->getICFGNodeList())
+        {
+            if (!mrGen->hasSVFStmtList(inst))
+                continue;
+            for (const PAGEdge* edge : mrGen->getPAGEdgesFromInst(inst))
+            {
+                if (const LoadStmt* load = SVFUtil::dyn_cast<LoadStmt>(edge))
+                    mrGen->getLoadMRSet(load);
+                else if (const StoreStmt* store = SVFUtil::dyn_cast<StoreStmt>(edge))
+                    mrGen->getStoreMRSet(store);
+            }
+        }
+    }
+}
+
+/*!
+ * Functions are disjoint, so are the keys of the maps of different workers.
+ * The worker is left empty and will not free what it built.
+ */
+void MemSSA::mergeWorker(MemSSA& worker)
+{
+    load2MuSetMap.insert(worker.load2MuSetMap.begin(), worker.load2MuSetMap.end());
+    store2ChiSetMap.insert(worker.store2ChiSetMap.begin(), worker.store2ChiSetMap.end());
+    callsiteToMuSetMap.insert(worker.callsiteToMuSetMap.begin(), worker.callsiteToMuSetMap.end());
+    callsiteToChiSetMap.insert(worker.callsiteToChiSetMap.begin(), worker.callsiteToChiSetMap.end());
+    bb2PhiSetMap.insert(worker.bb2PhiSetMap.begin(), worker.bb2PhiSetMap.end());
+    funToEntryChiSetMap.insert(worker.funToEntryChiSetMap.begin(), worker.funToEntryChiSetMap.end());
+    funToReturnMuSetMap.insert(worker.funToReturnMuSetMap.begin(), worker.funToReturnMuSetMap.end());
+
+    worker.load2MuSetMap.clear();
+    worker.store2ChiSetMap.clear();
+    worker.callsiteToMuSetMap.clear();
+    worker.callsiteToChiSetMap.clear();
+    worker.bb2PhiSetMap.clear();
+    worker.funToEntryChiSetMap.clear();
+    worker.funToReturnMuSetMap.clear();
+
+    timeOfCreateMUCHI += worker.workerMUCHITime;
+    timeOfInsertingPHI += worker.workerPHITime;
+    timeOfSSARenaming += worker.workerRenameTime;
 }
 
 /*!
@@ -409,9 +529,13 @@ void MemSSA::destroy()
         }
     }
 
-    delete mrGen;
+    /// Regions and statistics of a worker belong to its parent
+    if (parent == nullptr)
+    {
+        delete mrGen;
+        delete stat;
+    }
     mrGen = nullptr;
-    delete stat;
     stat = nullptr;
     pta = nullptr;
 }
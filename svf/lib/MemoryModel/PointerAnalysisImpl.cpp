@@ -16,7 +16,7 @@ using namespace std;
  * Constructor
  */
 BVDataPTAImpl::BVDataPTAImpl(SVFIR* p, PointerAnalysis::PTATY type, bool alias_check) :
-    PointerAnalysis(p, type, alias_check), ptCache()
+    PointerAnalysis(p, type, alias_check), ptCache(), indexedCallSites(nullptr), indexedCallSitesGen(0), numOfReResolvedCallSites(0)
 {
     if (type == Andersen_BASE || type == Andersen_WPA || type == AndersenLCD_WPA || type == AndersenWaveDiff_WPA || type == AndersenFS_WPA || type == AndersenFSCG_WPA
             || type == FlowSensitiveSCD_WPA || type == TypeCPP_WPA || type == FlowS_DDA
@@ -135,6 +135,12 @@ void BVDataPTAImpl::remapPointsToSets(void)
 
 void BVDataPTAImpl::writeObjVarToFile(const string& filename)
 {
+    if (!Options::WriteAnderText())
+    {
+        writeBinaryObjVarToFile(filename);
+        return;
+    }
+
     outs() << "Storing ObjVar to '" << filename << "'...";
     error_code err;
     std::fstream f(filename.c_str(), std::ios_base::out);
@@ -219,6 +225,11 @@ void BVDataPTAImpl::writeGepObjVarMapToFile(std::fstream& f)
  */
 void BVDataPTAImpl::writeToFile(const string& filename)
 {
+    if (!Options::WriteAnderText())
+    {
+        writeBinaryToFile(filename);
+        return;
+    }
 
     outs() << "Storing pointer analysis results to '" << filename << "'...";
 
@@ -331,29 +342,37 @@ void BVDataPTAImpl::readGepObjVarMapFromFile(std::ifstream& F)
         ss >> base >> offset >>id;
         SVFIR::NodeOffsetMap::const_iterator iter = gepObjVarMap.find(std::make_pair(base, offset));
         if (iter == gepObjVarMap.end())
-        {
-            SVFVar* node = pag->getGNode(base);
-            const BaseObjVar* obj = nullptr;
-            if (GepObjVar* gepObjVar = SVFUtil::dyn_cast<GepObjVar>(node))
-            {
-                obj = gepObjVar->getBaseObj();
-            }
-            else if (BaseObjVar* baseNode = SVFUtil::dyn_cast<BaseObjVar>(node))
-            {
-                obj = baseNode;
-            }
-            else if (DummyObjVar* baseNode = SVFUtil::dyn_cast<DummyObjVar>(node))
-            {
-                obj = baseNode;
-            }
-            else
-                assert(false && "new gep obj node kind?");
-            pag->addGepObjNode( obj, offset, id);
-            NodeIDAllocator::get()->increaseNumOfObjAndNodes();
-        }
+            addGepObjVarFromFile(base, offset, id);
+    }
+}
 
+/*!
+ * Recreate gep object id (base, offset) stored in a result file, unless it exists.
+ */
+void BVDataPTAImpl::addGepObjVarFromFile(NodeID base, APOffset offset, NodeID id)
+{
+    const SVFIR::NodeOffsetMap& gepObjVarMap = pag->getGepObjNodeMap();
+    if (gepObjVarMap.find(std::make_pair(base, offset)) != gepObjVarMap.end())
+        return;
 
+    SVFVar* node = pag->getGNode(base);
+    const BaseObjVar* obj = nullptr;
+    if (GepObjVar* gepObjVar = SVFUtil::dyn_cast<GepObjVar>(node))
+    {
+        obj = gepObjVar->getBaseObj();
+    }
+    else if (BaseObjVar* baseNode = SVFUtil::dyn_cast<BaseObjVar>(node))
+    {
+        obj = baseNode;
     }
+    else if (DummyObjVar* baseNode = SVFUtil::dyn_cast<DummyObjVar>(node))
+    {
+        obj = baseNode;
+    }
+    else
+        assert(false && "new gep obj node kind?");
+    pag->addGepObjNode( obj, offset, id);
+    NodeIDAllocator::get()->increaseNumOfObjAndNodes();
 }
 
 void BVDataPTAImpl::readAndSetObjFieldSensitivity(std::ifstream& F, const std::string& delimiterStr)
@@ -384,6 +403,8 @@ void BVDataPTAImpl::readAndSetObjFieldSensitivity(std::ifstream& F, const std::s
  */
 bool BVDataPTAImpl::readFromFile(const string& filename)
 {
+    if (isBinaryPtsFile(filename))
+        return readBinaryFromFile(filename);
 
     outs() << "Loading pointer analysis results from '" << filename << "'...";
 
@@ -412,6 +433,300 @@ bool BVDataPTAImpl::readFromFile(const string& filename)
 }
 
 
+/// Identifies binary analysis result files, followed by the format version
+static const u32_t PtsFileMagic = 0x53505446;
+static const u32_t PtsFileVersion = 1;
+
+bool BVDataPTAImpl::isBinaryPtsFile(const string& filename)
+{
+    ifstream F(filename.c_str(), std::ios_base::binary);
+    u32_t magic = 0;
+    F.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    return F.good() && magic == PtsFileMagic;
+}
+
+/*!
+ * A section is its kind, its payload size and the payload, padded to 8 bytes.
+ */
+void BVDataPTAImpl::addPtsFileSection(BinaryWriter& sections, PtsFileSection kind, const BinaryWriter& payload)
+{
+    sections.write<u32_t>(kind);
+    sections.write<u32_t>(0);
+    sections.write<u64_t>(payload.size());
+    sections.writeVector(payload.getBuffer());
+    sections.align();
+}
+
+bool BVDataPTAImpl::writePtsFileSections(const string& filename, const BinaryWriter& sections, bool replace)
+{
+    bool append = !replace && isBinaryPtsFile(filename);
+    BinaryWriter w;
+    if (!append)
+    {
+        w.write(PtsFileMagic);
+        w.write(PtsFileVersion);
+    }
+    w.writeVector(sections.getBuffer());
+    return w.writeToFile(filename, append);
+}
+
+/*!
+ * Layout: #keys, #sets, #elements, keyToSet[#keys], setBegin[#sets + 1], elements[#elements]
+ * The elements of set i are elements[setBegin[i]..setBegin[i+1]).
+ */
+void BVDataPTAImpl::writePtsTable(BinaryWriter& w, const std::vector<const PointsTo*>& keyPts)
+{
+    Map<PointsTo, u32_t> setToIndex;
+    std::vector<const PointsTo*> sets;
+    std::vector<u32_t> keyToSet;
+    keyToSet.reserve(keyPts.size());
+    for (const PointsTo* pts : keyPts)
+    {
+        auto inserted = setToIndex.emplace(*pts, sets.size());
+        if (inserted.second)
+            sets.push_back(pts);
+        keyToSet.push_back(inserted.first->second);
+    }
+
+    std::vector<u32_t> setBegin;
+    std::vector<NodeID> elements;
+    setBegin.reserve(sets.size() + 1);
+    for (const PointsTo* pts : sets)
+    {
+        setBegin.push_back(elements.size());
+        for (NodeID n : *pts)
+            elements.push_back(n);
+    }
+    setBegin.push_back(elements.size());
+
+    w.write<u32_t>(keyPts.size());
+    w.write<u32_t>(sets.size());
+    w.write<u32_t>(elements.size());
+    w.write<u32_t>(0);
+    w.writeVector(keyToSet);
+    w.align();
+    w.writeVector(setBegin);
+    w.align();
+    w.writeVector(elements);
+    w.align();
+}
+
+bool BVDataPTAImpl::readPtsTable(BinaryReader& r, u32_t numKeys, std::vector<PointsTo>& sets, const u32_t*& keyToSet)
+{
+    u32_t keys = 0, numSets = 0, numElements = 0, reserved = 0;
+    if (!r.read(keys) || !r.read(numSets) || !r.read(numElements) || !r.read(reserved) || keys != numKeys)
+        return false;
+
+    keyToSet = r.readArray<u32_t>(numKeys);
+    if (keyToSet == nullptr || !r.align())
+        return false;
+    const u32_t* setBegin = r.readArray<u32_t>(numSets + 1);
+    if (setBegin == nullptr || !r.align())
+        return false;
+    const NodeID* elements = r.readArray<NodeID>(numElements);
+    if (elements == nullptr || !r.align())
+        return false;
+
+    sets.resize(numSets);
+    for (u32_t i = 0; i < numSets; ++i)
+    {
+        if (setBegin[i] > setBegin[i + 1] || setBegin[i + 1] > numElements)
+            return false;
+        for (u32_t e = setBegin[i]; e < setBegin[i + 1]; ++e)
+            sets[i].set(elements[e]);
+    }
+    for (u32_t k = 0; k < numKeys; ++k)
+    {
+        if (keyToSet[k] >= numSets)
+            return false;
+    }
+
+    return true;
+}
+
+void BVDataPTAImpl::writeFIObjs(BinaryWriter& w)
+{
+    NodeBS baseObjs;
+    std::vector<NodeID> fiObjs;
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        if (!isa<ObjVar>(it->second)) continue;
+        NodeID n = pag->getBaseObjVar(it->first);
+        if (baseObjs.test_and_set(n) && isFieldInsensitive(n))
+            fiObjs.push_back(n);
+    }
+
+    w.write<u32_t>(fiObjs.size());
+    w.write<u32_t>(0);
+    w.writeVector(fiObjs);
+    w.align();
+}
+
+bool BVDataPTAImpl::readAndSetFIObjs(BinaryReader& r)
+{
+    u32_t num = 0, reserved = 0;
+    if (!r.read(num) || !r.read(reserved))
+        return false;
+    const NodeID* fiObjs = r.readArray<NodeID>(num);
+    if (fiObjs == nullptr)
+        return false;
+    for (u32_t i = 0; i < num; ++i)
+        setObjFieldInsensitive(fiObjs[i]);
+    return true;
+}
+
+void BVDataPTAImpl::writeBinaryObjVarToFile(const string& filename)
+{
+    outs() << "Storing ObjVar to '" << filename << "'...";
+
+    BinaryWriter payload, sections;
+    writeFIObjs(payload);
+    addPtsFileSection(sections, FIObjsBeforeSolving, payload);
+
+    if (!writePtsFileSections(filename, sections, true))
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+    outs() << "\n";
+}
+
+void BVDataPTAImpl::writeBinaryToFile(const string& filename)
+{
+    outs() << "Storing pointer analysis results to '" << filename << "'...";
+
+    BinaryWriter payload, sections;
+
+    // Points-to sets of every SVFIR node
+    std::vector<NodeID> vars;
+    std::vector<const PointsTo*> varPts;
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        const PointsTo& pts = getPts(it->first);
+        if (pts.empty()) continue;
+        vars.push_back(it->first);
+        varPts.push_back(&pts);
+    }
+    payload.write<u32_t>(vars.size());
+    payload.write<u32_t>(0);
+    payload.writeVector(vars);
+    payload.align();
+    writePtsTable(payload, varPts);
+    addPtsFileSection(sections, TopLevelPts, payload);
+
+    // Gep objects as (base, offset, gep object)
+    payload.clear();
+    SVFIR::NodeOffsetMap& gepObjVarMap = pag->getGepObjNodeMap();
+    payload.write<u32_t>(gepObjVarMap.size());
+    payload.write<u32_t>(0);
+    for (const SVFIR::NodeOffsetMap::value_type& gep : gepObjVarMap)
+    {
+        payload.write<s64_t>(gep.first.second);
+        payload.write<NodeID>(gep.first.first);
+        payload.write<NodeID>(gep.second);
+    }
+    addPtsFileSection(sections, GepObjVars, payload);
+
+    payload.clear();
+    writeFIObjs(payload);
+    addPtsFileSection(sections, FIObjsAfterSolving, payload);
+
+    if (!writePtsFileSections(filename, sections, false))
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+    outs() << "\n";
+}
+
+/*!
+ * Load a binary result file. The file is mapped and sections are read in the
+ * order they were written, which is the order the text reader expects.
+ */
+bool BVDataPTAImpl::readBinaryFromFile(const string& filename)
+{
+    outs() << "Loading pointer analysis results from '" << filename << "'...";
+
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        outs() << "  error opening file for reading!\n";
+        return false;
+    }
+
+    BinaryReader r = file.getReader();
+    u32_t magic = 0, version = 0;
+    if (!r.read(magic) || !r.read(version) || magic != PtsFileMagic || version != PtsFileVersion)
+    {
+        outs() << "  unsupported file format!\n";
+        return false;
+    }
+
+    bool ok = true;
+    while (ok && !r.atEnd())
+    {
+        u32_t kind = 0, reserved = 0;
+        u64_t size = 0;
+        BinaryReader section(nullptr, 0);
+        ok = r.read(kind) && r.read(reserved) && r.read(size) && r.readSub(size, section) && r.align();
+        if (!ok) break;
+
+        switch (kind)
+        {
+        case FIObjsBeforeSolving:
+        case FIObjsAfterSolving:
+            ok = readAndSetFIObjs(section);
+            break;
+        case TopLevelPts:
+        {
+            u32_t numVars = 0;
+            ok = section.read(numVars) && section.read(reserved);
+            const NodeID* vars = ok ? section.readArray<NodeID>(numVars) : nullptr;
+            std::vector<PointsTo> sets;
+            const u32_t* varToSet = nullptr;
+            ok = vars != nullptr && section.align() && readPtsTable(section, numVars, sets, varToSet);
+            if (!ok) break;
+            PTDataTy* ptD = getPTDataTy();
+            for (u32_t i = 0; i < numVars; ++i)
+                ptD->unionPts(vars[i], sets[varToSet[i]]);
+            break;
+        }
+        case GepObjVars:
+        {
+            u32_t numGeps = 0;
+            ok = section.read(numGeps) && section.read(reserved);
+            for (u32_t i = 0; ok && i < numGeps; ++i)
+            {
+                s64_t offset = 0;
+                NodeID base = 0, id = 0;
+                ok = section.read(offset) && section.read(base) && section.read(id);
+                if (ok)
+                    addGepObjVarFromFile(base, offset, id);
+            }
+            break;
+        }
+        case VersionedPts:
+            ok = readVersionedPtsSection(section);
+            break;
+        default:
+            // Sections from a newer writer are skipped.
+            break;
+        }
+    }
+
+    if (!ok)
+    {
+        outs() << "  malformed file!\n";
+        return false;
+    }
+
+    // Update callgraph
+    updateCallGraph(pag->getIndirectCallsites());
+
+    outs() << "\n";
+    return true;
+}
+
 /*!
  * Dump points-to of each pag node
  */
@@ -489,6 +804,60 @@ void BVDataPTAImpl::onTheFlyCallGraphSolve(const CallSiteToFunPtrMap& callsites,
     }
 }
 
+/*!
+ * On the fly call graph construction which only resolves a call site again
+ * when the points-to set of its function pointer (vtable pointer for virtual
+ * calls) changed since it was last resolved. Call sites are indexed by that
+ * pointer so that call sites sharing one are checked once. The index is
+ * rebuilt, and every call site resolved again, when a different map is
+ * passed or the SVFIR gained indirect call sites.
+ */
+void BVDataPTAImpl::onTheFlyChangedCallGraphSolve(const CallSiteToFunPtrMap& callsites, CallEdgeMap& newEdges)
+{
+    if (indexedCallSites != &callsites || indexedCallSitesGen != pag->getIndirectCallsitesGeneration())
+    {
+        funPtrToCallSites.clear();
+        resolvedFunPtrPts.clear();
+        for (const CallSiteToFunPtrMap::value_type& csfp : callsites)
+        {
+            const CallICFGNode* cs = csfp.first;
+            NodeID funPtr = csfp.second;
+            if (cs->isVirtualCall())
+            {
+                const SVFVar* vtbl = cs->getVtablePtr();
+                assert(vtbl != nullptr);
+                funPtr = vtbl->getId();
+            }
+            funPtrToCallSites[funPtr].push_back(cs);
+        }
+        indexedCallSites = &callsites;
+        indexedCallSitesGen = pag->getIndirectCallsitesGeneration();
+    }
+
+    for (const auto& fpcs : funPtrToCallSites)
+    {
+        const NodeID funPtr = fpcs.first;
+        const PointsTo& pts = getPts(funPtr);
+        Map<NodeID, PointsTo>::iterator resolved = resolvedFunPtrPts.find(funPtr);
+        if (resolved != resolvedFunPtrPts.end() && resolved->second == pts)
+            continue;
+
+        for (const CallICFGNode* cs : fpcs.second)
+        {
+            if (cs->isVirtualCall())
+                resolveCPPIndCalls(cs, pts, newEdges);
+            else
+                resolveIndCalls(cs, pts, newEdges);
+        }
+        numOfReResolvedCallSites += fpcs.second.size();
+
+        if (resolved == resolvedFunPtrPts.end())
+            resolvedFunPtrPts.emplace(funPtr, pts);
+        else
+            resolved->second = pts;
+    }
+}
+
 /*!
  * On the fly call graph construction respecting forksite
  * callsites is candidate indirect callsites need to be analyzed based on points-to results
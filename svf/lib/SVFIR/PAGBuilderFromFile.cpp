@@ -110,6 +110,8 @@ SVFIR* PAGBuilderFromFile::build()
 
     pag->setNodeNumAfterPAGBuild(pag->getTotalNodeNum());
 
+    pag->compactStorage();
+
     return pag;
 }
 
@@ -0,0 +1,2249 @@
+//===- SVFFileSystem.cpp -- Binary SVFIR writer and reader ------------------//
+
+#include "SVFIR/SVFFileSystem.h"
+#include "Graphs/CHG.h"
+#include "Graphs/CallGraph.h"
+#include "Graphs/ICFG.h"
+#include "MemoryModel/SVFLoop.h"
+#include "Util/CallGraphBuilder.h"
+#include "Util/ExtAPI.h"
+#include "Util/NodeIDAllocator.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+// Binary format (host byte order)
+// header:   magic, version
+// strings:  #strings, {length, characters}[#strings]
+// types:    #types, {kind, single value, byte size}[#types],
+//           #StInfos, stride[#StInfos], type contents, StInfo contents
+// objects:  #ObjTypeInfos, {type, flags, max offset, #elements, byte size}[...]
+// body:     shells of variables, ICFG nodes, basic blocks, statements,
+//           ICFG edges and loops, then their contents in the same order,
+//           the maps of the ICFG and SVFIR, the functions of the call graph,
+//           the class hierarchy, external API annotations, the state of the
+//           node ID allocator and the edge labels of SVFStmt.
+// Variables, ICFG nodes and class hierarchy nodes are referred to by their
+// IDs, everything else by its position in its table; NoRef stands for nullptr.
+// Containers are written as their number of elements followed by the elements.
+// The call graph is rebuilt from its functions and their direct calls.
+static const u32_t SVFIRFileMagic = 0x52495653;
+static const u32_t SVFIRFileVersion = 1;
+static const u32_t NoRef = ~0u;
+
+SVFIRWriter::SVFIRWriter(const SVFIR* svfir) : pag(svfir)
+{
+}
+
+/*!
+ * Write the body first, since it adds the types, objects and strings it
+ * refers to, then put the tables ahead of it in the file.
+ */
+bool SVFIRWriter::writeToFile(const SVFIR* svfir, const std::string& filename)
+{
+    outs() << "Writing SVFIR to '" << filename << "'...";
+
+    SVFIRWriter writer(svfir);
+    writer.writeShells();
+    writer.writeVars();
+    writer.writeBasicBlocks();
+    writer.writeICFGNodes();
+    writer.writeStmts();
+    writer.writeICFGEdges();
+    writer.writeLoops();
+    writer.writeSVFIRMaps();
+    writer.writeCallGraph();
+    writer.writeCHGraph();
+    writer.writeGlobals();
+    BinaryWriter body = std::move(writer.w);
+
+    writer.w.clear();
+    writer.writeObjTypeInfos();
+    BinaryWriter objTypeInfoTable = std::move(writer.w);
+
+    writer.w.clear();
+    writer.writeTypes();
+    BinaryWriter typeTable = std::move(writer.w);
+
+    writer.w.clear();
+    writer.w.write<u32_t>(SVFIRFileMagic);
+    writer.w.write<u32_t>(SVFIRFileVersion);
+    writer.writeStrings();
+
+    if (!writer.w.writeToFile(filename, false) || !typeTable.writeToFile(filename, true) ||
+            !objTypeInfoTable.writeToFile(filename, true) || !body.writeToFile(filename, true))
+    {
+        outs() << "  error opening file for writing!\n";
+        return false;
+    }
+    outs() << "\n";
+    return true;
+}
+
+u32_t SVFIRWriter::getStrIdx(const std::string& str)
+{
+    auto it = strToIdx.emplace(str, strs.size());
+    if (it.second)
+        strs.push_back(&it.first->first);
+    return it.first->second;
+}
+
+u32_t SVFIRWriter::getTypeIdx(const SVFType* type)
+{
+    if (type == nullptr)
+        return NoRef;
+    auto it = typeToIdx.emplace(type, types.size());
+    if (it.second)
+        types.push_back(type);
+    return it.first->second;
+}
+
+u32_t SVFIRWriter::getStInfoIdx(const StInfo* stInfo)
+{
+    if (stInfo == nullptr)
+        return NoRef;
+    auto it = stInfoToIdx.emplace(stInfo, stInfos.size());
+    if (it.second)
+        stInfos.push_back(stInfo);
+    return it.first->second;
+}
+
+void SVFIRWriter::writeStr(const std::string& str)
+{
+    w.write<u32_t>(getStrIdx(str));
+}
+
+void SVFIRWriter::writeType(const SVFType* type)
+{
+    w.write<u32_t>(getTypeIdx(type));
+}
+
+void SVFIRWriter::writeStInfo(const StInfo* stInfo)
+{
+    w.write<u32_t>(getStInfoIdx(stInfo));
+}
+
+void SVFIRWriter::writeObjTypeInfo(const ObjTypeInfo* objTypeInfo)
+{
+    if (objTypeInfo == nullptr)
+    {
+        w.write<u32_t>(NoRef);
+        return;
+    }
+    auto it = objTypeInfoToIdx.emplace(objTypeInfo, objTypeInfos.size());
+    if (it.second)
+        objTypeInfos.push_back(objTypeInfo);
+    w.write<u32_t>(it.first->second);
+}
+
+void SVFIRWriter::writeVar(const SVFVar* var)
+{
+    w.write<NodeID>(var ? var->getId() : NoRef);
+}
+
+void SVFIRWriter::writeICFGNode(const ICFGNode* node)
+{
+    w.write<NodeID>(node ? node->getId() : NoRef);
+}
+
+void SVFIRWriter::writeBB(const SVFBasicBlock* bb)
+{
+    if (bb == nullptr)
+    {
+        w.write<u32_t>(NoRef);
+        return;
+    }
+    auto it = bbToIdx.find(bb);
+    assert(it != bbToIdx.end() && "basic block not in a basic block graph?");
+    w.write<u32_t>(it != bbToIdx.end() ? it->second : NoRef);
+}
+
+void SVFIRWriter::writeStmt(const SVFStmt* stmt)
+{
+    if (stmt == nullptr)
+    {
+        w.write<u32_t>(NoRef);
+        return;
+    }
+    auto it = stmtToIdx.find(stmt);
+    assert(it != stmtToIdx.end() && "SVFStmt not in the SVFIR?");
+    w.write<u32_t>(it != stmtToIdx.end() ? it->second : NoRef);
+}
+
+void SVFIRWriter::writeICFGEdge(const ICFGEdge* edge)
+{
+    if (edge == nullptr)
+    {
+        w.write<u32_t>(NoRef);
+        return;
+    }
+    auto it = icfgEdgeToIdx.find(edge);
+    assert(it != icfgEdgeToIdx.end() && "ICFGEdge not in the ICFG?");
+    w.write<u32_t>(it != icfgEdgeToIdx.end() ? it->second : NoRef);
+}
+
+void SVFIRWriter::writeAccessPath(const AccessPath& ap)
+{
+    w.write<APOffset>(ap.fldIdx);
+    writeType(ap.gepPointeeType);
+    w.write<u32_t>(ap.idxOperandPairs.size());
+    for (const AccessPath::IdxOperandPair& pair : ap.idxOperandPairs)
+    {
+        writeVar(pair.first);
+        writeType(pair.second);
+    }
+}
+
+void SVFIRWriter::writeSVFValue(const SVFValue* value)
+{
+    writeType(value->type);
+    writeStr(value->name);
+    writeStr(value->sourceLoc);
+}
+
+/*!
+ * Kinds of all variables, ICFG nodes, statements and ICFG edges, and the
+ * basic blocks of each function, so that references can be resolved while
+ * reading their contents.
+ */
+void SVFIRWriter::writeShells()
+{
+    w.write<u32_t>(pag->IDToNodeMap.size());
+    for (const auto& it : pag->IDToNodeMap)
+    {
+        w.write<NodeID>(it.first);
+        w.write<u32_t>(it.second->getNodeKind());
+    }
+
+    const ICFG* icfg = pag->getICFG();
+    w.write<NodeID>(icfg->totalICFGNode);
+    w.write<u32_t>(icfg->IDToNodeMap.size());
+    for (const auto& it : icfg->IDToNodeMap)
+    {
+        w.write<NodeID>(it.first);
+        w.write<u32_t>(it.second->getNodeKind());
+    }
+
+    std::vector<const FunObjVar*> funs;
+    for (const auto& it : pag->IDToNodeMap)
+    {
+        const FunObjVar* fun = dyn_cast<FunObjVar>(it.second);
+        if (fun && fun->bbGraph)
+            funs.push_back(fun);
+    }
+    w.write<u32_t>(funs.size());
+    for (const FunObjVar* fun : funs)
+    {
+        writeVar(fun);
+        w.write<u32_t>(fun->bbGraph->IDToNodeMap.size());
+        for (const auto& it : fun->bbGraph->IDToNodeMap)
+        {
+            w.write<NodeID>(it.first);
+            bbToIdx.emplace(it.second, bbToIdx.size());
+        }
+    }
+
+    for (const auto& it : pag->KindToSVFStmtSetMap)
+        stmts.insert(stmts.end(), it.second.begin(), it.second.end());
+    std::stable_sort(stmts.begin(), stmts.end(), [](const SVFStmt* a, const SVFStmt* b)
+    {
+        return a->getEdgeID() < b->getEdgeID();
+    });
+    w.write<u32_t>(stmts.size());
+    for (const SVFStmt* stmt : stmts)
+    {
+        stmtToIdx.emplace(stmt, stmtToIdx.size());
+        w.write<u32_t>(stmt->getEdgeKind());
+    }
+
+    for (const auto& it : icfg->IDToNodeMap)
+    {
+        for (const ICFGEdge* edge : it.second->getOutEdges())
+        {
+            icfgEdgeToIdx.emplace(edge, icfgEdges.size());
+            icfgEdges.push_back(edge);
+        }
+    }
+    w.write<u32_t>(icfgEdges.size());
+    for (const ICFGEdge* edge : icfgEdges)
+        w.write<u32_t>(edge->getEdgeKind());
+
+    for (const auto& it : icfg->icfgNodeToSVFLoopVec)
+    {
+        for (const SVFLoop* loop : it.second)
+        {
+            if (loopToIdx.emplace(loop, loops.size()).second)
+                loops.push_back(loop);
+        }
+    }
+    w.write<u32_t>(loops.size());
+}
+
+void SVFIRWriter::writeVars()
+{
+    for (const auto& it : pag->IDToNodeMap)
+    {
+        const SVFVar* var = it.second;
+        writeSVFValue(var);
+
+        if (const ValVar* valVar = dyn_cast<ValVar>(var))
+            writeICFGNode(valVar->icfgNode);
+        if (const BaseObjVar* baseObj = dyn_cast<BaseObjVar>(var))
+        {
+            writeObjTypeInfo(baseObj->typeInfo);
+            writeICFGNode(baseObj->icfgNode);
+        }
+
+        if (const ArgValVar* argVar = dyn_cast<ArgValVar>(var))
+        {
+            writeVar(argVar->cgNode);
+            w.write<u32_t>(argVar->argNo);
+        }
+        else if (const GepValVar* gepVar = dyn_cast<GepValVar>(var))
+        {
+            writeAccessPath(gepVar->ap);
+            writeVar(gepVar->base);
+            writeType(gepVar->gepValType);
+        }
+        else if (const FunValVar* funVar = dyn_cast<FunValVar>(var))
+        {
+            writeVar(funVar->funObjVar);
+        }
+        else if (const ConstFPValVar* fpVar = dyn_cast<ConstFPValVar>(var))
+        {
+            w.write<double>(fpVar->dval);
+        }
+        else if (const ConstIntValVar* intVar = dyn_cast<ConstIntValVar>(var))
+        {
+            w.write<u64_t>(intVar->zval);
+            w.write<s64_t>(intVar->sval);
+        }
+        else if (const RetValPN* retVar = dyn_cast<RetValPN>(var))
+        {
+            writeVar(retVar->callGraphNode);
+        }
+        else if (const VarArgValPN* varargVar = dyn_cast<VarArgValPN>(var))
+        {
+            writeVar(varargVar->callGraphNode);
+        }
+        else if (const GepObjVar* gepObj = dyn_cast<GepObjVar>(var))
+        {
+            w.write<APOffset>(gepObj->apOffset);
+            writeVar(gepObj->base);
+        }
+        else if (const ConstFPObjVar* fpObj = dyn_cast<ConstFPObjVar>(var))
+        {
+            w.write<float>(fpObj->dval);
+        }
+        else if (const ConstIntObjVar* intObj = dyn_cast<ConstIntObjVar>(var))
+        {
+            w.write<u64_t>(intObj->zval);
+            w.write<s64_t>(intObj->sval);
+        }
+        else if (const FunObjVar* fun = dyn_cast<FunObjVar>(var))
+        {
+            w.write<u8_t>(fun->isDecl);
+            w.write<u8_t>(fun->intrinsic);
+            w.write<u8_t>(fun->isAddrTaken);
+            w.write<u8_t>(fun->isUncalled);
+            w.write<u8_t>(fun->isNotRet);
+            w.write<u8_t>(fun->supVarArg);
+            writeType(fun->funcType);
+            writeVar(fun->realDefFun);
+            writeVars(fun->allArgs);
+            writeBB(fun->exitBlock);
+
+            const SVFLoopAndDomInfo* ld = fun->loopAndDom;
+            w.write<u8_t>(ld != nullptr);
+            if (ld == nullptr)
+                continue;
+            writeBBs(ld->reachableBBs);
+            for (const auto* bbsMap : {&ld->dtBBsMap, &ld->pdtBBsMap, &ld->dfBBsMap})
+            {
+                w.write<u32_t>(bbsMap->size());
+                for (const auto& bbs : *bbsMap)
+                {
+                    writeBB(bbs.first);
+                    writeBBs(bbs.second);
+                }
+            }
+            w.write<u32_t>(ld->bb2LoopMap.size());
+            for (const auto& loop : ld->bb2LoopMap)
+            {
+                writeBB(loop.first);
+                writeBBs(loop.second);
+            }
+            w.write<u32_t>(ld->bb2PdomLevel.size());
+            for (const auto& level : ld->bb2PdomLevel)
+            {
+                writeBB(level.first);
+                w.write<u32_t>(level.second);
+            }
+            w.write<u32_t>(ld->bb2PIdom.size());
+            for (const auto& idom : ld->bb2PIdom)
+            {
+                writeBB(idom.first);
+                writeBB(idom.second);
+            }
+        }
+    }
+}
+
+void SVFIRWriter::writeBasicBlocks()
+{
+    for (const auto& it : pag->IDToNodeMap)
+    {
+        const FunObjVar* fun = dyn_cast<FunObjVar>(it.second);
+        if (fun == nullptr || fun->bbGraph == nullptr)
+            continue;
+        for (const auto& bbIt : fun->bbGraph->IDToNodeMap)
+        {
+            const SVFBasicBlock* bb = bbIt.second;
+            writeSVFValue(bb);
+            writeICFGNodes(bb->allICFGNodes);
+            writeBBs(bb->succBBs);
+            writeBBs(bb->predBBs);
+            w.write<u32_t>(bb->getOutEdges().size());
+            for (const BasicBlockEdge* edge : bb->getOutEdges())
+                writeBB(edge->getDstNode());
+        }
+    }
+}
+
+void SVFIRWriter::writeICFGNodes()
+{
+    const ICFG* icfg = pag->getICFG();
+    for (const auto& it : icfg->IDToNodeMap)
+    {
+        const ICFGNode* node = it.second;
+        writeSVFValue(node);
+        writeVar(node->fun);
+        writeBB(node->bb);
+        writeStmts(node->pagEdges);
+
+        if (const IntraICFGNode* intra = dyn_cast<IntraICFGNode>(node))
+        {
+            w.write<u8_t>(intra->isRet);
+        }
+        else if (const FunEntryICFGNode* entry = dyn_cast<FunEntryICFGNode>(node))
+        {
+            writeVars(entry->FPNodes);
+        }
+        else if (const FunExitICFGNode* exit = dyn_cast<FunExitICFGNode>(node))
+        {
+            writeVar(exit->formalRet);
+        }
+        else if (const CallICFGNode* call = dyn_cast<CallICFGNode>(node))
+        {
+            writeICFGNode(call->ret);
+            writeVars(call->APNodes);
+            writeVar(call->calledFunc);
+            w.write<u8_t>(call->isvararg);
+            w.write<u8_t>(call->isVirCallInst);
+            writeVar(call->vtabPtr);
+            w.write<s32_t>(call->virtualFunIdx);
+            writeStr(call->funNameOfVcall);
+        }
+        else if (const RetICFGNode* ret = dyn_cast<RetICFGNode>(node))
+        {
+            writeVar(ret->actualRet);
+            writeICFGNode(ret->callBlockNode);
+        }
+    }
+
+    w.write<u32_t>(icfg->FunToFunEntryNodeMap.size());
+    for (const auto& it : icfg->FunToFunEntryNodeMap)
+    {
+        writeVar(it.first);
+        writeICFGNode(it.second);
+    }
+    w.write<u32_t>(icfg->FunToFunExitNodeMap.size());
+    for (const auto& it : icfg->FunToFunExitNodeMap)
+    {
+        writeVar(it.first);
+        writeICFGNode(it.second);
+    }
+    writeICFGNode(icfg->globalBlockNode);
+    w.write<u32_t>(icfg->_subNodes.size());
+    for (const auto& it : icfg->_subNodes)
+    {
+        writeICFGNode(it.first);
+        writeICFGNodes(it.second);
+    }
+    w.write<u32_t>(icfg->_repNode.size());
+    for (const auto& it : icfg->_repNode)
+    {
+        writeICFGNode(it.first);
+        writeICFGNode(it.second);
+    }
+    w.write<u32_t>(icfg->nodeNum);
+    w.write<u32_t>(icfg->edgeNum);
+}
+
+void SVFIRWriter::writeStmts()
+{
+    for (const SVFStmt* stmt : stmts)
+    {
+        w.write<EdgeID>(stmt->edgeId);
+        writeVar(stmt->getSrcNode());
+        writeVar(stmt->getDstNode());
+        w.write<u64_t>(stmt->edgeFlag);
+        writeVar(stmt->value);
+        writeBB(stmt->basicBlock);
+        writeICFGNode(stmt->icfgNode);
+        auto ptaStmts = pag->KindToPTASVFStmtSetMap.find(stmt->getEdgeKind());
+        w.write<u8_t>(ptaStmts != pag->KindToPTASVFStmtSetMap.end() &&
+                      ptaStmts->second.count(const_cast<SVFStmt*>(stmt)));
+
+        if (const AddrStmt* addr = dyn_cast<AddrStmt>(stmt))
+        {
+            writeVars(addr->arrSize);
+        }
+        else if (const CopyStmt* copy = dyn_cast<CopyStmt>(stmt))
+        {
+            w.write<u32_t>(copy->copyKind);
+        }
+        else if (const GepStmt* gep = dyn_cast<GepStmt>(stmt))
+        {
+            writeAccessPath(gep->ap);
+            w.write<u8_t>(gep->variantField);
+        }
+        else if (const CallPE* callPE = dyn_cast<CallPE>(stmt))
+        {
+            writeICFGNode(callPE->call);
+            writeICFGNode(callPE->entry);
+        }
+        else if (const RetPE* retPE = dyn_cast<RetPE>(stmt))
+        {
+            writeICFGNode(retPE->call);
+            writeICFGNode(retPE->exit);
+        }
+        else if (const MultiOpndStmt* multi = dyn_cast<MultiOpndStmt>(stmt))
+        {
+            writeVars(multi->opVars);
+            if (const PhiStmt* phi = dyn_cast<PhiStmt>(stmt))
+                writeICFGNodes(phi->opICFGNodes);
+            else if (const SelectStmt* select = dyn_cast<SelectStmt>(stmt))
+                writeVar(select->condition);
+            else if (const CmpStmt* cmp = dyn_cast<CmpStmt>(stmt))
+                w.write<u32_t>(cmp->predicate);
+            else if (const BinaryOPStmt* binary = dyn_cast<BinaryOPStmt>(stmt))
+                w.write<u32_t>(binary->opcode);
+        }
+        else if (const UnaryOPStmt* unary = dyn_cast<UnaryOPStmt>(stmt))
+        {
+            w.write<u32_t>(unary->opcode);
+        }
+        else if (const BranchStmt* branch = dyn_cast<BranchStmt>(stmt))
+        {
+            w.write<u32_t>(branch->successors.size());
+            for (const auto& succ : branch->successors)
+            {
+                writeICFGNode(succ.first);
+                w.write<s32_t>(succ.second);
+            }
+            writeVar(branch->cond);
+            writeVar(branch->brInst);
+        }
+    }
+}
+
+void SVFIRWriter::writeICFGEdges()
+{
+    for (const ICFGEdge* edge : icfgEdges)
+    {
+        writeICFGNode(edge->getSrcNode());
+        writeICFGNode(edge->getDstNode());
+        w.write<u64_t>(edge->edgeFlag);
+        if (const IntraCFGEdge* intra = dyn_cast<IntraCFGEdge>(edge))
+        {
+            writeVar(intra->conditionVar);
+            w.write<s64_t>(intra->branchCondVal);
+        }
+        else if (const CallCFGEdge* call = dyn_cast<CallCFGEdge>(edge))
+        {
+            writeStmts(call->callPEs);
+        }
+        else if (const RetCFGEdge* ret = dyn_cast<RetCFGEdge>(edge))
+        {
+            writeStmt(ret->retPE);
+        }
+    }
+}
+
+void SVFIRWriter::writeLoops()
+{
+    for (const SVFLoop* loop : loops)
+    {
+        for (const auto* edges : {&loop->entryICFGEdges, &loop->backICFGEdges,
+                                  &loop->inICFGEdges, &loop->outICFGEdges})
+        {
+            w.write<u32_t>(edges->size());
+            for (const ICFGEdge* edge : *edges)
+                writeICFGEdge(edge);
+        }
+        writeICFGNodes(loop->icfgNodes);
+        w.write<u32_t>(loop->loopBound);
+    }
+
+    const ICFG* icfg = pag->getICFG();
+    w.write<u32_t>(icfg->icfgNodeToSVFLoopVec.size());
+    for (const auto& it : icfg->icfgNodeToSVFLoopVec)
+    {
+        writeICFGNode(it.first);
+        w.write<u32_t>(it.second.size());
+        for (const SVFLoop* loop : it.second)
+            w.write<u32_t>(loopToIdx.at(loop));
+    }
+}
+
+void SVFIRWriter::writeSVFIRMaps()
+{
+    for (const auto* stmtsMap : {&pag->icfgNode2SVFStmtsMap, &pag->icfgNode2PTASVFStmtsMap})
+    {
+        w.write<u32_t>(stmtsMap->size());
+        for (const auto& it : *stmtsMap)
+        {
+            writeICFGNode(it.first);
+            writeStmts(it.second);
+        }
+    }
+
+    w.write<u32_t>(pag->GepValObjMap.size());
+    for (const auto& it : pag->GepValObjMap)
+    {
+        w.write<NodeID>(it.first);
+        w.write<u32_t>(it.second.size());
+        for (const auto& gep : it.second)
+        {
+            w.write<NodeID>(gep.first.first);
+            writeAccessPath(gep.first.second);
+            w.write<NodeID>(gep.second);
+        }
+    }
+    w.write<u32_t>(pag->typeLocSetsMap.size());
+    for (const auto& it : pag->typeLocSetsMap)
+    {
+        w.write<NodeID>(it.first);
+        writeType(it.second.first);
+        w.write<u32_t>(it.second.second.size());
+        for (const AccessPath& ap : it.second.second)
+            writeAccessPath(ap);
+    }
+    w.write<u32_t>(pag->GepObjVarMap.size());
+    for (const auto& it : pag->GepObjVarMap)
+    {
+        w.write<NodeID>(it.first.first);
+        w.write<APOffset>(it.first.second);
+        w.write<NodeID>(it.second);
+    }
+    w.write<u32_t>(pag->memToFieldsMap.size());
+    for (const auto& it : pag->memToFieldsMap)
+    {
+        w.write<NodeID>(it.first);
+        w.write<u32_t>(it.second.count());
+        for (NodeID field : it.second)
+            w.write<NodeID>(field);
+    }
+    writeStmts(pag->globSVFStmtSet);
+    w.write<u32_t>(pag->phiNodeMap.size());
+    for (const auto& it : pag->phiNodeMap)
+    {
+        writeVar(it.first);
+        writeStmt(it.second);
+    }
+    w.write<u32_t>(pag->funArgsListMap.size());
+    for (const auto& it : pag->funArgsListMap)
+    {
+        writeVar(it.first);
+        writeVars(it.second);
+    }
+    w.write<u32_t>(pag->callSiteArgsListMap.size());
+    for (const auto& it : pag->callSiteArgsListMap)
+    {
+        writeICFGNode(it.first);
+        writeVars(it.second);
+    }
+    w.write<u32_t>(pag->callSiteRetMap.size());
+    for (const auto& it : pag->callSiteRetMap)
+    {
+        writeICFGNode(it.first);
+        writeVar(it.second);
+    }
+    w.write<u32_t>(pag->funRetMap.size());
+    for (const auto& it : pag->funRetMap)
+    {
+        writeVar(it.first);
+        writeVar(it.second);
+    }
+    w.write<u32_t>(pag->indCallSiteToFunPtrMap.size());
+    for (const auto& it : pag->indCallSiteToFunPtrMap)
+    {
+        writeICFGNode(it.first);
+        w.write<NodeID>(it.second);
+    }
+    w.write<u32_t>(pag->funPtrToCallSitesMap.size());
+    for (const auto& it : pag->funPtrToCallSitesMap)
+    {
+        w.write<NodeID>(it.first);
+        writeICFGNodes(it.second);
+    }
+    writeNodeIDs(pag->candidatePointers);
+    writeICFGNodes(pag->callSiteSet);
+    writeStr(pag->moduleIdentifier);
+
+    for (const auto* symMap : {&pag->returnFunObjSymMap, &pag->varargFunObjSymMap})
+    {
+        w.write<u32_t>(symMap->size());
+        for (const auto& it : *symMap)
+        {
+            writeVar(it.first);
+            w.write<NodeID>(it.second);
+        }
+    }
+    w.write<u32_t>(pag->objTypeInfoMap.size());
+    for (const auto& it : pag->objTypeInfoMap)
+    {
+        w.write<NodeID>(it.first);
+        writeObjTypeInfo(it.second);
+    }
+    w.write<NodeID>(pag->totalSymNum);
+    w.write<u8_t>(pag->fromFile);
+    w.write<NodeID>(pag->nodeNumAfterPAGBuild);
+    w.write<u32_t>(pag->totalPTAPAGEdge);
+    w.write<u32_t>(pag->valVarNum);
+    w.write<u32_t>(pag->objVarNum);
+    writeType(pag->maxStruct);
+    w.write<u32_t>(pag->maxStSize);
+    w.write<u32_t>(pag->nodeNum);
+    w.write<u32_t>(pag->edgeNum);
+}
+
+void SVFIRWriter::writeCallGraph()
+{
+    const CallGraph* callGraph = pag->callGraph;
+    w.write<u32_t>(callGraph ? callGraph->getTotalNodeNum() : 0);
+    if (callGraph == nullptr)
+        return;
+    for (const auto& it : *callGraph)
+        writeVar(it.second->getFunction());
+}
+
+void SVFIRWriter::writeCHGraph()
+{
+    const CHGraph* chg = pag->chgraph ? dyn_cast<CHGraph>(pag->chgraph) : nullptr;
+    w.write<u8_t>(chg != nullptr);
+    if (chg == nullptr)
+        return;
+
+    w.write<u32_t>(chg->classNum);
+    w.write<u32_t>(chg->vfID);
+    w.write<double>(chg->buildingCHGTime);
+    w.write<u32_t>(chg->IDToNodeMap.size());
+    u32_t numOfEdges = 0;
+    for (const auto& it : chg->IDToNodeMap)
+    {
+        const CHNode* node = it.second;
+        w.write<NodeID>(node->getId());
+        writeStr(node->className);
+        w.write<u64_t>(node->flags);
+        writeVar(node->vtable);
+        w.write<u32_t>(node->virtualFunctionVectors.size());
+        for (const CHNode::FuncVector& funcs : node->virtualFunctionVectors)
+            writeVars(funcs);
+        numOfEdges += node->getOutEdges().size();
+    }
+    w.write<u32_t>(numOfEdges);
+    for (const auto& it : chg->IDToNodeMap)
+    {
+        for (const CHEdge* edge : it.second->getOutEdges())
+        {
+            w.write<NodeID>(edge->getSrcID());
+            w.write<NodeID>(edge->getDstID());
+            w.write<u32_t>(edge->edgeType);
+            w.write<u64_t>(edge->edgeFlag);
+        }
+    }
+    w.write<u32_t>(chg->nodeNum);
+    w.write<u32_t>(chg->edgeNum);
+
+    w.write<u32_t>(chg->classNameToNodeMap.size());
+    for (const auto& it : chg->classNameToNodeMap)
+    {
+        writeStr(it.first);
+        w.write<NodeID>(it.second->getId());
+    }
+    for (const CHGraph::NameToCHNodesMap* nodesMap :
+            {&chg->classNameToDescendantsMap, &chg->classNameToAncestorsMap,
+             &chg->classNameToInstAndDescsMap, &chg->templateNameToInstancesMap})
+    {
+        w.write<u32_t>(nodesMap->size());
+        for (const auto& it : *nodesMap)
+        {
+            writeStr(it.first);
+            w.write<u32_t>(it.second.size());
+            for (const CHNode* node : it.second)
+                w.write<NodeID>(node->getId());
+        }
+    }
+    w.write<u32_t>(chg->callNodeToClassesMap.size());
+    for (const auto& it : chg->callNodeToClassesMap)
+    {
+        writeICFGNode(it.first);
+        w.write<u32_t>(it.second.size());
+        for (const CHNode* node : it.second)
+            w.write<NodeID>(node->getId());
+    }
+    w.write<u32_t>(chg->virtualFunctionToIDMap.size());
+    for (const auto& it : chg->virtualFunctionToIDMap)
+    {
+        writeVar(it.first);
+        w.write<u32_t>(it.second);
+    }
+    w.write<u32_t>(chg->callNodeToCHAVtblsMap.size());
+    for (const auto& it : chg->callNodeToCHAVtblsMap)
+    {
+        writeICFGNode(it.first);
+        writeVars(it.second);
+    }
+    w.write<u32_t>(chg->callNodeToCHAVFnsMap.size());
+    for (const auto& it : chg->callNodeToCHAVFnsMap)
+    {
+        writeICFGNode(it.first);
+        writeVars(it.second);
+    }
+}
+
+void SVFIRWriter::writeGlobals()
+{
+    const ExtAPI* extAPI = ExtAPI::getExtAPI();
+    w.write<u32_t>(extAPI->funObjVar2Annotations.size());
+    for (const auto& it : extAPI->funObjVar2Annotations)
+    {
+        writeVar(it.first);
+        w.write<u32_t>(it.second.size());
+        for (const std::string& annotation : it.second)
+            writeStr(annotation);
+    }
+
+    const NodeIDAllocator* allocator = NodeIDAllocator::get();
+    w.write<NodeID>(allocator->numObjects);
+    w.write<NodeID>(allocator->numValues);
+    w.write<NodeID>(allocator->numSymbols);
+    w.write<NodeID>(allocator->numNodes);
+    w.write<u32_t>(allocator->strategy);
+
+    w.write<u32_t>(SVFStmt::inst2LabelMap.size());
+    for (const auto& it : SVFStmt::inst2LabelMap)
+    {
+        writeICFGNode(it.first);
+        w.write<u32_t>(it.second);
+    }
+    w.write<u32_t>(SVFStmt::var2LabelMap.size());
+    for (const auto& it : SVFStmt::var2LabelMap)
+    {
+        writeVar(it.first);
+        w.write<u32_t>(it.second);
+    }
+    w.write<u64_t>(SVFStmt::callEdgeLabelCounter);
+    w.write<u64_t>(SVFStmt::storeEdgeLabelCounter);
+    w.write<u64_t>(SVFStmt::multiOpndLabelCounter);
+
+    writeType(SVFType::svfPtrTy);
+    writeType(SVFType::svfI8Ty);
+}
+
+void SVFIRWriter::writeObjTypeInfos()
+{
+    w.write<u32_t>(objTypeInfos.size());
+    for (const ObjTypeInfo* objTypeInfo : objTypeInfos)
+    {
+        writeType(objTypeInfo->type);
+        w.write<u32_t>(objTypeInfo->flags);
+        w.write<u32_t>(objTypeInfo->maxOffsetLimit);
+        w.write<u32_t>(objTypeInfo->elemNum);
+        w.write<u32_t>(objTypeInfo->byteSize);
+    }
+}
+
+/*!
+ * Close the types and StInfos over the ones they refer to before writing,
+ * so that all shells come ahead of the contents.
+ */
+void SVFIRWriter::writeTypes()
+{
+    for (size_t i = 0, j = 0; i < types.size() || j < stInfos.size();)
+    {
+        for (; i < types.size(); ++i)
+        {
+            const SVFType* type = types[i];
+            getStInfoIdx(type->typeinfo);
+            if (const SVFFunctionType* funType = dyn_cast<SVFFunctionType>(type))
+            {
+                getTypeIdx(funType->retTy);
+                for (const SVFType* param : funType->params)
+                    getTypeIdx(param);
+            }
+            else if (const SVFArrayType* arrType = dyn_cast<SVFArrayType>(type))
+                getTypeIdx(arrType->typeOfElement);
+        }
+        for (; j < stInfos.size(); ++j)
+        {
+            const StInfo* stInfo = stInfos[j];
+            for (const auto& it : stInfo->fldIdx2TypeMap)
+                getTypeIdx(it.second);
+            for (const SVFType* type : stInfo->finfo)
+                getTypeIdx(type);
+            for (const SVFType* type : stInfo->flattenElementTypes)
+                getTypeIdx(type);
+        }
+    }
+
+    w.write<u32_t>(types.size());
+    for (const SVFType* type : types)
+    {
+        w.write<u32_t>(type->kind);
+        w.write<u8_t>(type->isSingleValTy);
+        w.write<u32_t>(type->byteSize);
+    }
+    w.write<u32_t>(stInfos.size());
+    for (const StInfo* stInfo : stInfos)
+        w.write<u32_t>(stInfo->stride);
+
+    for (const SVFType* type : types)
+    {
+        writeStInfo(type->typeinfo);
+        if (const SVFIntegerType* intType = dyn_cast<SVFIntegerType>(type))
+        {
+            w.write<s16_t>(intType->signAndWidth);
+        }
+        else if (const SVFFunctionType* funType = dyn_cast<SVFFunctionType>(type))
+        {
+            writeType(funType->retTy);
+            w.write<u32_t>(funType->params.size());
+            for (const SVFType* param : funType->params)
+                writeType(param);
+        }
+        else if (const SVFStructType* stType = dyn_cast<SVFStructType>(type))
+        {
+            writeStr(stType->name);
+        }
+        else if (const SVFArrayType* arrType = dyn_cast<SVFArrayType>(type))
+        {
+            w.write<u32_t>(arrType->numOfElement);
+            writeType(arrType->typeOfElement);
+        }
+        else if (const SVFOtherType* otherType = dyn_cast<SVFOtherType>(type))
+        {
+            writeStr(otherType->repr);
+        }
+    }
+    for (const StInfo* stInfo : stInfos)
+    {
+        for (const std::vector<u32_t>* idxVec : {&stInfo->fldIdxVec, &stInfo->elemIdxVec})
+        {
+            w.write<u32_t>(idxVec->size());
+            for (u32_t idx : *idxVec)
+                w.write<u32_t>(idx);
+        }
+        w.write<u32_t>(stInfo->fldIdx2TypeMap.size());
+        for (const auto& it : stInfo->fldIdx2TypeMap)
+        {
+            w.write<u32_t>(it.first);
+            writeType(it.second);
+        }
+        w.write<u32_t>(stInfo->finfo.size());
+        for (const SVFType* type : stInfo->finfo)
+            writeType(type);
+        w.write<u32_t>(stInfo->numOfFlattenElements);
+        w.write<u32_t>(stInfo->numOfFlattenFields);
+        w.write<u32_t>(stInfo->flattenElementTypes.size());
+        for (const SVFType* type : stInfo->flattenElementTypes)
+            writeType(type);
+    }
+}
+
+void SVFIRWriter::writeStrings()
+{
+    w.write<u32_t>(strs.size());
+    for (const std::string* str : strs)
+    {
+        w.write<u32_t>(str->size());
+        w.writeBytes(str->data(), str->size());
+    }
+}
+
+SVFIRReader::SVFIRReader(SVFIR* svfir, const BinaryReader& reader) : pag(svfir), r(reader), ok(true)
+{
+}
+
+bool SVFIRReader::isSVFIRFile(const std::string& filename)
+{
+    MappedFile file;
+    if (!file.open(filename))
+        return false;
+    BinaryReader reader = file.getReader();
+    u32_t magic = 0;
+    return reader.read(magic) && magic == SVFIRFileMagic;
+}
+
+/*!
+ * Read the SVFIR into the (empty) SVFIR singleton. If the file turns out to
+ * be malformed, the singleton is released again.
+ */
+SVFIR* SVFIRReader::read(const std::string& filename)
+{
+    outs() << "Loading SVFIR from '" << filename << "'...";
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        outs() << "  error opening file for reading!\n";
+        return nullptr;
+    }
+    BinaryReader reader = file.getReader();
+    u32_t magic = 0, version = 0;
+    if (!reader.read(magic) || magic != SVFIRFileMagic || !reader.read(version) ||
+            version != SVFIRFileVersion)
+    {
+        outs() << "  unsupported file format!\n";
+        return nullptr;
+    }
+
+    SVFIR* pag = SVFIR::getPAG();
+    assert(pag->getTotalNodeNum() == 0 && "SVFIR has been built before!");
+    SVFIRReader svfirReader(pag, reader);
+    if (!svfirReader.readAll())
+    {
+        outs() << "  malformed file!\n";
+        SVFIR::releaseSVFIR();
+        return nullptr;
+    }
+    pag->compactStorage();
+    outs() << "\n";
+    return pag;
+}
+
+bool SVFIRReader::readAll()
+{
+    readStrings();
+    readTypes();
+    readObjTypeInfos();
+    readShells();
+    readVars();
+    readBasicBlocks();
+    readICFGNodes();
+    readStmts();
+    readICFGEdges();
+    readLoops();
+    readSVFIRMaps();
+    readCallGraph();
+    readCHGraph();
+    readGlobals();
+    return ok && r.atEnd();
+}
+
+u32_t SVFIRReader::getCount()
+{
+    u32_t num = get<u32_t>();
+    if (num > r.remaining())
+    {
+        ok = false;
+        return 0;
+    }
+    return num;
+}
+
+const std::string& SVFIRReader::getStr()
+{
+    static const std::string empty;
+    u32_t idx = get<u32_t>();
+    if (idx < strs.size())
+        return strs[idx];
+    ok = false;
+    return empty;
+}
+
+SVFType* SVFIRReader::getType()
+{
+    u32_t idx = get<u32_t>();
+    if (idx == NoRef)
+        return nullptr;
+    if (idx < types.size())
+        return types[idx];
+    ok = false;
+    return nullptr;
+}
+
+StInfo* SVFIRReader::getStInfo()
+{
+    u32_t idx = get<u32_t>();
+    if (idx == NoRef)
+        return nullptr;
+    if (idx < stInfos.size())
+        return stInfos[idx];
+    ok = false;
+    return nullptr;
+}
+
+ObjTypeInfo* SVFIRReader::getObjTypeInfo()
+{
+    u32_t idx = get<u32_t>();
+    if (idx == NoRef)
+        return nullptr;
+    if (idx < objTypeInfos.size())
+        return objTypeInfos[idx];
+    ok = false;
+    return nullptr;
+}
+
+SVFVar* SVFIRReader::getVar()
+{
+    NodeID id = get<NodeID>();
+    if (id == NoRef)
+        return nullptr;
+    auto it = vars.find(id);
+    if (it != vars.end())
+        return it->second;
+    ok = false;
+    return nullptr;
+}
+
+ICFGNode* SVFIRReader::getICFGNode()
+{
+    NodeID id = get<NodeID>();
+    if (id == NoRef)
+        return nullptr;
+    auto it = icfgNodes.find(id);
+    if (it != icfgNodes.end())
+        return it->second;
+    ok = false;
+    return nullptr;
+}
+
+SVFBasicBlock* SVFIRReader::getBB()
+{
+    u32_t idx = get<u32_t>();
+    if (idx == NoRef)
+        return nullptr;
+    if (idx < bbs.size())
+        return bbs[idx];
+    ok = false;
+    return nullptr;
+}
+
+SVFStmt* SVFIRReader::getStmt()
+{
+    u32_t idx = get<u32_t>();
+    if (idx == NoRef)
+        return nullptr;
+    if (idx < stmts.size())
+        return stmts[idx];
+    ok = false;
+    return nullptr;
+}
+
+ICFGEdge* SVFIRReader::getICFGEdge()
+{
+    u32_t idx = get<u32_t>();
+    if (idx == NoRef)
+        return nullptr;
+    if (idx < icfgEdges.size())
+        return icfgEdges[idx];
+    ok = false;
+    return nullptr;
+}
+
+SVFLoop* SVFIRReader::getLoop()
+{
+    u32_t idx = get<u32_t>();
+    if (idx < loops.size())
+        return loops[idx];
+    ok = false;
+    return nullptr;
+}
+
+void SVFIRReader::getAccessPath(AccessPath& ap)
+{
+    ap.fldIdx = get<APOffset>();
+    ap.gepPointeeType = getType();
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const SVFVar* var = getVar();
+        const SVFType* type = getType();
+        ap.idxOperandPairs.emplace_back(var, type);
+    }
+}
+
+void SVFIRReader::getSVFValue(SVFValue* value)
+{
+    value->type = getType();
+    value->name = getStr();
+    value->sourceLoc = getStr();
+}
+
+void SVFIRReader::readStrings()
+{
+    u32_t num = getCount();
+    strs.reserve(num);
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        u32_t size = get<u32_t>();
+        const char* chars = ok ? r.readArray<char>(size) : nullptr;
+        if (chars == nullptr)
+        {
+            ok = false;
+            return;
+        }
+        strs.emplace_back(chars, size);
+    }
+}
+
+void SVFIRReader::readTypes()
+{
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        u32_t kind = get<u32_t>();
+        bool isSingleValTy = get<u8_t>();
+        u32_t byteSize = get<u32_t>();
+        SVFType* type = nullptr;
+        switch (kind)
+        {
+        case SVFType::SVFPointerTy:
+            type = new SVFPointerType(byteSize);
+            break;
+        case SVFType::SVFIntegerTy:
+            type = new SVFIntegerType(byteSize);
+            break;
+        case SVFType::SVFFunctionTy:
+            type = new SVFFunctionType(nullptr, std::vector<const SVFType*>());
+            break;
+        case SVFType::SVFStructTy:
+            type = new SVFStructType(byteSize);
+            break;
+        case SVFType::SVFArrayTy:
+            type = new SVFArrayType(byteSize);
+            break;
+        case SVFType::SVFOtherTy:
+            type = new SVFOtherType(isSingleValTy, byteSize);
+            break;
+        default:
+            ok = false;
+            return;
+        }
+        type->isSingleValTy = isSingleValTy;
+        type->byteSize = byteSize;
+        pag->addTypeInfo(type);
+        types.push_back(type);
+    }
+
+    num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        StInfo* stInfo = new StInfo(get<u32_t>());
+        pag->addStInfo(stInfo);
+        stInfos.push_back(stInfo);
+    }
+
+    for (SVFType* type : types)
+    {
+        type->typeinfo = getStInfo();
+        if (SVFIntegerType* intType = dyn_cast<SVFIntegerType>(type))
+        {
+            intType->signAndWidth = get<s16_t>();
+        }
+        else if (SVFFunctionType* funType = dyn_cast<SVFFunctionType>(type))
+        {
+            funType->retTy = getType();
+            u32_t numOfParams = getCount();
+            for (u32_t i = 0; i < numOfParams; ++i)
+                funType->params.push_back(getType());
+        }
+        else if (SVFStructType* stType = dyn_cast<SVFStructType>(type))
+        {
+            stType->name = getStr();
+        }
+        else if (SVFArrayType* arrType = dyn_cast<SVFArrayType>(type))
+        {
+            arrType->numOfElement = get<u32_t>();
+            arrType->typeOfElement = getType();
+        }
+        else if (SVFOtherType* otherType = dyn_cast<SVFOtherType>(type))
+        {
+            otherType->repr = getStr();
+        }
+    }
+    for (StInfo* stInfo : stInfos)
+    {
+        for (std::vector<u32_t>* idxVec : {&stInfo->fldIdxVec, &stInfo->elemIdxVec})
+        {
+            u32_t numOfIdx = getCount();
+            for (u32_t i = 0; i < numOfIdx; ++i)
+                idxVec->push_back(get<u32_t>());
+        }
+        u32_t numOfFields = getCount();
+        for (u32_t i = 0; i < numOfFields; ++i)
+        {
+            u32_t fldIdx = get<u32_t>();
+            stInfo->fldIdx2TypeMap[fldIdx] = getType();
+        }
+        u32_t numOfFinfo = getCount();
+        for (u32_t i = 0; i < numOfFinfo; ++i)
+            stInfo->finfo.push_back(getType());
+        stInfo->numOfFlattenElements = get<u32_t>();
+        stInfo->numOfFlattenFields = get<u32_t>();
+        u32_t numOfElements = getCount();
+        for (u32_t i = 0; i < numOfElements; ++i)
+            stInfo->flattenElementTypes.push_back(getType());
+    }
+}
+
+void SVFIRReader::readObjTypeInfos()
+{
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        const SVFType* type = getType();
+        u32_t flags = get<u32_t>();
+        u32_t maxOffsetLimit = get<u32_t>();
+        if (type == nullptr)
+        {
+            ok = false;
+            return;
+        }
+        ObjTypeInfo* objTypeInfo = new ObjTypeInfo(type, maxOffsetLimit);
+        objTypeInfo->flags = flags;
+        objTypeInfo->elemNum = get<u32_t>();
+        objTypeInfo->byteSize = get<u32_t>();
+        objTypeInfos.push_back(objTypeInfo);
+    }
+}
+
+SVFVar* SVFIRReader::createVar(NodeID id, GNodeK kind)
+{
+    switch (kind)
+    {
+    case SVFValue::ValNode:
+        return new ValVar(id);
+    case SVFValue::ArgValNode:
+        return new ArgValVar(id);
+    case SVFValue::FunValNode:
+        return new FunValVar(id, nullptr, nullptr, nullptr);
+    case SVFValue::GepValNode:
+        return new GepValVar(id);
+    case SVFValue::RetValNode:
+        return new RetValPN(id);
+    case SVFValue::VarargValNode:
+        return new VarArgValPN(id);
+    case SVFValue::GlobalValNode:
+        return new GlobalValVar(id, nullptr, nullptr);
+    case SVFValue::ConstAggValNode:
+        return new ConstAggValVar(id, nullptr, nullptr);
+    case SVFValue::ConstDataValNode:
+        return new ConstDataValVar(id, nullptr, nullptr);
+    case SVFValue::BlackHoleValNode:
+        return new BlackHoleValVar(id, nullptr);
+    case SVFValue::ConstFPValNode:
+        return new ConstFPValVar(id, 0, nullptr, nullptr);
+    case SVFValue::ConstIntValNode:
+        return new ConstIntValVar(id, 0, 0, nullptr, nullptr);
+    case SVFValue::ConstNullptrValNode:
+        return new ConstNullPtrValVar(id, nullptr, nullptr);
+    case SVFValue::DummyValNode:
+        return new DummyValVar(id, nullptr, nullptr);
+    case SVFValue::ObjNode:
+        return new ObjVar(id);
+    case SVFValue::GepObjNode:
+        return new GepObjVar(id);
+    case SVFValue::BaseObjNode:
+        return new BaseObjVar(id, nullptr);
+    case SVFValue::FunObjNode:
+    {
+        FunObjVar* fun = new FunObjVar(id, nullptr);
+        fun->initFunObjVar(false, false, false, false, false, false, nullptr, nullptr, nullptr, nullptr, {}, nullptr);
+        return fun;
+    }
+    case SVFValue::HeapObjNode:
+        return new HeapObjVar(id, nullptr);
+    case SVFValue::StackObjNode:
+        return new StackObjVar(id, nullptr);
+    case SVFValue::GlobalObjNode:
+        return new GlobalObjVar(id, nullptr);
+    case SVFValue::ConstAggObjNode:
+        return new ConstAggObjVar(id, nullptr, nullptr, nullptr);
+    case SVFValue::ConstDataObjNode:
+        return new ConstDataObjVar(id, nullptr);
+    case SVFValue::ConstFPObjNode:
+        return new ConstFPObjVar(id, nullptr);
+    case SVFValue::ConstIntObjNode:
+        return new ConstIntObjVar(id, nullptr);
+    case SVFValue::ConstNullptrObjNode:
+        return new ConstNullPtrObjVar(id, nullptr);
+    case SVFValue::DummyObjNode:
+        return new DummyObjVar(id, nullptr);
+    default:
+        return nullptr;
+    }
+}
+
+ICFGNode* SVFIRReader::createICFGNode(NodeID id, GNodeK kind)
+{
+    switch (kind)
+    {
+    case SVFValue::GlobalBlock:
+        return new GlobalICFGNode(id);
+    case SVFValue::IntraBlock:
+        return new IntraICFGNode(id);
+    case SVFValue::FunEntryBlock:
+        return new FunEntryICFGNode(id);
+    case SVFValue::FunExitBlock:
+        return new FunExitICFGNode(id);
+    case SVFValue::FunCallBlock:
+        return new CallICFGNode(id);
+    case SVFValue::FunRetBlock:
+        return new RetICFGNode(id);
+    default:
+        return nullptr;
+    }
+}
+
+SVFStmt* SVFIRReader::createStmt(GEdgeFlag kind)
+{
+    switch (kind)
+    {
+    case SVFStmt::Addr:
+        return new AddrStmt();
+    case SVFStmt::Copy:
+        return new CopyStmt();
+    case SVFStmt::Store:
+        return new StoreStmt();
+    case SVFStmt::Load:
+        return new LoadStmt();
+    case SVFStmt::Call:
+        return new CallPE();
+    case SVFStmt::Ret:
+        return new RetPE();
+    case SVFStmt::Gep:
+        return new GepStmt();
+    case SVFStmt::Phi:
+        return new PhiStmt();
+    case SVFStmt::Select:
+        return new SelectStmt();
+    case SVFStmt::Cmp:
+        return new CmpStmt();
+    case SVFStmt::BinaryOp:
+        return new BinaryOPStmt();
+    case SVFStmt::UnaryOp:
+        return new UnaryOPStmt();
+    case SVFStmt::Branch:
+        return new BranchStmt();
+    case SVFStmt::ThreadFork:
+        return new TDForkPE();
+    case SVFStmt::ThreadJoin:
+        return new TDJoinPE();
+    default:
+        return nullptr;
+    }
+}
+
+ICFGEdge* SVFIRReader::createICFGEdge(GEdgeFlag kind)
+{
+    switch (kind)
+    {
+    case ICFGEdge::IntraCF:
+        return new IntraCFGEdge(nullptr, nullptr);
+    case ICFGEdge::CallCF:
+        return new CallCFGEdge(nullptr, nullptr);
+    case ICFGEdge::RetCF:
+        return new RetCFGEdge(nullptr, nullptr);
+    default:
+        return nullptr;
+    }
+}
+
+void SVFIRReader::readShells()
+{
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        NodeID id = get<NodeID>();
+        GNodeK kind = static_cast<GNodeK>(get<u32_t>());
+        SVFVar* var = ok ? createVar(id, kind) : nullptr;
+        // The contents of a variable are read by its kind, so it must be exact
+        if (var == nullptr || var->getNodeKind() != kind || !vars.emplace(id, var).second)
+        {
+            delete var;
+            ok = false;
+            return;
+        }
+        if (BaseObjVar* baseObj = dyn_cast<BaseObjVar>(var))
+            baseObj->typeInfo = nullptr;
+        pag->addNode(var);
+        varOrder.push_back(id);
+    }
+
+    ICFG* icfg = new ICFG();
+    pag->icfg = icfg;
+    icfg->totalICFGNode = get<NodeID>();
+    num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        NodeID id = get<NodeID>();
+        GNodeK kind = static_cast<GNodeK>(get<u32_t>());
+        ICFGNode* node = ok ? createICFGNode(id, kind) : nullptr;
+        if (node == nullptr || node->getNodeKind() != kind || id >= icfg->totalICFGNode ||
+                !icfgNodes.emplace(id, node).second)
+        {
+            delete node;
+            ok = false;
+            return;
+        }
+        icfg->addICFGNode(node);
+        icfgNodeOrder.push_back(id);
+    }
+
+    num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        FunObjVar* fun = getVar<FunObjVar>();
+        u32_t numOfBBs = getCount();
+        if (fun == nullptr || fun->bbGraph != nullptr)
+        {
+            ok = false;
+            return;
+        }
+        fun->bbGraph = new BasicBlockGraph();
+        for (u32_t j = 0; j < numOfBBs && ok; ++j)
+        {
+            NodeID id = get<NodeID>();
+            SVFBasicBlock* bb = fun->bbGraph->addBasicBlock("");
+            bb->setFun(fun);
+            bbs.push_back(bb);
+            // Basic blocks are numbered in order within their function
+            if (bb->getId() != id)
+                ok = false;
+        }
+    }
+
+    num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        SVFStmt* stmt = createStmt(get<u32_t>());
+        if (stmt == nullptr)
+        {
+            ok = false;
+            return;
+        }
+        stmts.push_back(stmt);
+    }
+
+    num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        ICFGEdge* edge = createICFGEdge(get<u32_t>());
+        if (edge == nullptr)
+        {
+            ok = false;
+            return;
+        }
+        icfgEdges.push_back(edge);
+    }
+
+    num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+        loops.push_back(new SVFLoop({}, 0));
+}
+
+void SVFIRReader::readVars()
+{
+    for (NodeID id : varOrder)
+    {
+        if (!ok)
+            return;
+        SVFVar* var = vars[id];
+        getSVFValue(var);
+
+        if (ValVar* valVar = dyn_cast<ValVar>(var))
+            valVar->icfgNode = getICFGNode();
+        if (BaseObjVar* baseObj = dyn_cast<BaseObjVar>(var))
+        {
+            baseObj->typeInfo = getObjTypeInfo();
+            baseObj->icfgNode = getICFGNode();
+            if (baseObj->typeInfo == nullptr)
+                ok = false;
+        }
+
+        if (ArgValVar* argVar = dyn_cast<ArgValVar>(var))
+        {
+            argVar->cgNode = getVar<FunObjVar>();
+            argVar->argNo = get<u32_t>();
+        }
+        else if (GepValVar* gepVar = dyn_cast<GepValVar>(var))
+        {
+            getAccessPath(gepVar->ap);
+            gepVar->base = getVar<ValVar>();
+            gepVar->gepValType = getType();
+        }
+        else if (FunValVar* funVar = dyn_cast<FunValVar>(var))
+        {
+            funVar->funObjVar = getVar<FunObjVar>();
+        }
+        else if (ConstFPValVar* fpVar = dyn_cast<ConstFPValVar>(var))
+        {
+            fpVar->dval = get<double>();
+        }
+        else if (ConstIntValVar* intVar = dyn_cast<ConstIntValVar>(var))
+        {
+            intVar->zval = get<u64_t>();
+            intVar->sval = get<s64_t>();
+        }
+        else if (RetValPN* retVar = dyn_cast<RetValPN>(var))
+        {
+            retVar->callGraphNode = getVar<FunObjVar>();
+        }
+        else if (VarArgValPN* varargVar = dyn_cast<VarArgValPN>(var))
+        {
+            varargVar->callGraphNode = getVar<FunObjVar>();
+        }
+        else if (GepObjVar* gepObj = dyn_cast<GepObjVar>(var))
+        {
+            gepObj->apOffset = get<APOffset>();
+            gepObj->base = getVar<BaseObjVar>();
+        }
+        else if (ConstFPObjVar* fpObj = dyn_cast<ConstFPObjVar>(var))
+        {
+            fpObj->dval = get<float>();
+        }
+        else if (ConstIntObjVar* intObj = dyn_cast<ConstIntObjVar>(var))
+        {
+            intObj->zval = get<u64_t>();
+            intObj->sval = get<s64_t>();
+        }
+        else if (FunObjVar* fun = dyn_cast<FunObjVar>(var))
+        {
+            fun->isDecl = get<u8_t>();
+            fun->intrinsic = get<u8_t>();
+            fun->isAddrTaken = get<u8_t>();
+            fun->isUncalled = get<u8_t>();
+            fun->isNotRet = get<u8_t>();
+            fun->supVarArg = get<u8_t>();
+            fun->funcType = getType<SVFFunctionType>();
+            fun->realDefFun = getVar<FunObjVar>();
+            getVars<ArgValVar>(fun->allArgs);
+            fun->exitBlock = getBB();
+
+            if (!get<u8_t>())
+                continue;
+            SVFLoopAndDomInfo* ld = new SVFLoopAndDomInfo();
+            fun->loopAndDom = ld;
+            getBBs(ld->reachableBBs);
+            for (auto* bbsMap : {&ld->dtBBsMap, &ld->pdtBBsMap, &ld->dfBBsMap})
+            {
+                u32_t num = getCount();
+                for (u32_t i = 0; i < num; ++i)
+                {
+                    const SVFBasicBlock* bb = getBB();
+                    getBBs((*bbsMap)[bb]);
+                }
+            }
+            u32_t num = getCount();
+            for (u32_t i = 0; i < num; ++i)
+            {
+                const SVFBasicBlock* bb = getBB();
+                getBBs(ld->bb2LoopMap[bb]);
+            }
+            num = getCount();
+            for (u32_t i = 0; i < num; ++i)
+            {
+                const SVFBasicBlock* bb = getBB();
+                ld->bb2PdomLevel[bb] = get<u32_t>();
+            }
+            num = getCount();
+            for (u32_t i = 0; i < num; ++i)
+            {
+                const SVFBasicBlock* bb = getBB();
+                ld->bb2PIdom[bb] = getBB();
+            }
+        }
+    }
+}
+
+void SVFIRReader::readBasicBlocks()
+{
+    for (SVFBasicBlock* bb : bbs)
+    {
+        if (!ok)
+            return;
+        getSVFValue(bb);
+        getICFGNodes<ICFGNode>(bb->allICFGNodes);
+        getBBs(bb->succBBs);
+        getBBs(bb->predBBs);
+        u32_t numOfEdges = getCount();
+        for (u32_t i = 0; i < numOfEdges; ++i)
+        {
+            SVFBasicBlock* succ = getBB();
+            if (succ == nullptr)
+            {
+                ok = false;
+                return;
+            }
+            BasicBlockEdge* edge = new BasicBlockEdge(bb, succ);
+            if (!bb->addOutgoingEdge(edge))
+            {
+                delete edge;
+                ok = false;
+                return;
+            }
+            succ->addIncomingEdge(edge);
+        }
+    }
+}
+
+void SVFIRReader::readICFGNodes()
+{
+    for (NodeID id : icfgNodeOrder)
+    {
+        if (!ok)
+            return;
+        ICFGNode* node = icfgNodes[id];
+        getSVFValue(node);
+        node->fun = getVar<FunObjVar>();
+        node->bb = getBB();
+        getStmts<SVFStmt>(node->pagEdges);
+
+        if (IntraICFGNode* intra = dyn_cast<IntraICFGNode>(node))
+        {
+            intra->isRet = get<u8_t>();
+        }
+        else if (FunEntryICFGNode* entry = dyn_cast<FunEntryICFGNode>(node))
+        {
+            getVars<SVFVar>(entry->FPNodes);
+        }
+        else if (FunExitICFGNode* exit = dyn_cast<FunExitICFGNode>(node))
+        {
+            exit->formalRet = getVar();
+        }
+        else if (CallICFGNode* call = dyn_cast<CallICFGNode>(node))
+        {
+            call->ret = getICFGNode<RetICFGNode>();
+            getVars<ValVar>(call->APNodes);
+            call->calledFunc = getVar<FunObjVar>();
+            call->isvararg = get<u8_t>();
+            call->isVirCallInst = get<u8_t>();
+            call->vtabPtr = getVar();
+            call->virtualFunIdx = get<s32_t>();
+            call->funNameOfVcall = getStr();
+        }
+        else if (RetICFGNode* ret = dyn_cast<RetICFGNode>(node))
+        {
+            ret->actualRet = getVar();
+            ret->callBlockNode = getICFGNode<CallICFGNode>();
+        }
+    }
+
+    ICFG* icfg = pag->icfg;
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const FunObjVar* fun = getVar<FunObjVar>();
+        icfg->FunToFunEntryNodeMap[fun] = getICFGNode<FunEntryICFGNode>();
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const FunObjVar* fun = getVar<FunObjVar>();
+        icfg->FunToFunExitNodeMap[fun] = getICFGNode<FunExitICFGNode>();
+    }
+    icfg->globalBlockNode = getICFGNode<GlobalICFGNode>();
+    icfg->_subNodes.clear();
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const ICFGNode* node = getICFGNode();
+        getICFGNodes<ICFGNode>(icfg->_subNodes[node]);
+    }
+    icfg->_repNode.clear();
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const ICFGNode* node = getICFGNode();
+        icfg->_repNode[node] = getICFGNode();
+    }
+    icfg->nodeNum = get<u32_t>();
+    icfg->edgeNum = get<u32_t>();
+}
+
+void SVFIRReader::readStmts()
+{
+    for (SVFStmt* stmt : stmts)
+    {
+        if (!ok)
+            return;
+        stmt->edgeId = get<EdgeID>();
+        SVFVar* src = getVar();
+        SVFVar* dst = getVar();
+        GEdgeFlag flag = get<u64_t>();
+        if (src == nullptr || dst == nullptr || (flag & SVFStmt::EdgeKindMask) != stmt->edgeFlag)
+        {
+            ok = false;
+            return;
+        }
+        stmt->src = src;
+        stmt->dst = dst;
+        stmt->edgeFlag = flag;
+        stmt->value = getVar();
+        stmt->basicBlock = getBB();
+        stmt->icfgNode = getICFGNode();
+        bool isPTAStmt = get<u8_t>();
+
+        if (AddrStmt* addr = dyn_cast<AddrStmt>(stmt))
+        {
+            getVars<SVFVar>(addr->arrSize);
+        }
+        else if (CopyStmt* copy = dyn_cast<CopyStmt>(stmt))
+        {
+            copy->copyKind = get<u32_t>();
+        }
+        else if (GepStmt* gep = dyn_cast<GepStmt>(stmt))
+        {
+            getAccessPath(gep->ap);
+            gep->variantField = get<u8_t>();
+        }
+        else if (CallPE* callPE = dyn_cast<CallPE>(stmt))
+        {
+            callPE->call = getICFGNode<CallICFGNode>();
+            callPE->entry = getICFGNode<FunEntryICFGNode>();
+        }
+        else if (RetPE* retPE = dyn_cast<RetPE>(stmt))
+        {
+            retPE->call = getICFGNode<CallICFGNode>();
+            retPE->exit = getICFGNode<FunExitICFGNode>();
+        }
+        else if (MultiOpndStmt* multi = dyn_cast<MultiOpndStmt>(stmt))
+        {
+            getVars<SVFVar>(multi->opVars);
+            if (PhiStmt* phi = dyn_cast<PhiStmt>(stmt))
+                getICFGNodes<ICFGNode>(phi->opICFGNodes);
+            else if (SelectStmt* select = dyn_cast<SelectStmt>(stmt))
+                select->condition = getVar();
+            else if (CmpStmt* cmp = dyn_cast<CmpStmt>(stmt))
+                cmp->predicate = get<u32_t>();
+            else if (BinaryOPStmt* binary = dyn_cast<BinaryOPStmt>(stmt))
+                binary->opcode = get<u32_t>();
+        }
+        else if (UnaryOPStmt* unary = dyn_cast<UnaryOPStmt>(stmt))
+        {
+            unary->opcode = get<u32_t>();
+        }
+        else if (BranchStmt* branch = dyn_cast<BranchStmt>(stmt))
+        {
+            u32_t num = getCount();
+            for (u32_t i = 0; i < num; ++i)
+            {
+                const ICFGNode* succ = getICFGNode();
+                branch->successors.emplace_back(succ, get<s32_t>());
+            }
+            branch->cond = getVar();
+            branch->brInst = getVar();
+        }
+
+        if (!ok)
+            return;
+        pag->addEdge(src, dst, stmt);
+        pag->addToStmtTable(pag->KindToSVFStmtSetMap[stmt->getEdgeKind()], stmt);
+        if (isPTAStmt)
+            pag->addToStmtTable(pag->KindToPTASVFStmtSetMap[stmt->getEdgeKind()], stmt);
+    }
+}
+
+void SVFIRReader::readICFGEdges()
+{
+    for (ICFGEdge* edge : icfgEdges)
+    {
+        if (!ok)
+            return;
+        ICFGNode* src = getICFGNode();
+        ICFGNode* dst = getICFGNode();
+        GEdgeFlag flag = get<u64_t>();
+        if (src == nullptr || dst == nullptr || (flag & ICFGEdge::EdgeKindMask) != edge->edgeFlag)
+        {
+            ok = false;
+            return;
+        }
+        edge->src = src;
+        edge->dst = dst;
+        edge->edgeFlag = flag;
+        if (IntraCFGEdge* intra = dyn_cast<IntraCFGEdge>(edge))
+        {
+            intra->conditionVar = getVar();
+            intra->branchCondVal = get<s64_t>();
+        }
+        else if (CallCFGEdge* call = dyn_cast<CallCFGEdge>(edge))
+        {
+            getStmts<CallPE>(call->callPEs);
+        }
+        else if (RetCFGEdge* ret = dyn_cast<RetCFGEdge>(edge))
+        {
+            ret->retPE = getStmt<RetPE>();
+        }
+
+        if (!ok || !src->addOutgoingEdge(edge))
+        {
+            ok = false;
+            return;
+        }
+        dst->addIncomingEdge(edge);
+    }
+}
+
+void SVFIRReader::readLoops()
+{
+    for (SVFLoop* loop : loops)
+    {
+        if (!ok)
+            return;
+        for (auto* edges : {&loop->entryICFGEdges, &loop->backICFGEdges,
+                            &loop->inICFGEdges, &loop->outICFGEdges})
+        {
+            u32_t num = getCount();
+            for (u32_t i = 0; i < num; ++i)
+                edges->insert(getICFGEdge());
+        }
+        getICFGNodes<ICFGNode>(loop->icfgNodes);
+        loop->loopBound = get<u32_t>();
+    }
+
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const ICFGNode* node = getICFGNode();
+        ICFG::SVFLoopVec& nodeLoops = pag->icfg->icfgNodeToSVFLoopVec[node];
+        u32_t numOfLoops = getCount();
+        for (u32_t j = 0; j < numOfLoops; ++j)
+        {
+            if (SVFLoop* loop = getLoop())
+                nodeLoops.push_back(loop);
+        }
+    }
+}
+
+void SVFIRReader::readSVFIRMaps()
+{
+    for (auto* stmtsMap : {&pag->icfgNode2SVFStmtsMap, &pag->icfgNode2PTASVFStmtsMap})
+    {
+        u32_t num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+        {
+            const ICFGNode* node = getICFGNode();
+            getStmts<SVFStmt>((*stmtsMap)[node]);
+        }
+    }
+
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        SVFIR::NodeAccessPathMap& geps = pag->GepValObjMap[get<NodeID>()];
+        u32_t numOfGeps = getCount();
+        for (u32_t j = 0; j < numOfGeps; ++j)
+        {
+            NodeID base = get<NodeID>();
+            AccessPath ap;
+            getAccessPath(ap);
+            geps[std::make_pair(base, ap)] = get<NodeID>();
+        }
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        SVFIR::SVFTypeLocSetsPair& typeLocSets = pag->typeLocSetsMap[get<NodeID>()];
+        typeLocSets.first = getType();
+        u32_t numOfAps = getCount();
+        typeLocSets.second.resize(numOfAps);
+        for (AccessPath& ap : typeLocSets.second)
+            getAccessPath(ap);
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeID base = get<NodeID>();
+        APOffset offset = get<APOffset>();
+        pag->GepObjVarMap[std::make_pair(base, offset)] = get<NodeID>();
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeBS& fields = pag->memToFieldsMap[get<NodeID>()];
+        u32_t numOfFields = getCount();
+        for (u32_t j = 0; j < numOfFields; ++j)
+            fields.set(get<NodeID>());
+    }
+    getStmts<SVFStmt>(pag->globSVFStmtSet);
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const SVFVar* var = getVar();
+        pag->phiNodeMap[var] = getStmt<PhiStmt>();
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const FunObjVar* fun = getVar<FunObjVar>();
+        getVars<SVFVar>(pag->funArgsListMap[fun]);
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const CallICFGNode* call = getICFGNode<CallICFGNode>();
+        getVars<SVFVar>(pag->callSiteArgsListMap[call]);
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const RetICFGNode* ret = getICFGNode<RetICFGNode>();
+        pag->callSiteRetMap[ret] = getVar();
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const FunObjVar* fun = getVar<FunObjVar>();
+        pag->funRetMap[fun] = getVar();
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const CallICFGNode* call = getICFGNode<CallICFGNode>();
+        pag->indCallSiteToFunPtrMap[call] = get<NodeID>();
+    }
+    ++pag->indCallSiteGen;
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeID funPtr = get<NodeID>();
+        getICFGNodes<CallICFGNode>(pag->funPtrToCallSitesMap[funPtr]);
+    }
+    getNodeIDs(pag->candidatePointers);
+    getICFGNodes<CallICFGNode>(pag->callSiteSet);
+    pag->moduleIdentifier = getStr();
+
+    for (auto* symMap : {&pag->returnFunObjSymMap, &pag->varargFunObjSymMap})
+    {
+        num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+        {
+            const FunObjVar* fun = getVar<FunObjVar>();
+            (*symMap)[fun] = get<NodeID>();
+        }
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        NodeID id = get<NodeID>();
+        pag->objTypeInfoMap[id] = getObjTypeInfo();
+    }
+    pag->totalSymNum = get<NodeID>();
+    pag->fromFile = get<u8_t>();
+    pag->nodeNumAfterPAGBuild = get<NodeID>();
+    pag->totalPTAPAGEdge = get<u32_t>();
+    pag->valVarNum = get<u32_t>();
+    pag->objVarNum = get<u32_t>();
+    pag->maxStruct = getType();
+    pag->maxStSize = get<u32_t>();
+    pag->nodeNum = get<u32_t>();
+    pag->edgeNum = get<u32_t>();
+}
+
+void SVFIRReader::readCallGraph()
+{
+    std::vector<const FunObjVar*> funs;
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const FunObjVar* fun = getVar<FunObjVar>();
+        if (fun == nullptr || fun->bbGraph == nullptr)
+            ok = false;
+        funs.push_back(fun);
+    }
+    if (!ok)
+        return;
+    CallGraphBuilder callGraphBuilder;
+    pag->callGraph = callGraphBuilder.buildSVFIRCallGraph(funs);
+}
+
+void SVFIRReader::readCHGraph()
+{
+    bool hasCHG = get<u8_t>();
+    if (!ok)
+        return;
+    CHGraph* chg = new CHGraph();
+    pag->chgraph = chg;
+    if (!hasCHG)
+        return;
+
+    chg->classNum = get<u32_t>();
+    chg->vfID = get<u32_t>();
+    chg->buildingCHGTime = get<double>();
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        NodeID id = get<NodeID>();
+        const std::string& className = getStr();
+        if (!ok || chg->hasGNode(id))
+        {
+            ok = false;
+            return;
+        }
+        CHNode* node = new CHNode(className, id);
+        chg->addGNode(id, node);
+        node->flags = get<u64_t>();
+        node->vtable = getVar<GlobalObjVar>();
+        node->virtualFunctionVectors.resize(getCount());
+        for (CHNode::FuncVector& funcs : node->virtualFunctionVectors)
+            getVars<FunObjVar>(funcs);
+    }
+
+    auto getCHNode = [this, chg]() -> CHNode*
+    {
+        NodeID id = get<NodeID>();
+        if (ok && chg->hasGNode(id))
+            return chg->getGNode(id);
+        ok = false;
+        return nullptr;
+    };
+    num = getCount();
+    for (u32_t i = 0; i < num && ok; ++i)
+    {
+        CHNode* src = getCHNode();
+        CHNode* dst = getCHNode();
+        CHEdge::CHEDGETYPE edgeType = static_cast<CHEdge::CHEDGETYPE>(get<u32_t>());
+        GEdgeFlag flag = get<u64_t>();
+        if (!ok)
+            return;
+        CHEdge* edge = new CHEdge(src, dst, edgeType, flag);
+        if (!src->addOutgoingEdge(edge))
+        {
+            delete edge;
+            ok = false;
+            return;
+        }
+        dst->addIncomingEdge(edge);
+    }
+    chg->nodeNum = get<u32_t>();
+    chg->edgeNum = get<u32_t>();
+
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const std::string& className = getStr();
+        chg->classNameToNodeMap[className] = getCHNode();
+    }
+    for (CHGraph::NameToCHNodesMap* nodesMap :
+            {&chg->classNameToDescendantsMap, &chg->classNameToAncestorsMap,
+             &chg->classNameToInstAndDescsMap, &chg->templateNameToInstancesMap})
+    {
+        num = getCount();
+        for (u32_t i = 0; i < num; ++i)
+        {
+            CHGraph::CHNodeSetTy& nodes = (*nodesMap)[getStr()];
+            u32_t numOfNodes = getCount();
+            for (u32_t j = 0; j < numOfNodes; ++j)
+                nodes.insert(getCHNode());
+        }
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        CHGraph::CHNodeSetTy& nodes = chg->callNodeToClassesMap[getICFGNode()];
+        u32_t numOfNodes = getCount();
+        for (u32_t j = 0; j < numOfNodes; ++j)
+            nodes.insert(getCHNode());
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const FunObjVar* fun = getVar<FunObjVar>();
+        chg->virtualFunctionToIDMap[fun] = get<u32_t>();
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const ICFGNode* call = getICFGNode();
+        getVars<GlobalObjVar>(chg->callNodeToCHAVtblsMap[call]);
+    }
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const ICFGNode* call = getICFGNode();
+        getVars<FunObjVar>(chg->callNodeToCHAVFnsMap[call]);
+    }
+}
+
+/*!
+ * The state outside of the SVFIR is only changed once the whole file has been
+ * read, so that a malformed file leaves it as it was.
+ */
+void SVFIRReader::readGlobals()
+{
+    std::vector<std::pair<const FunObjVar*, std::vector<std::string>>> annotations(getCount());
+    for (auto& funAnnotations : annotations)
+    {
+        funAnnotations.first = getVar<FunObjVar>();
+        funAnnotations.second.resize(getCount());
+        for (std::string& annotation : funAnnotations.second)
+            annotation = getStr();
+        if (funAnnotations.first == nullptr)
+            ok = false;
+    }
+
+    NodeID numObjects = get<NodeID>();
+    NodeID numValues = get<NodeID>();
+    NodeID numSymbols = get<NodeID>();
+    NodeID numNodes = get<NodeID>();
+    u32_t strategy = get<u32_t>();
+    if (strategy > NodeIDAllocator::Strategy::DBUG)
+        ok = false;
+
+    SVFStmt::Inst2LabelMap inst2LabelMap;
+    u32_t num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const ICFGNode* node = getICFGNode();
+        inst2LabelMap[node] = get<u32_t>();
+    }
+    SVFStmt::Var2LabelMap var2LabelMap;
+    num = getCount();
+    for (u32_t i = 0; i < num; ++i)
+    {
+        const SVFVar* var = getVar();
+        var2LabelMap[var] = get<u32_t>();
+    }
+    u64_t callEdgeLabelCounter = get<u64_t>();
+    u64_t storeEdgeLabelCounter = get<u64_t>();
+    u64_t multiOpndLabelCounter = get<u64_t>();
+
+    SVFType* svfPtrTy = getType();
+    SVFType* svfI8Ty = getType();
+
+    if (!ok || !r.atEnd())
+        return;
+
+    ExtAPI* extAPI = ExtAPI::getExtAPI();
+    for (const auto& funAnnotations : annotations)
+        extAPI->setExtFuncAnnotations(funAnnotations.first, funAnnotations.second);
+
+    NodeIDAllocator* allocator = NodeIDAllocator::get();
+    allocator->numObjects = numObjects;
+    allocator->numValues = numValues;
+    allocator->numSymbols = numSymbols;
+    allocator->numNodes = numNodes;
+    allocator->strategy = static_cast<NodeIDAllocator::Strategy>(strategy);
+
+    SVFStmt::inst2LabelMap.insert(inst2LabelMap.begin(), inst2LabelMap.end());
+    SVFStmt::var2LabelMap.insert(var2LabelMap.begin(), var2LabelMap.end());
+    SVFStmt::callEdgeLabelCounter = callEdgeLabelCounter;
+    SVFStmt::storeEdgeLabelCounter = storeEdgeLabelCounter;
+    SVFStmt::multiOpndLabelCounter = multiOpndLabelCounter;
+
+    SVFType::svfPtrTy = svfPtrTy;
+    SVFType::svfI8Ty = svfI8Ty;
+}
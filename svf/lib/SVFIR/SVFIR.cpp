@@ -11,7 +11,7 @@ std::unique_ptr<SVFIR> SVFIR::pag;
 
 std::string SVFIR::pagReadFromTxt = "";
 
-SVFIR::SVFIR(bool buildFromFile) : IRGraph(buildFromFile), icfg(nullptr), chgraph(nullptr)
+SVFIR::SVFIR(bool buildFromFile) : IRGraph(buildFromFile), indCallSiteGen(0), icfg(nullptr), chgraph(nullptr), callGraph(nullptr)
 {
 }
 
@@ -530,56 +530,56 @@ void SVFIR::print()
 {
 
     outs() << "-------------------SVFIR------------------------------------\n";
-    SVFStmt::SVFStmtSetTy& addrs = pag->getSVFStmtSet(SVFStmt::Addr);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = addrs.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& addrs = pag->getSVFStmtSet(SVFStmt::Addr);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = addrs.begin(), eiter =
                 addrs.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- Addr --> " << (*iter)->getDstID()
                << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& copys = pag->getSVFStmtSet(SVFStmt::Copy);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = copys.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& copys = pag->getSVFStmtSet(SVFStmt::Copy);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = copys.begin(), eiter =
                 copys.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- Copy --> " << (*iter)->getDstID()
                << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& calls = pag->getSVFStmtSet(SVFStmt::Call);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = calls.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& calls = pag->getSVFStmtSet(SVFStmt::Call);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = calls.begin(), eiter =
                 calls.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- Call --> " << (*iter)->getDstID()
                << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& rets = pag->getSVFStmtSet(SVFStmt::Ret);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = rets.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& rets = pag->getSVFStmtSet(SVFStmt::Ret);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = rets.begin(), eiter =
                 rets.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- Ret --> " << (*iter)->getDstID()
                << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& tdfks = pag->getSVFStmtSet(SVFStmt::ThreadFork);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = tdfks.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& tdfks = pag->getSVFStmtSet(SVFStmt::ThreadFork);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = tdfks.begin(), eiter =
                 tdfks.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- ThreadFork --> "
                << (*iter)->getDstID() << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& tdjns = pag->getSVFStmtSet(SVFStmt::ThreadJoin);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = tdjns.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& tdjns = pag->getSVFStmtSet(SVFStmt::ThreadJoin);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = tdjns.begin(), eiter =
                 tdjns.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- ThreadJoin --> "
                << (*iter)->getDstID() << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& ngeps = pag->getSVFStmtSet(SVFStmt::Gep);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = ngeps.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& ngeps = pag->getSVFStmtSet(SVFStmt::Gep);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = ngeps.begin(), eiter =
                 ngeps.end(); iter != eiter; ++iter)
     {
         GepStmt* gep = SVFUtil::cast<GepStmt>(*iter);
@@ -591,16 +591,16 @@ void SVFIR::print()
                    << ") --> " << gep->getLHSVarID() << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& loads = pag->getSVFStmtSet(SVFStmt::Load);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = loads.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& loads = pag->getSVFStmtSet(SVFStmt::Load);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = loads.begin(), eiter =
                 loads.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- Load --> " << (*iter)->getDstID()
                << "\n";
     }
 
-    SVFStmt::SVFStmtSetTy& stores = pag->getSVFStmtSet(SVFStmt::Store);
-    for (SVFStmt::SVFStmtSetTy::iterator iter = stores.begin(), eiter =
+    SVFStmt::SVFStmtTableTy& stores = pag->getSVFStmtSet(SVFStmt::Store);
+    for (SVFStmt::SVFStmtTableTy::iterator iter = stores.begin(), eiter =
                 stores.end(); iter != eiter; ++iter)
     {
         outs() << (*iter)->getSrcID() << " -- Store --> " << (*iter)->getDstID()
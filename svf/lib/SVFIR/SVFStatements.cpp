@@ -27,6 +27,47 @@ SVFStmt::SVFStmt(SVFVar* s, SVFVar* d, GEdgeFlag k, bool real) :
     }
 }
 
+void SVFStmtTable::append(SVFStmt* stmt)
+{
+    if (sorted && !stmts.empty() && !SVFStmt::equalGEdge()(stmts.back(), stmt))
+        sorted = false;
+    stmts.push_back(stmt);
+}
+
+void SVFStmtTable::insert(SVFStmt* stmt)
+{
+    if (!sorted)
+    {
+        stmts.push_back(stmt);
+        return;
+    }
+    stmts.insert(std::upper_bound(stmts.begin(), stmts.end(), stmt, SVFStmt::equalGEdge()), stmt);
+}
+
+void SVFStmtTable::compact()
+{
+    if (!sorted)
+    {
+        std::sort(stmts.begin(), stmts.end(), SVFStmt::equalGEdge());
+        sorted = true;
+    }
+    stmts.shrink_to_fit();
+}
+
+SVFStmtTable::iterator SVFStmtTable::find(const SVFStmt* stmt) const
+{
+    SVFStmt::equalGEdge less;
+    if (!sorted)
+        return std::find_if(stmts.begin(), stmts.end(), [&](const SVFStmt* s)
+        {
+            return !less(s, stmt) && !less(stmt, s);
+        });
+    iterator it = std::lower_bound(stmts.begin(), stmts.end(), stmt, less);
+    if (it != stmts.end() && !less(stmt, *it))
+        return it;
+    return stmts.end();
+}
+
 /*!
  * Whether src and dst nodes are both pointer type
  */
@@ -0,0 +1,56 @@
+
+#include "Util/BinaryFile.h"
+
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SVF;
+
+bool BinaryWriter::writeToFile(const std::string& filename, bool append) const
+{
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
+    mode |= append ? std::ios_base::app : std::ios_base::trunc;
+    std::ofstream f(filename.c_str(), mode);
+    if (!f.good())
+        return false;
+    f.write(buffer.data(), buffer.size());
+    f.close();
+    return f.good();
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    data = static_cast<const char*>(mapped);
+    size = st.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+    data = nullptr;
+    size = 0;
+}
@@ -135,10 +135,60 @@ std::string ExtAPI::getExtBcPath()
 }
 
 
+ExtAPI::ExtFuncInfo ExtAPI::compileAnnotations(const std::vector<std::string>& funcAnnotations)
+{
+    auto has = [&funcAnnotations](const char* name) -> const std::string*
+    {
+        for (const std::string& annotation : funcAnnotations)
+            if (annotation.find(name) != std::string::npos)
+                return &annotation;
+        return nullptr;
+    };
+
+    ExtFuncInfo info;
+    if (!funcAnnotations.empty())
+        info.flags |= EXT_ANNOTATED;
+    if (funcAnnotations.size() == 1 && has("OVERWRITE"))
+        info.flags |= EXT_OVERWRITE_ONLY;
+    if (has("MEMCPY") || has("STRCPY") || has("STRCAT"))
+        info.flags |= EXT_MEMCPY;
+    if (has("MEMSET"))
+        info.flags |= EXT_MEMSET;
+    if (has("ALLOC_HEAP_RET"))
+        info.flags |= EXT_ALLOC_HEAP_RET;
+    if (has("ALLOC_STACK_RET"))
+        info.flags |= EXT_ALLOC_STACK_RET;
+    if (has("REALLOC_HEAP_RET"))
+        info.flags |= EXT_REALLOC_HEAP_RET;
+    if (const std::string* allocArg = has("ALLOC_HEAP_ARG"))
+    {
+        info.flags |= EXT_ALLOC_HEAP_ARG;
+        std::string number;
+        for (char c : *allocArg)
+        {
+            if (isdigit(c))
+                number.push_back(c);
+        }
+        if (!number.empty())
+            info.allocArgPos = std::stoi(number);
+    }
+    return info;
+}
+
 void ExtAPI::setExtFuncAnnotations(const FunObjVar* fun, const std::vector<std::string>& funcAnnotations)
 {
     assert(fun && "Null FunObjVar* pointer");
     funObjVar2Annotations[fun] = funcAnnotations;
+    funObjVar2ExtInfo[fun] = compileAnnotations(funcAnnotations);
+}
+
+const ExtAPI::ExtFuncInfo& ExtAPI::getExtFuncInfo(const FunObjVar* fun) const
+{
+    static const ExtFuncInfo noAnnotation;
+    auto it = funObjVar2ExtInfo.find(fun);
+    if (it != funObjVar2ExtInfo.end())
+        return it->second;
+    return noAnnotation;
 }
 
 bool ExtAPI::hasExtFuncAnnotation(const FunObjVar *fun, const std::string &funcAnnotation)
@@ -179,60 +229,52 @@ const std::vector<std::string>& ExtAPI::getExtFuncAnnotations(const FunObjVar* f
 
 bool ExtAPI::is_memcpy(const FunObjVar *F)
 {
-    return F &&
-           (hasExtFuncAnnotation(F, "MEMCPY") ||  hasExtFuncAnnotation(F, "STRCPY")
-            || hasExtFuncAnnotation(F, "STRCAT"));
+    return F && getExtFuncInfo(F).has(EXT_MEMCPY);
 }
 
 bool ExtAPI::is_memset(const FunObjVar *F)
 {
-    return F && hasExtFuncAnnotation(F, "MEMSET");
+    return F && getExtFuncInfo(F).has(EXT_MEMSET);
 }
 
 bool ExtAPI::is_alloc(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_RET");
+    return F && getExtFuncInfo(F).has(EXT_ALLOC_HEAP_RET);
 }
 
 // Does (F) allocate a new object and assign it to one of its arguments?
 bool ExtAPI::is_arg_alloc(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
+    return F && getExtFuncInfo(F).has(EXT_ALLOC_HEAP_ARG);
 }
 
 bool ExtAPI::is_alloc_stack_ret(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_STACK_RET");
+    return F && getExtFuncInfo(F).has(EXT_ALLOC_STACK_RET);
 }
 
 // Get the position of argument which holds the new object
 s32_t ExtAPI::get_alloc_arg_pos(const FunObjVar* F)
 {
-    std::string allocArg = getExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
-    assert(!allocArg.empty() && "Not an alloc call via argument or incorrect extern function annotation!");
-
-    std::string number;
-    for (char c : allocArg)
-    {
-        if (isdigit(c))
-            number.push_back(c);
-    }
-    assert(!number.empty() && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
-    return std::stoi(number);
+    const ExtFuncInfo& info = getExtFuncInfo(F);
+    assert(info.has(EXT_ALLOC_HEAP_ARG) && "Not an alloc call via argument or incorrect extern function annotation!");
+    assert(info.allocArgPos >= 0 && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
+    return info.allocArgPos;
 }
 
 // Does (F) reallocate a new object?
 bool ExtAPI::is_realloc(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "REALLOC_HEAP_RET");
+    return F && getExtFuncInfo(F).has(EXT_REALLOC_HEAP_RET);
 }
+
+// Should (F) be considered "external" (either not defined in the program
+//   or a user-defined version of a known alloc or no-op)?
 bool ExtAPI::is_ext(const FunObjVar *F)
 {
     assert(F && "Null FunObjVar* pointer");
     if (F->isDeclaration() || F->isIntrinsic())
         return true;
-    else if (hasExtFuncAnnotation(F, "OVERWRITE") && getExtFuncAnnotations(F).size() == 1)
-        return false;
-    else
-        return !getExtFuncAnnotations(F).empty();
+    const ExtFuncInfo& info = getExtFuncInfo(F);
+    return info.has(EXT_ANNOTATED) && !info.has(EXT_OVERWRITE_ONLY);
 }
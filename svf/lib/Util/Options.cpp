@@ -55,12 +55,24 @@ const Option<u32_t> Options::FsTimeLimit(
     0
 );
 
+const Option<u32_t> Options::FsThreads(
+    "fs-threads",
+    "number of threads to propagate address-taken objects along indirect value-flows with in flow-sensitive analysis",
+    1
+);
+
 const Option<u32_t> Options::VersioningThreads(
     "versioning-threads",
     "number of threads to use in the versioning phase of versioned flow-sensitive analysis",
     1
 );
 
+const Option<u32_t> Options::VersionPropThreads(
+    "version-prop-threads",
+    "number of threads to propagate versioned points-to sets with while solving versioned flow-sensitive analysis",
+    1
+);
+
 const Option<u32_t> Options::AnderTimeLimit(
     "ander-time-limit",
     "time limit for Andersen's analyses (ignored when -fs-time-limit set)",
@@ -188,6 +200,12 @@ const Option<std::string> Options::SelfCycle(
     ""
 );
 
+const Option<u32_t> Options::SVFGOptThreads(
+    "svfgopt-threads",
+    "number of threads to retarget actual-in/formal-out edges with when optimising the SVFG (1: sequential)",
+    1
+);
+
 
 // Sparse value-flow graph (VFG.cpp)
 const Option<bool> Options::DumpVFG(
@@ -258,15 +276,15 @@ const Option<bool> Options::DumpICFG(
     false
 );
 
-const Option<std::string> Options::DumpJson(
-    "dump-json",
-    "Dump the SVFIR in JSON format",
+const Option<std::string> Options::WriteSVFIR(
+    "write-svfir",
+    "Write the SVFIR, ICFG, call graph and class hierarchy to a binary file",
     ""
 );
 
-const Option<bool> Options::ReadJson(
-    "read-json",
-    "Read the SVFIR in JSON format",
+const Option<bool> Options::ReadSVFIR(
+    "read-svfir",
+    "Read the SVFIR from the binary file given as input instead of building it from LLVM IR",
     false
 );
 
@@ -418,6 +436,12 @@ const OptionMap<MemSSA::MemPartition> Options::MemPar(
 }
 );
 
+const Option<u32_t> Options::MSSAThreads(
+    "mssa-threads",
+    "number of threads to generate memory regions and build memory SSA with (1: sequential)",
+    1
+);
+
 
 // SVFG builder (SVFGBuilder.cpp)
 const Option<bool> Options::SVFGWithIndirectCall(
@@ -444,6 +468,12 @@ const Option<std::string> Options::ReadSVFG(
     ""
 );
 
+const Option<bool> Options::WriteSVFGText(
+    "write-svfg-text",
+    "Write the SVFG of -write-svfg in the text format instead of the binary one",
+    false
+);
+
 
 const Option<bool> Options::IntraLock(
     "intra-lock-td-edge",
@@ -519,6 +549,12 @@ const Option<bool> Options::DumpCHA(
     false
 );
 
+const Option<u32_t> Options::CHGThreads(
+    "chg-threads",
+    "number of threads to compute the virtual functions of vtables with",
+    1
+);
+
 
 // DCHG.cpp
 const Option<bool> Options::PrintDCHG(
@@ -535,6 +571,31 @@ const Option<std::string> Options::Graphtxt(
     ""
 );
 
+const Option<u32_t> Options::ModuleLoadThreads(
+    "module-load-threads",
+    "number of threads to read LLVM IR files with",
+    1
+);
+
+const Option<u32_t> Options::DomInfoThreads(
+    "dom-info-threads",
+    "number of threads to compute dominator, post-dominator and loop info with",
+    1
+);
+
+const Option<std::string> Options::SVFIRCacheDir(
+    "svfir-cache-dir",
+    "directory to cache the SVFIR in, keyed by a hash of the input LLVM IR (no caching if empty; "
+    "not used by tools which map the SVFIR back to the LLVM IR, e.g. ae)",
+    ""
+);
+
+const Option<bool> Options::ReleaseLLVMIR(
+    "release-llvm-ir",
+    "Release the LLVM IR and its mapping to the SVFIR as soon as the SVFIR is built",
+    false
+);
+
 const Option<bool> Options::SVFMain(
     "svf-main",
     "add svf.main()",
@@ -565,6 +626,18 @@ const Option<bool> Options::SymTabPrint(
     false
 );
 
+const Option<u32_t> Options::TypeInferenceThreads(
+    "type-inference-threads",
+    "number of threads to infer the types of heap objects with",
+    1
+);
+
+const Option<u32_t> Options::SymbolTableThreads(
+    "symtab-threads",
+    "number of threads to find the symbols of functions and infer the types of their heap objects with",
+    1
+);
+
 // Conditions.cpp
 const Option<u32_t> Options::MaxZ3Size(
     "max-z3-size",
@@ -624,6 +697,30 @@ const Option<bool> Options::BriefConsCGDotGraph(
     true
 );
 
+const Option<bool> Options::ConsGArena(
+    "consg-arena",
+    "Allocate constraint graph nodes and edges from slab arenas",
+    false
+);
+
+const Option<bool> Options::CompactFSConsG(
+    "compact-fs-consg",
+    "Renumber live flow-sensitive constraint graph nodes densely between solving rounds",
+    false
+);
+
+const Option<u32_t> Options::PtsMemBudget(
+    "pts-mem-budget",
+    "Memory budget (MB) of flow-sensitive SCD solving: points-to sets not accessed recently are compressed when the resident set size nears it (0: no budget)",
+    0
+);
+
+const Option<u32_t> Options::AnderThreads(
+    "ander-threads",
+    "number of threads for wave propagation and load/store processing in AndersenWaveDiff (1: sequential)",
+    1
+);
+
 const Option<bool> Options::PrintCGGraph(
     "print-constraint-graph",
     "Print Constraint Graph to Terminal",
@@ -632,16 +729,22 @@ const Option<bool> Options::PrintCGGraph(
 
 const Option<std::string> Options::WriteAnder(
     "write-ander",
-    "-write-ander=ir_annotator (Annotated IR with Andersen's results) or write Andersen's analysis results to a user-specified text file",
+    "-write-ander=ir_annotator (Annotated IR with Andersen's results) or write Andersen's analysis results to a user-specified file (binary unless -write-ander-text)",
     ""
 );
 
 const Option<std::string> Options::ReadAnder(
     "read-ander",
-    "-read-ander=ir_annotator (Read Andersen's analysis results from the annotated IR, e.g., *.pre.bc) or from a text file",
+    "-read-ander=ir_annotator (Read Andersen's analysis results from the annotated IR, e.g., *.pre.bc) or from a binary or text file",
     ""
 );
 
+const Option<bool> Options::WriteAnderText(
+    "write-ander-text",
+    "Write analysis results of -write-ander in the text format instead of the binary one",
+    false
+);
+
 const Option<bool> Options::DiffPts(
     "diff",
     "Enable differential point-to set",
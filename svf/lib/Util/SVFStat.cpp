@@ -7,8 +7,12 @@ using namespace SVF;
 using namespace std;
 
 double SVFStat::timeOfBuildingLLVMModule = 0;
+double SVFStat::timeOfLoadingModules = 0;
+double SVFStat::timeOfBuildingDomInfo = 0;
 double SVFStat::timeOfBuildingSVFIR = 0;
 double SVFStat::timeOfBuildingSymbolTable = 0;
+u32_t SVFStat::numOfSVFIRCacheHits = 0;
+u32_t SVFStat::numOfSVFIRCacheMisses = 0;
 bool SVFStat::printGeneralStats = true;
 
 SVFStat::SVFStat() : startTime(0), endTime(0)
@@ -178,9 +182,17 @@ void SVFStat::performStat()
     generalNumMap["IndCallSites"] = pag->getIndirectCallsites().size();
     generalNumMap["TotalCallSite"] = pag->getCallSiteSet().size();
 
+    if (!Options::SVFIRCacheDir().empty())
+    {
+        generalNumMap["SVFIRCacheHits"] = SVFStat::numOfSVFIRCacheHits;
+        generalNumMap["SVFIRCacheMisses"] = SVFStat::numOfSVFIRCacheMisses;
+    }
+
     timeStatMap["LLVMIRTime"] = SVFStat::timeOfBuildingLLVMModule;
+    timeStatMap["ModuleLoadTime"] = SVFStat::timeOfLoadingModules;
     timeStatMap["SymbolTableTime"] = SVFStat::timeOfBuildingSymbolTable;
     timeStatMap["SVFIRTime"] = SVFStat::timeOfBuildingSVFIR;
+    timeStatMap["DomInfoTime"] = SVFStat::timeOfBuildingDomInfo;
 
     // REFACTOR-TODO bitcastInstStat();
     branchStat();
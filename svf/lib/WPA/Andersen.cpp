@@ -32,6 +32,7 @@ u32_t AndersenBase::MaxPointsToSetSize = 0;
 double AndersenBase::timeOfProcessCopyGep = 0;
 double AndersenBase::timeOfProcessLoadStore = 0;
 double AndersenBase::timeOfUpdateCallGraph = 0;
+u32_t AndersenBase::numOfWaveLevels = 0;
 
 /*!
  * Destructor
@@ -371,6 +371,8 @@ void AndersenStat::performStat()
 
     PTNumStatMap["NumOfSFRs"] = Andersen::numOfSfrs;
     PTNumStatMap["NumOfFieldExpand"] = Andersen::numOfFieldExpand;
+    PTNumStatMap["AnderThreads"] = Options::AnderThreads();
+    PTNumStatMap["WaveLevels"] = Andersen::numOfWaveLevels;
 
     PTNumStatMap["Pointers"] = pag->getValueNodeNum();
     PTNumStatMap["MemObjects"] = pag->getObjectNodeNum();
@@ -384,6 +386,41 @@ void AndersenStat::performStat()
 
     PTNumStatMap["SolveIterations"] = pta->numOfIteration;
 
+    if (Options::CompactFSConsG())
+    {
+        PTNumStatMap["NumOfCompaction"] = FlowSensitiveSCD::numOfCompaction;
+        PTNumStatMap["CompactedNodeIDs"] = FlowSensitiveSCD::numOfCompactedIDs;
+        timeStatMap["CompactionTime"] = FlowSensitiveSCD::timeOfCompaction;
+    }
+
+    if (Options::PtsMemBudget() > 0)
+    {
+        PTNumStatMap["MemBudgetChecks"] = FlowSensitiveSCD::numOfMemChecks;
+        PTNumStatMap["PtsSpillRounds"] = FlowSensitiveSCD::numOfSpills;
+        timeStatMap["PtsSpillTime"] = FlowSensitiveSCD::timeOfSpill;
+        const BVDataPTAImpl::MutDiffPTDataTy::SpillStats& spill = FlowSensitiveSCD::spillStats;
+        PTNumStatMap["SpilledPtsSets"] = spill.numSpilled;
+        PTNumStatMap["SpilledPtsKB"] = spill.numSpilledBytes / 1024;
+        PTNumStatMap["SpilledPtsElements"] = spill.numSpilledElements;
+        PTNumStatMap["PeakSpilledPtsKB"] = spill.peakSpilledBytes / 1024;
+        PTNumStatMap["RestoredPtsSets"] = spill.numRestores;
+        timeStatMap["PtsSpillHitRate"] = spill.numAccesses == 0 ? 1.0 :
+                                         1.0 - (double)spill.numRestores / spill.numAccesses;
+        timeStatMap["PtsRestoreTime"] = spill.restoreTime;
+    }
+
+    if (Options::ConsGArena())
+    {
+        const TypedArena<ConstraintNode>& nodeArena = ConstraintGraph::getNodeArena();
+        const TypedArena<ConstraintEdge>& edgeArena = ConstraintGraph::getEdgeArena();
+        PTNumStatMap["ArenaSlabs"] = nodeArena.getNumSlabs() + edgeArena.getNumSlabs();
+        PTNumStatMap["ArenaPeakNodeKB"] = nodeArena.getPeakLiveBytes() / 1024;
+        PTNumStatMap["ArenaPeakEdgeKB"] = edgeArena.getPeakLiveBytes() / 1024;
+        PTNumStatMap["ArenaReusedSlots"] = nodeArena.getNumReused() + edgeArena.getNumReused();
+        timeStatMap["ArenaNodeFrag"] = nodeArena.getFragmentation();
+        timeStatMap["ArenaEdgeFrag"] = edgeArena.getFragmentation();
+    }
+
     PTNumStatMap["IndCallSites"] = consCG->getIndirectCallsites().size();
     PTNumStatMap["IndEdgeSolved"] = pta->getNumOfResolvedIndCallEdge();
 
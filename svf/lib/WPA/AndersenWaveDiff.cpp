@@ -2,6 +2,8 @@
 
 #include "WPA/Andersen.h"
 #include "MemoryModel/PointsTo.h"
+#include "Util/Options.h"
+#include "Util/WorkStealing.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -27,6 +29,13 @@ void AndersenWaveDiff::solveWorklist()
     // Nodes in nodeStack are in topological order by default.
     NodeStack& nodeStack = SCCDetect();
 
+    if (Options::AnderThreads() > 1)
+    {
+        propagateByLevel(nodeStack);
+        postProcessNodes();
+        return;
+    }
+
     // Process nodeStack and put the changed nodes into workList.
     while (!nodeStack.empty())
     {
@@ -125,3 +134,200 @@ bool AndersenWaveDiff::handleStore(NodeID nodeId, const ConstraintEdge* edge)
     }
     return changed;
 }
+
+/*!
+ * Wave propagation over topological levels.
+ * The level of a node is one more than the highest level of the nodes with a
+ * copy/gep edge to it, so each level only receives points-to from earlier ones.
+ * For the copy edges of a level, what each destination receives is gathered in
+ * parallel, then unioned in one go. Gep edges may create field objects and stay
+ * sequential.
+ */
+void AndersenWaveDiff::propagateByLevel(NodeStack& nodeStack)
+{
+    std::vector<std::vector<NodeID>> levels;
+    Map<NodeID, u32_t> nodeToLevel;
+    while (!nodeStack.empty())
+    {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+
+        u32_t level = nodeToLevel[nodeId];
+        if (level >= levels.size())
+            levels.resize(level + 1);
+        levels[level].push_back(nodeId);
+
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getDirectOutEdges())
+        {
+            NodeID dst = sccRepNode(edge->getDstID());
+            if (dst == nodeId)
+                continue;
+            u32_t& dstLevel = nodeToLevel[dst];
+            if (dstLevel < level + 1)
+                dstLevel = level + 1;
+        }
+    }
+
+    numOfWaveLevels += levels.size();
+
+    for (const std::vector<NodeID>& level : levels)
+    {
+        for (NodeID nodeId : level)
+            collapsePWCNode(nodeId);
+        collapseFields();
+
+        double propStart = stat->getClk();
+
+        // Diff points-to of the level and the sources of each destination.
+        std::vector<NodeID> changedNodes;
+        std::vector<NodeID> dsts;
+        Map<NodeID, u32_t> dstToIndex;
+        std::vector<std::vector<const PointsTo*>> dstSrcPts;
+        for (NodeID nodeId : level)
+        {
+            if (sccRepNode(nodeId) != nodeId)
+                continue;
+
+            computeDiffPts(nodeId);
+            const PointsTo& diffPts = getDiffPts(nodeId);
+            if (diffPts.empty())
+                continue;
+
+            changedNodes.push_back(nodeId);
+            for (ConstraintEdge* edge : consCG->getConstraintNode(nodeId)->getCopyOutEdges())
+            {
+                numOfProcessedCopy++;
+                NodeID dst = edge->getDstID();
+                Map<NodeID, u32_t>::const_iterator it = dstToIndex.find(dst);
+                u32_t index;
+                if (it == dstToIndex.end())
+                {
+                    index = dsts.size();
+                    dstToIndex[dst] = index;
+                    dsts.push_back(dst);
+                    dstSrcPts.emplace_back();
+                }
+                else
+                    index = it->second;
+                dstSrcPts[index].push_back(&diffPts);
+            }
+        }
+
+        // No points-to set is written while the unions are gathered.
+        std::vector<PointsTo> dstPts(dsts.size());
+        WorkStealingPool<u32_t> pool(Options::AnderThreads());
+        for (u32_t i = 0; i < dsts.size(); ++i)
+            pool.push(i);
+        pool.run([&dstPts, &dstSrcPts](u32_t i, unsigned)
+        {
+            for (const PointsTo* srcPts : dstSrcPts[i])
+                dstPts[i] |= *srcPts;
+        });
+
+        for (u32_t i = 0; i < dsts.size(); ++i)
+        {
+            if (unionPts(dsts[i], dstPts[i]))
+                pushIntoWorklist(dsts[i]);
+        }
+
+        for (NodeID nodeId : changedNodes)
+        {
+            for (ConstraintEdge* edge : consCG->getConstraintNode(nodeId)->getGepOutEdges())
+            {
+                if (GepCGEdge* gepEdge = SVFUtil::dyn_cast<GepCGEdge>(edge))
+                    processGep(nodeId, gepEdge);
+            }
+        }
+
+        double propEnd = stat->getClk();
+        timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
+
+        collapseFields();
+    }
+}
+
+/*!
+ * Load/store processing of the whole worklist.
+ * Which copy edges loads and stores induce only depends on points-to sets and
+ * existing edges, so they are found in parallel; they are then added in the
+ * order the sequential postProcessNode would add them.
+ */
+void AndersenWaveDiff::postProcessNodes()
+{
+    double insertStart = stat->getClk();
+
+    std::vector<NodeID> nodes;
+    std::vector<const PointsTo*> nodePts;
+    while (!isWorklistEmpty())
+    {
+        NodeID nodeId = popFromWorklist();
+        nodes.push_back(nodeId);
+        nodePts.push_back(&getPts(nodeId));
+    }
+
+    struct NewCopyEdges
+    {
+        std::vector<std::pair<NodeID, NodeID>> edges;
+        u32_t numOfLoads = 0;
+        u32_t numOfStores = 0;
+    };
+    std::vector<NewCopyEdges> newEdges(nodes.size());
+
+    auto findNewEdges = [this, &nodes, &nodePts, &newEdges](u32_t i, unsigned)
+    {
+        ConstraintNode* node = consCG->getConstraintNode(nodes[i]);
+        NewCopyEdges& found = newEdges[i];
+
+        // Same conditions as processLoad/processStore, minus the edges already there.
+        for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(), eit = node->outgoingLoadsEnd();
+                it != eit; ++it)
+        {
+            NodeID dst = (*it)->getDstID();
+            if (pag->getGNode(dst)->isPointer() == false)
+                continue;
+            for (NodeID ptd : *nodePts[i])
+            {
+                if (pag->isConstantObj(ptd))
+                    continue;
+                found.numOfLoads++;
+                if (ptd != dst && !consCG->hasEdge(consCG->getConstraintNode(ptd), consCG->getConstraintNode(dst), ConstraintEdge::Copy))
+                    found.edges.push_back(std::make_pair(ptd, dst));
+            }
+        }
+        for (ConstraintNode::const_iterator it = node->incomingStoresBegin(), eit = node->incomingStoresEnd();
+                it != eit; ++it)
+        {
+            NodeID src = (*it)->getSrcID();
+            if (pag->getGNode(src)->isPointer() == false)
+                continue;
+            for (NodeID ptd : *nodePts[i])
+            {
+                if (pag->isConstantObj(ptd))
+                    continue;
+                found.numOfStores++;
+                if (src != ptd && !consCG->hasEdge(consCG->getConstraintNode(src), consCG->getConstraintNode(ptd), ConstraintEdge::Copy))
+                    found.edges.push_back(std::make_pair(src, ptd));
+            }
+        }
+    };
+
+    WorkStealingPool<u32_t> pool(Options::AnderThreads());
+    for (u32_t i = 0; i < nodes.size(); ++i)
+        pool.push(i);
+    pool.run(findNewEdges);
+
+    for (const NewCopyEdges& found : newEdges)
+    {
+        numOfProcessedLoad += found.numOfLoads;
+        numOfProcessedStore += found.numOfStores;
+        for (const std::pair<NodeID, NodeID>& edge : found.edges)
+        {
+            if (addCopyEdge(edge.first, edge.second))
+                reanalyze = true;
+        }
+    }
+
+    double insertEnd = stat->getClk();
+    timeOfProcessLoadStore += (insertEnd - insertStart) / TIMEINTERVAL;
+}
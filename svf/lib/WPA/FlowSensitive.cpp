@@ -6,6 +6,7 @@
 #include "WPA/Andersen.h"
 #include "MemoryModel/PointsTo.h"
 #include "Graphs/FSConsG.h"
+#include "Util/WorkStealing.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -192,6 +193,148 @@ NodeStack& FlowSensitive::SCCDetect()
     return nodeStack;
 }
 
+/*!
+ * Solve the worklist.
+ * With multiple threads, objects to propagate along indirect edges are
+ * collected while the worklist drains and then propagated all at once, before
+ * the statements they reach are solved in the next round.
+ */
+void FlowSensitive::solveWorklist()
+{
+    if (!isParallelSolve())
+    {
+        WPASVFGFSSolver::solveWorklist();
+        return;
+    }
+
+    prepareParallelSolve();
+    deferIndirectProp = true;
+    do
+    {
+        WPASVFGFSSolver::solveWorklist();
+    }
+    while (propagateObjectsInParallel());
+    deferIndirectProp = false;
+}
+
+bool FlowSensitive::isParallelSolve() const
+{
+    if (Options::FsThreads() <= 1 || getAnalysisTy() != FSSPARSE_WPA)
+        return false;
+    if (Options::ptDataBacking() != PTBackingType::Mutable)
+    {
+        static bool warned = false;
+        if (!warned)
+            writeWrnMsg("FlowSensitive: fs-threads needs the mutable points-to backing, solving sequentially");
+        warned = true;
+        return false;
+    }
+    return true;
+}
+
+void FlowSensitive::prepareParallelSolve()
+{
+    std::vector<NodeID> inLocs;
+    std::vector<NodeID> outLocs;
+    for (SVFG::iterator it = svfg->begin(), eit = svfg->end(); it != eit; ++it)
+    {
+        const SVFGNode* node = it->second;
+        if (SVFUtil::isa<StoreSVFGNode>(node))
+            outLocs.push_back(node->getId());
+        if (SVFUtil::isa<LoadSVFGNode, StoreSVFGNode, MRSVFGNode>(node))
+            inLocs.push_back(node->getId());
+    }
+    getMutDFPTDataTy()->prepareLocs(inLocs, outLocs);
+}
+
+bool FlowSensitive::propagateObjectsInParallel()
+{
+    if (objToPendingEdges.empty())
+        return false;
+
+    double start = stat->getClk(true);
+
+    // Workers only read parallelLabelVars, so expand the labels created since
+    // the last round (by new call graph edges) beforehand. Earlier expansions
+    // stay valid unless processGep made an object field-insensitive.
+    const PointsToID numLabels = IndirectSVFGEdge::getLabelCache().getNumStoredPts();
+    parallelLabelVars.reserve(numLabels);
+    for (PointsToID label = parallelLabelVars.size(); label < numLabels; ++label)
+    {
+        parallelLabelVars.emplace_back();
+        expandLabel(label, parallelLabelVars.back());
+    }
+
+    std::vector<NodeID> objects;
+    objects.reserve(objToPendingEdges.size());
+    for (const auto& pending : objToPendingEdges)
+        objects.push_back(pending.first);
+    std::sort(objects.begin(), objects.end());
+
+    const unsigned numThreads = Options::FsThreads();
+    std::vector<NodeBS> changedStmts(numThreads);
+
+    WorkStealingPool<NodeID> objectPool(numThreads);
+    for (NodeID o : objects)
+        objectPool.push(o);
+
+    // The data-flow sets of one object never depend on those of another, so
+    // each object is propagated through memory SSA nodes to a fixed point
+    // independently. Edges are propagated regardless of the updated flags,
+    // which have been cleared since the edges were deferred.
+    MutDFPTDataTy* dfPTData = getMutDFPTDataTy();
+    auto objectWorker = [this, dfPTData, &changedStmts](const NodeID o, const unsigned thread)
+    {
+        std::vector<const IndirectSVFGEdge*> edges = objToPendingEdges.at(o);
+        while (!edges.empty())
+        {
+            const IndirectSVFGEdge* edge = edges.back();
+            edges.pop_back();
+
+            const SVFGNode* src = edge->getSrcNode();
+            const SVFGNode* dst = edge->getDstNode();
+            bool changed = SVFUtil::isa<StoreSVFGNode>(src)
+                           ? dfPTData->updateAllDFInFromOut(src->getId(), o, dst->getId(), o)
+                           : dfPTData->updateAllDFInFromIn(src->getId(), o, dst->getId(), o);
+            if (!changed)
+                continue;
+
+            if (!SVFUtil::isa<MRSVFGNode>(dst))
+            {
+                changedStmts[thread].set(dst->getId());
+                continue;
+            }
+
+            for (const SVFGEdge* outEdge : dst->getOutEdges())
+            {
+                const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(outEdge);
+                if (indEdge && parallelLabelVars[indEdge->getPointsToId()].test(o))
+                    edges.push_back(indEdge);
+            }
+        }
+    };
+
+    dfPTData->setConcurrent(true);
+    objectPool.run(objectWorker);
+    dfPTData->setConcurrent(false);
+
+    objToPendingEdges.clear();
+
+    NodeBS changed;
+    for (const NodeBS& stmts : changedStmts)
+        changed |= stmts;
+    for (NodeID stmt : changed)
+        pushIntoWorklist(stmt);
+
+    ++numOfParallelRounds;
+    numOfParallelSteals += objectPool.getNumSteals();
+
+    double end = stat->getClk(true);
+    parallelPropaTime += (end - start) / TIMEINTERVAL;
+
+    return !isWorklistEmpty();
+}
+
 /*!
  * Process each SVFG node
  */
@@ -199,7 +342,10 @@ void FlowSensitive::processNode(NodeID nodeId)
 {
     SVFGNode* node = svfg->getSVFGNode(nodeId);
     if (processSVFGNode(node))
+    {
+        labelToVars.clear();
         propagate(&node);
+    }
 
     clearAllDFOutVarFlag(node);
 }
@@ -367,6 +513,13 @@ bool FlowSensitive::propagateFromFRToAR(const FormalRetSVFGNode* fr, const SVFGN
  */
 bool FlowSensitive::propAlongIndirectEdge(const IndirectSVFGEdge* edge)
 {
+    if (deferIndirectProp)
+    {
+        for (NodeID var : getIndirectEdgeVars(edge))
+            objToPendingEdges[var].push_back(edge);
+        return false;
+    }
+
     double start = stat->getClk();
 
     SVFGNode* src = edge->getSrcNode();
@@ -376,25 +529,10 @@ bool FlowSensitive::propAlongIndirectEdge(const IndirectSVFGEdge* edge)
 
     // Get points-to targets may be used by next SVFG node.
     // Propagate points-to set for node used in dst.
-    const NodeBS& pts = edge->getPointsTo();
-    for (NodeBS::iterator ptdIt = pts.begin(), ptdEit = pts.end(); ptdIt != ptdEit; ++ptdIt)
+    for (NodeID var : getIndirectEdgeVars(edge))
     {
-        NodeID ptd = *ptdIt;
-
-        if (propVarPtsFromSrcToDst(ptd, src, dst))
+        if (propVarPtsFromSrcToDst(var, src, dst))
             changed = true;
-
-        if (isFieldInsensitive(ptd))
-        {
-            /// If this is a field-insensitive obj, propagate all field node's pts
-            const NodeBS& allFields = getAllFieldsObjVars(ptd);
-            for (NodeBS::iterator fieldIt = allFields.begin(), fieldEit = allFields.end();
-                    fieldIt != fieldEit; ++fieldIt)
-            {
-                if (propVarPtsFromSrcToDst(*fieldIt, src, dst))
-                    changed = true;
-            }
-        }
     }
 
     double end = stat->getClk();
@@ -402,6 +540,36 @@ bool FlowSensitive::propAlongIndirectEdge(const IndirectSVFGEdge* edge)
     return changed;
 }
 
+/*!
+ * Objects whose points-to information flows along an indirect edge.
+ */
+const NodeBS& FlowSensitive::getIndirectEdgeVars(const IndirectSVFGEdge* edge)
+{
+    return getLabelVars(edge->getPointsToId());
+}
+
+const NodeBS& FlowSensitive::getLabelVars(PointsToID label)
+{
+    std::pair<Map<PointsToID, NodeBS>::iterator, bool> inserted =
+        labelToVars.emplace(label, NodeBS());
+    NodeBS& vars = inserted.first->second;
+    if (inserted.second)
+        expandLabel(label, vars);
+    return vars;
+}
+
+void FlowSensitive::expandLabel(PointsToID label, NodeBS& vars)
+{
+    const NodeBS& pts = IndirectSVFGEdge::getLabelCache().getActualPts(label);
+    vars = pts;
+    for (NodeID ptd : pts)
+    {
+        /// If this is a field-insensitive obj, propagate all field node's pts
+        if (isFieldInsensitive(ptd))
+            vars |= getAllFieldsObjVars(ptd);
+    }
+}
+
 /*!
  * Propagate points-to information of a certain variable from src to dst.
  */
@@ -492,7 +660,12 @@ bool FlowSensitive::processGep(const GepSVFGNode* edge)
                 continue;
             }
 
-            setObjFieldInsensitive(o);
+            if (!isFieldInsensitive(o))
+            {
+                setObjFieldInsensitive(o);
+                // labels holding o now stand for all its fields as well
+                parallelLabelVars.clear();
+            }
             tmpDstPts.set(getFIObjVar(o));
         }
     }
@@ -668,7 +841,7 @@ bool FlowSensitive::updateCallGraph(const CallSiteToFunPtrMap& callsites)
 {
     double start = stat->getClk();
     CallEdgeMap newEdges;
-    onTheFlyCallGraphSolve(callsites, newEdges);
+    onTheFlyChangedCallGraphSolve(callsites, newEdges);
 
     // Bound the new edges by the Andersen's call graph.
     // TODO: we want this to be an assertion eventually.
@@ -739,6 +912,7 @@ void FlowSensitive::connectCallerAndCallee(const CallEdgeMap& newEdges, SVFGEdge
  */
 void FlowSensitive::updateConnectedNodes(const SVFGEdgeSetTy& edges)
 {
+    labelToVars.clear();
     for (const SVFGEdge* edge : edges)
     {
         SVFGNode* dstNode = edge->getDstNode();
@@ -756,25 +930,10 @@ void FlowSensitive::updateConnectedNodes(const SVFGEdgeSetTy& edges)
 
             SVFGNode* srcNode = edge->getSrcNode();
 
-            const NodeBS& pts = SVFUtil::cast<IndirectSVFGEdge>(edge)->getPointsTo();
-            for (NodeBS::iterator ptdIt = pts.begin(), ptdEit = pts.end(); ptdIt != ptdEit; ++ptdIt)
+            for (NodeID var : getIndirectEdgeVars(SVFUtil::cast<IndirectSVFGEdge>(edge)))
             {
-                NodeID ptd = *ptdIt;
-
-                if (propVarPtsAfterCGUpdated(ptd, srcNode, dstNode))
+                if (propVarPtsAfterCGUpdated(var, srcNode, dstNode))
                     changed = true;
-
-                if (isFieldInsensitive(ptd))
-                {
-                    /// If this is a field-insensitive obj, propagate all field node's pts
-                    const NodeBS& allFields = getAllFieldsObjVars(ptd);
-                    for (NodeBS::iterator fieldIt = allFields.begin(), fieldEit = allFields.end();
-                            fieldIt != fieldEit; ++fieldIt)
-                    {
-                        if (propVarPtsAfterCGUpdated(*fieldIt, srcNode, dstNode))
-                            changed = true;
-                    }
-                }
             }
 
             if (changed)
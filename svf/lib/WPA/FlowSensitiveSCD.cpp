@@ -10,12 +10,22 @@ using namespace SVF;
 using namespace SVFUtil;
 using namespace std;
 
+u32_t FlowSensitiveSCD::numOfCompaction = 0;
+u32_t FlowSensitiveSCD::numOfCompactedIDs = 0;
+double FlowSensitiveSCD::timeOfCompaction = 0;
+u32_t FlowSensitiveSCD::numOfMemChecks = 0;
+u32_t FlowSensitiveSCD::numOfSpills = 0;
+double FlowSensitiveSCD::timeOfSpill = 0;
+FlowSensitiveSCD::MutDiffPTDataTy::SpillStats FlowSensitiveSCD::spillStats;
+
 void FlowSensitiveSCD::initialize()
 {
     resetData();
     /// Build SVFIR
     PointerAnalysis::initialize();
 
+    // TODO: support clustered aux. Andersen's.
+    assert(!Options::ClusterAnder() && "FlowSensitiveSCD::initialize: clustering auxiliary Andersen's unsupported.");
     ander = AndersenWaveDiff::createAndersenWaveDiff(getPAG());
     svfg = memSSA.buildPTROnlySVFG(ander);
 
@@ -28,9 +38,34 @@ void FlowSensitiveSCD::initialize()
     if (Options::SVFG2CG())
         fsconsCG->dump("fsconsg_initial");
 
+    // If cluster option is not set, it will give us a no-mapping points-to set.
+    assert(!(Options::ClusterFs() && Options::PlainMappingFs())
+           && "FlowSensitiveSCD::initialize: plain-mapping and cluster-fs are mutually exclusive.");
+    if (Options::ClusterFs())
+    {
+        cluster();
+        // Reset the points-to cache although empty so the new mapping could
+        // be applied to the inserted empty set.
+        getPtCache().reset();
+    }
+    else if (Options::PlainMappingFs())
+    {
+        plainMap();
+        // As above.
+        getPtCache().reset();
+    }
+
     /// Create Andersen statistic class
     stat = new AndersenStat(this);
 
+    if (Options::PtsMemBudget() > 0)
+    {
+        if (MutDiffPTDataTy* mdf = SVFUtil::dyn_cast<MutDiffPTDataTy>(getPTDataTy()))
+            mdf->enableSpill();
+        else
+            writeWrnMsg("FlowSensitiveSCD: pts-mem-budget needs the mutable points-to backing, ignored");
+    }
+
     /// Initialize worklist
     processAllAddr();
 
@@ -48,11 +83,57 @@ void FlowSensitiveSCD::processAllAddr()
     }
 }
 
+void FlowSensitiveSCD::cluster(void) const
+{
+    std::vector<std::pair<unsigned, unsigned>> keys;
+    for (const auto& pair : *pag)
+        keys.emplace_back(pair.first, 1);
+
+    std::vector<std::pair<hclust_fast_methods, std::vector<NodeID>>> candidates;
+    PointsTo::MappingPtr nodeMapping =
+        std::make_shared<std::vector<NodeID>>(NodeIDAllocator::Clusterer::cluster(ander, keys, candidates, "aux-ander"));
+    PointsTo::MappingPtr reverseNodeMapping =
+        std::make_shared<std::vector<NodeID>>(NodeIDAllocator::Clusterer::getReverseNodeMapping(*nodeMapping));
+
+    PointsTo::setCurrentBestNodeMapping(nodeMapping, reverseNodeMapping);
+}
+
+void FlowSensitiveSCD::plainMap(void) const
+{
+    assert(Options::NodeAllocStrat() == NodeIDAllocator::Strategy::DENSE
+           && "FlowSensitiveSCD::plainMap: plain mapping requires dense allocation strategy.");
+
+    const size_t numObjects = NodeIDAllocator::get()->getNumObjects();
+    PointsTo::MappingPtr plainMapping = std::make_shared<std::vector<NodeID>>(numObjects);
+    PointsTo::MappingPtr reversePlainMapping = std::make_shared<std::vector<NodeID>>(numObjects);
+    for (NodeID i = 0; i < plainMapping->size(); ++i)
+    {
+        plainMapping->at(i) = i;
+        reversePlainMapping->at(i) = i;
+    }
+
+    PointsTo::setCurrentBestNodeMapping(plainMapping, reversePlainMapping);
+}
+
 void FlowSensitiveSCD::finalize()
 {
     if (Options::SVFG2CG())
         fsconsCG->dump("fsconsg_final");
 
+    if (MutDiffPTDataTy* mdf = SVFUtil::dyn_cast<MutDiffPTDataTy>(getPTDataTy()))
+    {
+        mdf->restoreAllPts();
+        spillStats = mdf->getSpillStats();
+    }
+
+    if (Options::ClusterFs())
+    {
+        Map<std::string, std::string> stats;
+        const PTDataTy *ptd = getPTDataTy();
+        NodeIDAllocator::Clusterer::evaluate(*PointsTo::getCurrentBestNodeMapping(), ptd->getAllPts(true), stats, true);
+        NodeIDAllocator::Clusterer::printStats("post-main", stats);
+    }
+
     BVDataPTAImpl::finalize();
 }
 
@@ -77,6 +158,9 @@ void FlowSensitiveSCD::solveConstraints()
         if (updateCallGraph(getIndirectCallsites()))
             reanalyze = true;
 
+        if (reanalyze && Options::CompactFSConsG())
+            compactNodeIDs();
+
     }
     while (reanalyze);
 
@@ -133,7 +217,39 @@ void FlowSensitiveSCD::solveWorklist()
         handleLoadStore(node);
         double insertEnd = stat->getClk();
         timeOfProcessLoadStore += (insertEnd - insertStart) / TIMEINTERVAL;
+
+        if (++numOfNodesSinceMemCheck >= MemCheckInterval)
+            checkMemBudget();
+    }
+}
+
+/*!
+ * Keep the resident set size under pts-mem-budget by compressing the points-to
+ * sets which have not been accessed since the last check. They are
+ * decompressed again when next accessed.
+ */
+void FlowSensitiveSCD::checkMemBudget()
+{
+    numOfNodesSinceMemCheck = 0;
+    MutDiffPTDataTy* mdf = SVFUtil::dyn_cast<MutDiffPTDataTy>(getPTDataTy());
+    if (mdf == nullptr || !mdf->isSpillEnabled())
+        return;
+
+    numOfMemChecks++;
+    u32_t vmrss = 0, vmsize = 0;
+    // Spill once 90% of the budget is used.
+    const u64_t thresholdKB = (u64_t)Options::PtsMemBudget() * 1024 * 9 / 10;
+    if (!SVFUtil::getMemoryUsageKB(&vmrss, &vmsize) || vmrss < thresholdKB)
+    {
+        mdf->resetAccessedPts();
+        return;
     }
+
+    double spillStart = stat->getClk(true);
+    if (mdf->spillColdPts() > 0)
+        numOfSpills++;
+    double spillEnd = stat->getClk(true);
+    timeOfSpill += (spillEnd - spillStart) / TIMEINTERVAL;
 }
 
 /// AndersenSCD::SCCDetect()
@@ -329,7 +445,7 @@ bool FlowSensitiveSCD::updateCallGraph(const PointerAnalysis::CallSiteToFunPtrMa
     double cgUpdateStart = stat->getClk();
 
     CallEdgeMap newEdges;
-    onTheFlyCallGraphSolve(callsites,newEdges);
+    onTheFlyChangedCallGraphSolve(callsites,newEdges);
     NodePairSet cpySrcNodes;	/// nodes as a src of a generated new copy edge
     for(CallEdgeMap::iterator it = newEdges.begin(), eit = newEdges.end(); it!=eit; ++it )
     {
@@ -350,6 +466,75 @@ bool FlowSensitiveSCD::updateCallGraph(const PointerAnalysis::CallSiteToFunPtrMa
 
 
 
+/*!
+ * Compact the IDs of the versioned nodes of fsconsCG between two solving rounds.
+ * Nodes merged away by SCC detection leave holes in the ID range, which makes
+ * every NodeID-indexed structure sparse.
+ */
+void FlowSensitiveSCD::compactNodeIDs()
+{
+    double compactStart = stat->getClk();
+
+    /// Worklist entries and candidates may be merged-away nodes, use their reps.
+    NodeSet pending;
+    while (!isWorklistEmpty())
+        pending.insert(popFromWorklist());
+    NodeSet candidates;
+    for (NodeID id : sccCandidates)
+        candidates.insert(sccRepNode(id));
+
+    FSConsG::NodeToNodeMap movedIDs;
+    NodeBS removedIDs;
+    bool compacted = fsconsCG->compactNodeIDs(movedIDs, removedIDs);
+
+    auto mapID = [&movedIDs](NodeID id)
+    {
+        FSConsG::NodeToNodeMap::const_iterator it = movedIDs.find(id);
+        return it == movedIDs.end() ? id : it->second;
+    };
+
+    if (compacted)
+    {
+        numOfCompaction++;
+        numOfCompactedIDs += removedIDs.count();
+
+        /// Points-to sets of merged-away nodes have already been unioned into their reps.
+        for (NodeID id : removedIDs)
+        {
+            getPTDataTy()->clearFullPts(id);
+            if (Options::DiffPts())
+                getDiffPTDataTy()->clearPropaPts(id);
+        }
+
+        /// New IDs are never greater than old ones, so moving in increasing order of
+        /// old IDs never overwrites a set which has not been moved yet.
+        OrderedMap<NodeID, NodeID> orderedMoves(movedIDs.begin(), movedIDs.end());
+        for (const auto& move : orderedMoves)
+        {
+            NodeID oldId = move.first;
+            NodeID newId = move.second;
+            PointsTo pts = getPTDataTy()->getPts(oldId);
+            getPTDataTy()->clearFullPts(oldId);
+            getPTDataTy()->unionPts(newId, pts);
+            /// Forget what has been propagated so the moved node propagates its full set.
+            if (Options::DiffPts())
+            {
+                getDiffPTDataTy()->clearPropaPts(oldId);
+                getDiffPTDataTy()->clearPropaPts(newId);
+            }
+        }
+    }
+
+    for (NodeID id : pending)
+        pushIntoWorklist(mapID(id));
+    sccCandidates.clear();
+    for (NodeID id : candidates)
+        sccCandidates.insert(mapID(id));
+
+    double compactEnd = stat->getClk();
+    timeOfCompaction += (compactEnd - compactStart) / TIMEINTERVAL;
+}
+
 /*
  * Merge constraint graph nodes based on SCC cycle detected.
  */
@@ -1,5 +1,6 @@
 
 
+#include "Util/Options.h"
 #include "WPA/Andersen.h"
 #include "WPA/WPAStat.h"
 #include "WPA/FlowSensitive.h"
@@ -126,6 +127,7 @@ void FlowSensitiveStat::performStat()
     timeStatMap["StoreTime"] = fspta->storeTime;
     timeStatMap["UpdateCGTime"] = fspta->updateCallGraphTime;
     timeStatMap["PhiTime"] = fspta->phiTime;
+    timeStatMap["ParallelPropaTime"] = fspta->parallelPropaTime;
 
     PTNumStatMap["TotalPointers"] = pag->getValueNodeNum();
     PTNumStatMap["TotalObjects"] = pag->getObjectNodeNum();
@@ -141,6 +143,7 @@ void FlowSensitiveStat::performStat()
     PTNumStatMap["SolveIterations"] = fspta->numOfIteration;
 
     PTNumStatMap["IndEdgeSolved"] = fspta->getNumOfResolvedIndCallEdge();
+    PTNumStatMap["IndCallSitesResolved"] = fspta->getNumOfReResolvedCallSites();
 
     PTNumStatMap["NullPointer"] = _NumOfNullPtr;
     PTNumStatMap["PointsToConstPtr"] = _NumOfConstantPtr;
@@ -231,6 +234,10 @@ void FlowSensitiveStat::performStat()
     PTNumStatMap["ProcessedFRet"] = fspta->numOfProcessedFormalRet;
     PTNumStatMap["ProcessedMSSANode"] = fspta->numOfProcessedMSSANode;
 
+    PTNumStatMap["FsThreads"] = Options::FsThreads();
+    PTNumStatMap["FsParallelRounds"] = fspta->numOfParallelRounds;
+    PTNumStatMap["FsSteals"] = fspta->numOfParallelSteals;
+
     PTNumStatMap["NumOfNodesInSCC"] = fspta->numOfNodesInSCC;
     PTNumStatMap["MaxSCCSize"] = fspta->maxSCCSize;
     PTNumStatMap["NumOfSCC"] = fspta->numOfSCC;
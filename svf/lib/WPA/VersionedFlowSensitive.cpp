@@ -4,10 +4,8 @@
 #include "WPA/VersionedFlowSensitive.h"
 #include "Util/Options.h"
 #include "MemoryModel/PointsTo.h"
+#include "Util/WorkStealing.h"
 #include <iostream>
-#include <queue>
-#include <thread>
-#include <mutex>
 
 using namespace SVF;
 
@@ -25,6 +23,8 @@ VersionedFlowSensitive::VersionedFlowSensitive(SVFIR *_pag, PTATY type)
 {
     numPrelabeledNodes = numPrelabelVersions = 0;
     prelabelingTime = meldLabelingTime = versionPropTime = 0.0;
+    numMeldSteals = maxMeldObjsPerThread = minMeldObjsPerThread = numVersionLockStripes = 0;
+    numVersionPropRounds = 0;
     // We'll grab vPtD in initialize.
 
     for (SVFIR::const_iterator it = pag->begin(); it != pag->end(); ++it)
@@ -150,267 +150,255 @@ void VersionedFlowSensitive::meldLabel(void)
         if (delta(n) || deltaSource(n) || isStore(n) || isLoad(n)) nodesWhichNeedVersions.push_back(n);
     }
 
-    std::mutex *versionMutexes = new std::mutex[nodesWhichNeedVersions.size()];
+    // Versions of a node are updated under a lock shared with other nodes
+    // rather than one mutex per node.
+    const unsigned numThreads = Options::VersioningThreads();
+    LockStripes versionLocks(numThreads == 1 ? 1 : 64 * numThreads, nodesWhichNeedVersions.size());
 
     // Map of footprints to the canonical object "owning" the footprint.
     Map<std::vector<const IndirectSVFGEdge *>, NodeID> footprintOwner;
 
-    std::queue<NodeID> objectQueue;
+    WorkStealingPool<NodeID> objectPool(numThreads);
     for (const NodeID o : prelabeledObjects)
     {
         // "Touch" maps with o so we don't need to lock on them.
         versionReliance[o];
         stmtReliance[o];
-        objectQueue.push(o);
+        objectPool.push(o);
     }
 
-    std::mutex objectQueueMutex;
     std::mutex footprintOwnerMutex;
 
-    auto meldVersionWorker = [this, &footprintOwner, &objectQueue,
-                                    &objectQueueMutex, &footprintOwnerMutex, &versionMutexes,
+    auto meldVersionWorker = [this, &footprintOwner, &footprintOwnerMutex, &versionLocks,
                                     &prelabeledNodes, &isPrelabeled, &nodesWhichNeedVersions]
-         (const unsigned thread)
+         (const NodeID o, const unsigned thread)
     {
-        while (true)
+        // 1. Compute the SCCs for the nodes on the graph overlay of o.
+        // For starting nodes, we only need those which did prelabeling for o specifically.
+        // TODO: maybe we should move this to prelabel with a map (o -> starting nodes).
+        std::vector<const SVFGNode *> osStartingNodes;
+        for (std::pair<const SVFGNode *, const PointsTo *> snPts : prelabeledNodes)
         {
-            NodeID o;
+            const SVFGNode *sn = snPts.first;
+            const PointsTo *pts = snPts.second;
+            if (pts != nullptr)
             {
-                std::lock_guard<std::mutex> guard(objectQueueMutex);
-                // No more objects? Done.
-                if (objectQueue.empty()) return;
-                o = objectQueue.front();
-                objectQueue.pop();
+                if (pts->test(o)) osStartingNodes.push_back(sn);
             }
-
-            // 1. Compute the SCCs for the nodes on the graph overlay of o.
-            // For starting nodes, we only need those which did prelabeling for o specifically.
-            // TODO: maybe we should move this to prelabel with a map (o -> starting nodes).
-            std::vector<const SVFGNode *> osStartingNodes;
-            for (std::pair<const SVFGNode *, const PointsTo *> snPts : prelabeledNodes)
+            else if (const MRSVFGNode *mr = SVFUtil::dyn_cast<MRSVFGNode>(sn))
             {
-                const SVFGNode *sn = snPts.first;
-                const PointsTo *pts = snPts.second;
-                if (pts != nullptr)
-                {
-                    if (pts->test(o)) osStartingNodes.push_back(sn);
-                }
-                else if (const MRSVFGNode *mr = SVFUtil::dyn_cast<MRSVFGNode>(sn))
-                {
-                    if (mr->getPointsTo().test(o)) osStartingNodes.push_back(sn);
-                }
-                else
-                {
-                    assert(false && "VFS::meldLabel: unexpected prelabeled node!");
-                }
+                if (mr->getPointsTo().test(o)) osStartingNodes.push_back(sn);
+            }
+            else
+            {
+                assert(false && "VFS::meldLabel: unexpected prelabeled node!");
             }
+        }
 
-            std::vector<int> partOf;
-            std::vector<const IndirectSVFGEdge *> footprint;
-            unsigned numSCCs = SCC::detectSCCs(this, this->svfg, o, osStartingNodes, partOf, footprint);
+        std::vector<int> partOf;
+        std::vector<const IndirectSVFGEdge *> footprint;
+        unsigned numSCCs = SCC::detectSCCs(this, this->svfg, o, osStartingNodes, partOf, footprint);
 
-            // 2. Skip any further processing of a footprint we have seen before.
+        // 2. Skip any further processing of a footprint we have seen before.
+        {
+            std::lock_guard<std::mutex> guard(footprintOwnerMutex);
+            const Map<std::vector<const IndirectSVFGEdge *>, NodeID>::const_iterator canonOwner
+                = footprintOwner.find(footprint);
+            if (canonOwner == footprintOwner.end())
             {
-                std::lock_guard<std::mutex> guard(footprintOwnerMutex);
-                const Map<std::vector<const IndirectSVFGEdge *>, NodeID>::const_iterator canonOwner
-                    = footprintOwner.find(footprint);
-                if (canonOwner == footprintOwner.end())
-                {
-                    this->equivalentObject[o] = o;
-                    footprintOwner[footprint] = o;
-                }
-                else
-                {
-                    this->equivalentObject[o] = canonOwner->second;
-                    // Same version and stmt reliance as the canonical. During solving we cannot just reuse
-                    // the canonical object's reliance because it may change due to on-the-fly call graph
-                    // construction. Something like copy-on-write could be good... probably negligible.
-                    this->versionReliance.at(o) = this->versionReliance.at(canonOwner->second);
-                    this->stmtReliance.at(o) = this->stmtReliance.at(canonOwner->second);
-                    continue;
-                }
+                this->equivalentObject[o] = o;
+                footprintOwner[footprint] = o;
             }
-
-            // 3. a. Initialise the MeldVersion of prelabeled nodes (SCCs).
-            //    b. Initialise a todo list of all the nodes we need to version,
-            //       sorted according to topological order.
-            // We will use a map of sccs to meld versions for what is consumed.
-            std::vector<MeldVersion> sccToMeldVersion(numSCCs);
-            // At stores, what is consumed is different to what is yielded, so we
-            // maintain that separately.
-            Map<NodeID, MeldVersion> storesYieldedMeldVersion;
-            // SVFG nodes of interest -- those part of an SCC from the starting nodes.
-            std::vector<NodeID> todoList;
-            unsigned bit = 0;
-            // To calculate reachable nodes, we can see what nodes n exist where
-            // partOf[n] != -1. Since the SVFG can be large this can be expensive.
-            // Instead, we can gather this from the edges in the footprint and
-            // the starting nodes (incase such nodes have no edges).
-            // TODO: should be able to do this better: too many redundant inserts.
-            Set<NodeID> reachableNodes;
-            for (const SVFGNode *sn : osStartingNodes) reachableNodes.insert(sn->getId());
-            for (const SVFGEdge *se : footprint)
+            else
             {
-                reachableNodes.insert(se->getSrcNode()->getId());
-                reachableNodes.insert(se->getDstNode()->getId());
+                this->equivalentObject[o] = canonOwner->second;
+                // Same version and stmt reliance as the canonical. During solving we cannot just reuse
+                // the canonical object's reliance because it may change due to on-the-fly call graph
+                // construction. Something like copy-on-write could be good... probably negligible.
+                this->versionReliance.at(o) = this->versionReliance.at(canonOwner->second);
+                this->stmtReliance.at(o) = this->stmtReliance.at(canonOwner->second);
+                return;
             }
+        }
 
-            for (const NodeID n : reachableNodes)
-            {
-                if (isPrelabeled[n])
-                {
-                    if (this->isStore(n)) storesYieldedMeldVersion[n].set(bit);
-                    else sccToMeldVersion[partOf[n]].set(bit);
-                    ++bit;
-                }
+        // 3. a. Initialise the MeldVersion of prelabeled nodes (SCCs).
+        //    b. Initialise a todo list of all the nodes we need to version,
+        //       sorted according to topological order.
+        // We will use a map of sccs to meld versions for what is consumed.
+        std::vector<MeldVersion> sccToMeldVersion(numSCCs);
+        // At stores, what is consumed is different to what is yielded, so we
+        // maintain that separately.
+        Map<NodeID, MeldVersion> storesYieldedMeldVersion;
+        // SVFG nodes of interest -- those part of an SCC from the starting nodes.
+        std::vector<NodeID> todoList;
+        unsigned bit = 0;
+        // To calculate reachable nodes, we can see what nodes n exist where
+        // partOf[n] != -1. Since the SVFG can be large this can be expensive.
+        // Instead, we can gather this from the edges in the footprint and
+        // the starting nodes (incase such nodes have no edges).
+        // TODO: should be able to do this better: too many redundant inserts.
+        Set<NodeID> reachableNodes;
+        for (const SVFGNode *sn : osStartingNodes) reachableNodes.insert(sn->getId());
+        for (const SVFGEdge *se : footprint)
+        {
+            reachableNodes.insert(se->getSrcNode()->getId());
+            reachableNodes.insert(se->getDstNode()->getId());
+        }
 
-                todoList.push_back(n);
+        for (const NodeID n : reachableNodes)
+        {
+            if (isPrelabeled[n])
+            {
+                if (this->isStore(n)) storesYieldedMeldVersion[n].set(bit);
+                else sccToMeldVersion[partOf[n]].set(bit);
+                ++bit;
             }
 
-            // Sort topologically so each nodes is only visited once.
-            auto cmp = [&partOf](const NodeID a, const NodeID b)
-            {
-                return partOf[a] > partOf[b];
-            };
-            std::sort(todoList.begin(), todoList.end(), cmp);
-
-            // 4. a. Do meld versioning.
-            //    b. Determine SCC reliances.
-            //    c. Build a footprint for o (all edges which it is found on).
-            //    d. Determine which SCCs belong to stores.
-
-            // sccReliance[x] = { y_1, y_2, ... } if there exists an edge from a node
-            // in SCC x to SCC y_i.
-            std::vector<Set<int>> sccReliance(numSCCs);
-            // Maps SCC to the store it corresponds to or -1 if it doesn't. TODO: unsigned vs signed -- nasty.
-            std::vector<int> storeSCC(numSCCs, -1);
-            for (size_t i = 0; i < todoList.size(); ++i)
+            todoList.push_back(n);
+        }
+
+        // Sort topologically so each nodes is only visited once.
+        auto cmp = [&partOf](const NodeID a, const NodeID b)
+        {
+            return partOf[a] > partOf[b];
+        };
+        std::sort(todoList.begin(), todoList.end(), cmp);
+
+        // 4. a. Do meld versioning.
+        //    b. Determine SCC reliances.
+        //    c. Build a footprint for o (all edges which it is found on).
+        //    d. Determine which SCCs belong to stores.
+
+        // sccReliance[x] = { y_1, y_2, ... } if there exists an edge from a node
+        // in SCC x to SCC y_i.
+        std::vector<Set<int>> sccReliance(numSCCs);
+        // Maps SCC to the store it corresponds to or -1 if it doesn't. TODO: unsigned vs signed -- nasty.
+        std::vector<int> storeSCC(numSCCs, -1);
+        for (size_t i = 0; i < todoList.size(); ++i)
+        {
+            const NodeID n = todoList[i];
+            const SVFGNode *sn = this->svfg->getSVFGNode(n);
+            const bool nIsStore = this->isStore(n);
+
+            int nSCC = partOf[n];
+            if (nIsStore) storeSCC[nSCC] = n;
+
+            // Given n -> m, the yielded version of n will be melded into m.
+            // For stores, that is in storesYieldedMeldVersion, otherwise, consume == yield and
+            // we can just use sccToMeldVersion.
+            const MeldVersion &nMV = nIsStore ? storesYieldedMeldVersion[n] : sccToMeldVersion[nSCC];
+            for (const SVFGEdge *e : sn->getOutEdges())
             {
-                const NodeID n = todoList[i];
-                const SVFGNode *sn = this->svfg->getSVFGNode(n);
-                const bool nIsStore = this->isStore(n);
-
-                int nSCC = partOf[n];
-                if (nIsStore) storeSCC[nSCC] = n;
-
-                // Given n -> m, the yielded version of n will be melded into m.
-                // For stores, that is in storesYieldedMeldVersion, otherwise, consume == yield and
-                // we can just use sccToMeldVersion.
-                const MeldVersion &nMV = nIsStore ? storesYieldedMeldVersion[n] : sccToMeldVersion[nSCC];
-                for (const SVFGEdge *e : sn->getOutEdges())
-                {
-                    const IndirectSVFGEdge *ie = SVFUtil::dyn_cast<IndirectSVFGEdge>(e);
-                    if (!ie) continue;
+                const IndirectSVFGEdge *ie = SVFUtil::dyn_cast<IndirectSVFGEdge>(e);
+                if (!ie) continue;
 
-                    const NodeID m = ie->getDstNode()->getId();
-                    // Ignoreedges which don't involve o.
-                    if (!ie->getPointsTo().test(o)) continue;
+                const NodeID m = ie->getDstNode()->getId();
+                // Ignoreedges which don't involve o.
+                if (!ie->getPointsTo().test(o)) continue;
 
-                    int mSCC = partOf[m];
+                int mSCC = partOf[m];
 
-                    // There is an edge from the SCC n belongs to that m belongs to.
-                    sccReliance[nSCC].insert(mSCC);
+                // There is an edge from the SCC n belongs to that m belongs to.
+                sccReliance[nSCC].insert(mSCC);
 
-                    // Ignore edges to delta nodes (prelabeled consume).
-                    // No point propagating when n's SCC == m's SCC (same meld version there)
-                    // except when it is a store, because we are actually propagating n's yielded
-                    // into m's consumed. Store nodes are in their own SCCs, so it is a self
-                    // loop on a store node.
-                    if (!this->delta(m) && (nSCC != mSCC || nIsStore))
-                    {
-                        sccToMeldVersion[mSCC] |= nMV;
-                    }
+                // Ignore edges to delta nodes (prelabeled consume).
+                // No point propagating when n's SCC == m's SCC (same meld version there)
+                // except when it is a store, because we are actually propagating n's yielded
+                // into m's consumed. Store nodes are in their own SCCs, so it is a self
+                // loop on a store node.
+                if (!this->delta(m) && (nSCC != mSCC || nIsStore))
+                {
+                    sccToMeldVersion[mSCC] |= nMV;
                 }
             }
+        }
 
-            // 5. Transform meld versions belonging to SCCs into versions.
-            Map<MeldVersion, Version> mvv;
-            std::vector<Version> sccToVersion(numSCCs, invalidVersion);
-            Version curVersion = 0;
-            for (u32_t scc = 0; scc < sccToMeldVersion.size(); ++scc)
-            {
-                const MeldVersion &mv = sccToMeldVersion[scc];
-                Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
-                Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
-                sccToVersion[scc] = v;
-            }
+        // 5. Transform meld versions belonging to SCCs into versions.
+        Map<MeldVersion, Version> mvv;
+        std::vector<Version> sccToVersion(numSCCs, invalidVersion);
+        Version curVersion = 0;
+        for (u32_t scc = 0; scc < sccToMeldVersion.size(); ++scc)
+        {
+            const MeldVersion &mv = sccToMeldVersion[scc];
+            Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
+            Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
+            sccToVersion[scc] = v;
+        }
 
-            sccToMeldVersion.clear();
+        sccToMeldVersion.clear();
 
-            // Same for storesYieldedMeldVersion.
-            Map<NodeID, Version> storesYieldedVersion;
-            for (auto const& nmv : storesYieldedMeldVersion)
-            {
-                const NodeID n = nmv.first;
-                const MeldVersion &mv = nmv.second;
+        // Same for storesYieldedMeldVersion.
+        Map<NodeID, Version> storesYieldedVersion;
+        for (auto const& nmv : storesYieldedMeldVersion)
+        {
+            const NodeID n = nmv.first;
+            const MeldVersion &mv = nmv.second;
 
-                Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
-                Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
-                storesYieldedVersion[n] = v;
-            }
+            Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
+            Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
+            storesYieldedVersion[n] = v;
+        }
 
-            storesYieldedMeldVersion.clear();
+        storesYieldedMeldVersion.clear();
 
-            mvv.clear();
+        mvv.clear();
 
-            // 6. From SCC reliance, determine version reliances.
-            Map<Version, std::vector<Version>> &osVersionReliance = this->versionReliance.at(o);
-            for (u32_t scc = 0; scc < numSCCs; ++scc)
-            {
-                if (sccReliance[scc].empty()) continue;
+        // 6. From SCC reliance, determine version reliances.
+        Map<Version, std::vector<Version>> &osVersionReliance = this->versionReliance.at(o);
+        for (u32_t scc = 0; scc < numSCCs; ++scc)
+        {
+            if (sccReliance[scc].empty()) continue;
 
-                // Some consume relies on a yield. When it's a store, we need to pick whether to
-                // use the consume or yield unlike when it is not because they are the same.
-                const Version version
-                    = storeSCC[scc] != -1 ? storesYieldedVersion[storeSCC[scc]] : sccToVersion[scc];
+            // Some consume relies on a yield. When it's a store, we need to pick whether to
+            // use the consume or yield unlike when it is not because they are the same.
+            const Version version
+                = storeSCC[scc] != -1 ? storesYieldedVersion[storeSCC[scc]] : sccToVersion[scc];
 
-                std::vector<Version> &reliantVersions = osVersionReliance[version];
-                for (const int reliantSCC : sccReliance[scc])
+            std::vector<Version> &reliantVersions = osVersionReliance[version];
+            for (const int reliantSCC : sccReliance[scc])
+            {
+                const Version reliantVersion = sccToVersion[reliantSCC];
+                if (version != reliantVersion)
                 {
-                    const Version reliantVersion = sccToVersion[reliantSCC];
-                    if (version != reliantVersion)
-                    {
-                        // sccReliance is a set, no need to worry about duplicates.
-                        reliantVersions.push_back(reliantVersion);
-                    }
+                    // sccReliance is a set, no need to worry about duplicates.
+                    reliantVersions.push_back(reliantVersion);
                 }
             }
+        }
 
-            // 7. a. Save versions for nodes which need them.
-            //    b. Fill in stmtReliance.
-            // TODO: maybe randomize iteration order for less contention? Needs profiling.
-            Map<Version, NodeBS> &osStmtReliance = this->stmtReliance.at(o);
-            for (size_t i = 0; i < nodesWhichNeedVersions.size(); ++i)
-            {
-                const NodeID n = nodesWhichNeedVersions[i];
-                std::mutex &mutex = versionMutexes[i];
-
-                const int scc = partOf[n];
-                if (scc == -1) continue;
+        // 7. a. Save versions for nodes which need them.
+        //    b. Fill in stmtReliance.
+        // TODO: maybe randomize iteration order for less contention? Needs profiling.
+        Map<Version, NodeBS> &osStmtReliance = this->stmtReliance.at(o);
+        for (size_t i = 0; i < nodesWhichNeedVersions.size(); ++i)
+        {
+            const NodeID n = nodesWhichNeedVersions[i];
+            const int scc = partOf[n];
+            if (scc == -1) continue;
 
-                std::lock_guard<std::mutex> guard(mutex);
+            std::lock_guard<std::mutex> guard(versionLocks.get(i));
 
-                const Version c = sccToVersion[scc];
-                if (c != invalidVersion)
-                {
-                    this->setConsume(n, o, c);
-                    if (this->isStore(n) || this->isLoad(n)) osStmtReliance[c].set(n);
-                }
+            const Version c = sccToVersion[scc];
+            if (c != invalidVersion)
+            {
+                this->setConsume(n, o, c);
+                if (this->isStore(n) || this->isLoad(n)) osStmtReliance[c].set(n);
+            }
 
-                if (this->isStore(n))
-                {
-                    const Map<NodeID, Version>::const_iterator yIt = storesYieldedVersion.find(n);
-                    if (yIt != storesYieldedVersion.end()) this->setYield(n, o, yIt->second);
-                }
+            if (this->isStore(n))
+            {
+                const Map<NodeID, Version>::const_iterator yIt = storesYieldedVersion.find(n);
+                if (yIt != storesYieldedVersion.end()) this->setYield(n, o, yIt->second);
             }
         }
     };
 
-    std::vector<std::thread> workers;
-    for (unsigned i = 0; i < Options::VersioningThreads(); ++i) workers.push_back(std::thread(meldVersionWorker, i));
-    for (std::thread &worker : workers) worker.join();
+    objectPool.run(meldVersionWorker);
 
-    delete[] versionMutexes;
+    numMeldSteals = objectPool.getNumSteals();
+    maxMeldObjsPerThread = objectPool.getMaxProcessed();
+    minMeldObjsPerThread = objectPool.getMinProcessed();
+    numVersionLockStripes = versionLocks.getNumStripes();
 
     double end = stat->getClk(true);
     meldLabelingTime = (end - start) / TIMEINTERVAL;
@@ -538,6 +526,12 @@ void VersionedFlowSensitive::removeAllIndirectSVFGEdges(void)
 
 void VersionedFlowSensitive::propagateVersion(NodeID o, Version v)
 {
+    if (Options::VersionPropThreads() > 1)
+    {
+        pendingVersions[o].insert(v);
+        return;
+    }
+
     double start = stat->getClk();
 
     const std::vector<Version> &reliantVersions = getReliantVersions(o, v);
@@ -580,6 +574,103 @@ void VersionedFlowSensitive::propagateVersion(const NodeID o, const Version v, c
     if (time) versionPropTime += (end - start) / TIMEINTERVAL;
 }
 
+bool VersionedFlowSensitive::propagatePendingVersions(void)
+{
+    if (pendingVersions.empty()) return false;
+
+    double start = stat->getClk();
+
+    // Versions of one object only rely on versions of the same object, so each
+    // object can be propagated to a fixed point independently of the others.
+    struct ObjectProp
+    {
+        NodeID o;
+        const Map<Version, std::vector<Version>> *reliance;
+        std::vector<Version> pending;
+        std::vector<Version> changed;
+    };
+
+    // Everything the workers touch is looked up beforehand so that no thread
+    // inserts into the maps shared between objects.
+    std::vector<ObjectProp> props;
+    props.reserve(pendingVersions.size());
+    for (const Map<NodeID, Set<Version>>::value_type &ovs : pendingVersions)
+    {
+        const NodeID o = ovs.first;
+        ObjectProp prop;
+        prop.o = o;
+        prop.reliance = &versionReliance[o];
+        prop.pending.assign(ovs.second.begin(), ovs.second.end());
+        for (const Map<Version, std::vector<Version>>::value_type &vr : *prop.reliance)
+        {
+            vPtD->getPts(atKey(o, vr.first));
+            for (const Version r : vr.second) vPtD->getPts(atKey(o, r));
+        }
+
+        props.push_back(prop);
+    }
+
+    pendingVersions.clear();
+
+    WorkStealingPool<size_t> propPool(Options::VersionPropThreads());
+    for (size_t i = 0; i < props.size(); ++i) propPool.push(i);
+
+    auto propWorker = [this, &props](const size_t i, const unsigned)
+    {
+        ObjectProp &prop = props[i];
+        FIFOWorkList<Version> versions;
+        for (const Version v : prop.pending) versions.push(v);
+
+        while (!versions.empty())
+        {
+            const Version v = versions.pop();
+            const Map<Version, std::vector<Version>>::const_iterator vr = prop.reliance->find(v);
+            if (vr == prop.reliance->end()) continue;
+
+            for (const Version r : vr->second)
+            {
+                if (vPtD->unionPts(atKey(prop.o, r), atKey(prop.o, v)))
+                {
+                    prop.changed.push_back(r);
+                    versions.push(r);
+                }
+            }
+        }
+    };
+
+    // Objects share the points-to cache (when persistent).
+    getPtCache().setConcurrent(true);
+    propPool.run(propWorker);
+    getPtCache().setConcurrent(false);
+
+    // Notify statements which rely on a changed version.
+    for (const ObjectProp &prop : props)
+    {
+        for (const Version r : prop.changed)
+        {
+            for (NodeID s : getStmtReliance(prop.o, r)) pushIntoWorklist(s);
+        }
+    }
+
+    ++numVersionPropRounds;
+
+    double end = stat->getClk();
+    versionPropTime += (end - start) / TIMEINTERVAL;
+
+    return !isWorklistEmpty();
+}
+
+void VersionedFlowSensitive::solveWorklist()
+{
+    // With multiple propagation threads, changed versions are collected while
+    // the worklist drains and propagated all at once before draining it again.
+    do
+    {
+        FlowSensitive::solveWorklist();
+    }
+    while (propagatePendingVersions());
+}
+
 void VersionedFlowSensitive::processNode(NodeID n)
 {
     SVFGNode* sn = svfg->getSVFGNode(n);
@@ -957,7 +1048,11 @@ void VersionedFlowSensitive::readPtsFromFile(const std::string& filename)
     /// Initialization for the Solver
     initialize();
     /// Load the pts from file
-    if(!filename.empty())
+    if (!filename.empty() && isBinaryPtsFile(filename))
+    {
+        readBinaryFromFile(filename);
+    }
+    else if(!filename.empty())
     {
         SVFUtil::outs() << "Loading versioned pointer analysis results from '" << filename << "'...";
 
@@ -1006,6 +1101,12 @@ void VersionedFlowSensitive::solveAndwritePtsToFile(const std::string& filename)
 
 void VersionedFlowSensitive::writeVersionedAnalysisResultToFile(const std::string& filename)
 {
+    if (!Options::WriteAnderText())
+    {
+        writeBinaryVersionedAnalysisResultToFile(filename);
+        return;
+    }
+
     SVFUtil::outs() << "Storing Versioned Analysis Result to '" << filename << "'...";
     std::error_code err;
     std::fstream f(filename.c_str(), std::ios_base::app);
@@ -1056,6 +1157,72 @@ void VersionedFlowSensitive::writeVersionedAnalysisResultToFile(const std::strin
     }
 }
 
+void VersionedFlowSensitive::writeBinaryVersionedAnalysisResultToFile(const std::string& filename)
+{
+    SVFUtil::outs() << "Storing Versioned Analysis Result to '" << filename << "'...";
+
+    // Keys as two parallel arrays (objects, versions), then their points-to sets.
+    std::vector<NodeID> objs;
+    std::vector<Version> versions;
+    std::vector<const PointsTo *> keyPts;
+    for (const VersionedFlowSensitive::LocVersionMap *lvm :
+            {
+                &this->consume, &this->yield
+            })
+    {
+        for (const VersionedFlowSensitive::ObjToVersionMap &lov : *lvm)
+        {
+            for (const VersionedFlowSensitive::ObjToVersionMap::value_type &ov : lov)
+            {
+                const PointsTo &ovPts = vPtD->getPts(atKey(ov.first, ov.second));
+                if (ovPts.empty()) continue;
+                objs.push_back(ov.first);
+                versions.push_back(ov.second);
+                keyPts.push_back(&ovPts);
+            }
+        }
+    }
+
+    BinaryWriter payload, sections;
+    payload.write<u32_t>(objs.size());
+    payload.write<u32_t>(0);
+    payload.writeVector(objs);
+    payload.align();
+    payload.writeVector(versions);
+    payload.align();
+    writePtsTable(payload, keyPts);
+    addPtsFileSection(sections, VersionedPts, payload);
+
+    if (!writePtsFileSections(filename, sections, false))
+    {
+        SVFUtil::outs() << "  error opening file for writing!\n";
+        return;
+    }
+    SVFUtil::outs() << "\n";
+}
+
+bool VersionedFlowSensitive::readVersionedPtsSection(BinaryReader& section)
+{
+    u32_t numKeys = 0, reserved = 0;
+    if (!section.read(numKeys) || !section.read(reserved)) return false;
+
+    const NodeID *objs = section.readArray<NodeID>(numKeys);
+    if (objs == nullptr || !section.align()) return false;
+    const Version *versions = section.readArray<Version>(numKeys);
+    if (versions == nullptr || !section.align()) return false;
+
+    std::vector<PointsTo> sets;
+    const u32_t *keyToSet = nullptr;
+    if (!readPtsTable(section, numKeys, sets, keyToSet)) return false;
+
+    for (u32_t i = 0; i < numKeys; ++i)
+    {
+        vPtD->unionPts(atKey(objs[i], versions[i]), sets[keyToSet[i]]);
+    }
+
+    return true;
+}
+
 void VersionedFlowSensitive::readVersionedAnalysisResultFromFile(std::ifstream& F)
 {
     std::string line;
@@ -2,6 +2,7 @@
 
 #include "Util/SVFUtil.h"
 #include "WPA/WPAStat.h"
+#include "Util/Options.h"
 #include "WPA/VersionedFlowSensitive.h"
 #include "MemoryModel/PointsTo.h"
 
@@ -128,6 +129,15 @@ void VersionedFlowSensitiveStat::performStat()
     PTNumStatMap["ProcessedGep"]      = vfspta->numOfProcessedGep;
     PTNumStatMap["ProcessedLoad"]     = vfspta->numOfProcessedLoad;
     PTNumStatMap["ProcessedStore"]    = vfspta->numOfProcessedStore;
+
+    // Load balance of meld labeling, to compare meldLabelingTime across -versioning-threads.
+    PTNumStatMap["VersioningThreads"]    = Options::VersioningThreads();
+    PTNumStatMap["MeldSteals"]           = vfspta->numMeldSteals;
+    PTNumStatMap["MaxMeldObjsPerThread"] = vfspta->maxMeldObjsPerThread;
+    PTNumStatMap["MinMeldObjsPerThread"] = vfspta->minMeldObjsPerThread;
+    PTNumStatMap["VersionLockStripes"]   = vfspta->numVersionLockStripes;
+    PTNumStatMap["VersionPropThreads"]   = Options::VersionPropThreads();
+    PTNumStatMap["VersionPropRounds"]    = vfspta->numVersionPropRounds;
     PTNumStatMap["ProcessedPhi"]      = vfspta->numOfProcessedPhi;
     PTNumStatMap["ProcessedAParam"]   = vfspta->numOfProcessedActualParam;
     PTNumStatMap["ProcessedFRet"]     = vfspta->numOfProcessedFormalRet;